@@ -11,6 +11,7 @@
 #define sFLASH_CMD_RDSR           0x05  /*!< Read Status Register instruction  */
 #define sFLASH_CMD_RDID           0x9F  /*!< Read identification */
 #define sFLASH_CMD_SE             0xD8  /*!< Sector Erase instruction */
+#define sFLASH_CMD_SSE            0x20  /*!< 4KB Sub Sector Erase instruction (W25Q) */
 #define sFLASH_CMD_CE             0xC7  /*!< Bulk Erase instruction */ /*chip erase*/
 
 #define sFLASH_WIP_FLAG           0x01  /*!< Write In Progress (WIP) flag */
@@ -92,6 +93,46 @@ void sFLASH_EraseSector(uint32_t SectorAddr)
 
 }
 
+/**
+  * @brief  Erases the 4KB sub sector holding SubSectorAddr.
+  * @param  SubSectorAddr: address of the sub sector to erase.
+  * @retval None
+  */
+void sFLASH_EraseSubSector(uint32_t SubSectorAddr)
+{
+
+#if defined ( FREE_RTOS )
+  if (SPI_mutex_lock() == FALSE)
+  {
+    return;
+  }
+#endif   
+
+  /*!< Send write enable instruction */
+  sFLASH_WriteEnable();
+
+  /*!< Select the FLASH: Chip Select low */
+  sFLASH_CS_LOW();
+  /*!< Send Sub Sector Erase instruction */
+  sFLASH_SendByte(sFLASH_CMD_SSE);
+  /*!< Send SubSectorAddr high nibble address byte */
+  sFLASH_SendByte((SubSectorAddr & 0xFF0000) >> 16);
+  /*!< Send SubSectorAddr medium nibble address byte */
+  sFLASH_SendByte((SubSectorAddr & 0xFF00) >> 8);
+  /*!< Send SubSectorAddr low nibble address byte */
+  sFLASH_SendByte(SubSectorAddr & 0xFF);
+  /*!< Deselect the FLASH: Chip Select high */
+  sFLASH_CS_HIGH();
+
+  /*!< Wait the end of Flash writing */
+  sFLASH_WaitForWriteEnd();
+
+#if defined  ( FREE_RTOS )  
+  SPI_mutex_unlock();
+#endif 
+
+}
+
 /**
   * @brief  Erases the entire FLASH.
   * @param  None
@@ -465,19 +506,13 @@ uint16_t sFLASH_SendHalfWord(uint16_t HalfWord)
 
 /**
   * @brief  Enables the write access to the FLASH.
+  * @note   The caller holds the SPI mutex, which is not recursive.
   * @param  None
   * @retval None
   */
 void sFLASH_WriteEnable(void)
 {
-#if defined ( FREE_RTOS )	
   /*!< Select the FLASH: Chip Select low */
-  if (SPI_mutex_lock() == FALSE)
-  {
-    return ;
-  }
-#endif 
-
   sFLASH_CS_LOW();
 
   /*!< Send "Write Enable" instruction */
@@ -485,17 +520,12 @@ void sFLASH_WriteEnable(void)
 
   /*!< Deselect the FLASH: Chip Select high */
   sFLASH_CS_HIGH();
-
-#if defined ( FREE_RTOS )
-  SPI_mutex_unlock();
-#endif 
-
-
 }
 
 /**
   * @brief  Polls the status of the Write In Progress (WIP) flag in the FLASH's
   *         status register and loop until write opertaion has completed.
+  * @note   The caller holds the SPI mutex, which is not recursive.
   * @param  None
   * @retval None
   */
@@ -503,14 +533,6 @@ void sFLASH_WaitForWriteEnd(void)
 {
   uint8_t flashstatus = 0;
 
-#if defined ( FREE_RTOS )
-
-  if (SPI_mutex_lock() == FALSE)
-  {
-    return ;
-  }
-#endif   
-
   /*!< Select the FLASH: Chip Select low */
   sFLASH_CS_LOW();
 
@@ -529,11 +551,6 @@ void sFLASH_WaitForWriteEnd(void)
 
   /*!< Deselect the FLASH: Chip Select high */
   sFLASH_CS_HIGH();
-
-#if defined ( FREE_RTOS )
-  SPI_mutex_unlock();
-#endif 
-
 }
 
 #endif /*EXT_FLASH*/
@@ -5,8 +5,12 @@
 #include "device_config.h"
 
 #if ( configSPI_FLASH == 1 )
+#define sFLASH_SUBSECTOR_SIZE 0x1000
+
 void sFLASH_EraseSector(uint32_t SectorAddr);
 
+void sFLASH_EraseSubSector(uint32_t SubSectorAddr);
+
 void sFLASH_EraseChip(void);
 
 void sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWrite);
@@ -27,6 +27,11 @@
 //#define MCU_IMAGE_START  (uint32_t)0 /* give a 4 sector size*/
 #define MCU_IMAGE_END    (uint32_t)0x400000 /*include dummy*/
 
+#if ( configMT8507_SECTOR_UPDATE == 1 )
+/*Flash_Buffer is programmed one sub sector at a time*/
+#define MT8507_FLASH_SECTOR_SIZE sFLASH_SUBSECTOR_SIZE
+#endif
+
 //______________________________________________________________________________
 uint8_t RxBuffer[RX_BUFFER_MAX] = {0};
 __IO uint16_t RxCounter = 0; 
@@ -73,14 +78,20 @@ extern void putch(char ch);
 
 //______________________________________________________________________________
 static void MT8507_ITF_SendDatas( uint8 *src, uint16 length );
+static bool MT8507_ITF_Pop2TranferData( void );
 static void MT8507_DSPCommand_Bypass_Process( void );
 static void MT8507_SPIFlash_Update_Process( void );
 static void MT8507_SPIFlash_Update_Process_test( void );
 static void MT8507_FactoryCommand_Bypass_Process( uint8 PacketLen );
 static void MT8507_SPIFlashUpdatingInitial( void );
 static void MT8507_FlashData_handle( void );
-static void MT8507_FlashData_Write( uint16_t NumByteToWrite );
 static void MT8507_FlashData_Read( uint16_t NumByteToWrite );
+#if ( configMT8507_SECTOR_UPDATE == 1 )
+static void MT8507_FlashData_Program( bool bFlushAll );
+static void MT8507_FlashData_WriteSector( uint16_t NumByteToWrite );
+#else
+static void MT8507_FlashData_Write( uint16_t NumByteToWrite );
+#endif
 static uint32 MT8507_GetDataNumberFromStack( uint16 Start, uint8 Length );
 static void MT8507_Initial_8507_stack_Rx( void );
 static void MT8507_Initial_8507_stack_Tx( void );
@@ -275,6 +286,28 @@ static void MT8507_SPIFlash_Update_Process( void )
 
             mMCUMode = SPI_Flash_Update_Process_Data_Copying;            
             MT8507_FlashData_handle();
+#if ( configMT8507_SECTOR_UPDATE == 1 )
+            MT8507_Initial_8507_stack_Rx();
+            MT8507_Initial_8507_EventPacket();
+
+            /* Ask for the next packet before programming, the UART irq
+               receives it while the sectors are erased and written */
+            if ( bIsAllDataTransmitted == TRUE )
+            {
+                mMCUMode = SPI_Flash_Update_Process_System_Reboot;            
+                MT8507_SendReadyToReceiveData(0xFFFF);
+                MT8507_ITF_Pop2TranferData();
+                MT8507_FlashData_Program(TRUE);
+                SPI_MasterBoot_mode();
+            }
+            else
+            {
+                MT8507_SendReadyToReceiveData(CurrentDataNum+1);
+                MT8507_ITF_Pop2TranferData();
+                mMCUMode = SPI_Flash_Update_Process_Wait_for_Next_Data;
+                MT8507_FlashData_Program(FALSE);
+            }
+#else
 
             MT8507_Initial_8507_stack_Rx();
             MT8507_Initial_8507_EventPacket();
@@ -292,6 +325,7 @@ static void MT8507_SPIFlash_Update_Process( void )
                 MT8507_SendReadyToReceiveData(CurrentDataNum+1);
                 mMCUMode = SPI_Flash_Update_Process_Wait_for_Next_Data;
             }
+#endif
         }
             break;
 
@@ -388,6 +422,9 @@ static void MT8507_SPIFlashUpdatingInitial( void )
 
     FlashBuffer_Index = 0; 
     memset(Flash_Buffer, 0, FLASH_BUFFER_MAX);
+#if ( configMT8507_SECTOR_UPDATE == 1 )
+    bIsAllDataTransmitted = FALSE; /*an interrupted update may be started again*/
+#endif
 
     //Deinitial another UART
     //Uart1_Deinitialization();
@@ -399,6 +436,35 @@ static void MT8507_SPIFlashUpdatingInitial( void )
     mMCUMode = SPI_Flash_Update_Process_Wait_for_Next_Data;
 }
 
+#if ( configMT8507_SECTOR_UPDATE == 1 )
+static void MT8507_FlashData_handle( void )
+{
+    /* Less than a sector is pending here, MT8507_FlashData_Program writes
+       every full one, so a packet always fits */
+    memcpy(Flash_Buffer+FlashBuffer_Index, m_MT8507_stack.rxBuffer+MT8507_FLASH_DATA, CurrentDataSize);
+    FlashBuffer_Index += CurrentDataSize;
+}
+
+static void MT8507_FlashData_Program( bool bFlushAll )
+{
+    uint16 len;
+
+    while ( (FlashBuffer_Index >= MT8507_FLASH_SECTOR_SIZE) || (bFlushAll && (FlashBuffer_Index > 0)) )
+    {
+        len = (FlashBuffer_Index >= MT8507_FLASH_SECTOR_SIZE) ? MT8507_FLASH_SECTOR_SIZE : FlashBuffer_Index;
+
+        MT8507_FlashData_WriteSector(len);
+
+        FlashBuffer_Index -= len;
+        memmove(Flash_Buffer, Flash_Buffer+len, FlashBuffer_Index);
+    }
+
+    if ( bFlushAll )
+    {
+        bIsDataDeliving = FALSE;
+    }
+}
+#else
 static void MT8507_FlashData_handle( void )
 {
     bool DataLeft = FALSE;
@@ -514,6 +580,68 @@ static void MT8507_FlashData_Write( uint16_t NumByteToWrite )
     }
     TRACE_DEBUG((0, "Err %d MT8507_FlashData_Write  %d ",ui8_ret ,FlashDestination));    /*for code size 244kb */
 }
+#endif
+
+#if ( configMT8507_SECTOR_UPDATE == 1 )
+/* Writes the head of Flash_Buffer to the sector at FlashDestination. The
+   sector is compared first: an identical one is skipped and a blank one is
+   programmed without erase, so a restarted update only rewrites what is left. */
+static void MT8507_FlashData_WriteSector( uint16_t NumByteToWrite )
+{
+    uint32_t Addr;
+    uint16 i, j;
+    uint16 len;
+    bool bIsSame = TRUE;
+    bool bIsBlank = TRUE;
+
+    if (bIsDataDeliving == FALSE)
+    {
+    	SPI_FlashUpdate_mode();
+        sFLASH_DisableWriteProtection();
+        bIsDataDeliving = TRUE;
+    }
+
+    if ( FlashDestination >=  MCU_IMAGE_END )
+        FlashDestination = 0;
+
+    for ( i = 0; (i < NumByteToWrite) && (bIsSame || bIsBlank); i += len )
+    {
+        len = ( (NumByteToWrite - i) > sizeof(rFlash_Buffer) ) ? sizeof(rFlash_Buffer) : (NumByteToWrite - i);
+        sFLASH_ReadBuffer(rFlash_Buffer, FlashDestination + i, len);
+
+        if ( memcmp(rFlash_Buffer, Flash_Buffer + i, len) != 0 )
+        {
+            bIsSame = FALSE;
+        }
+
+        for ( j = 0; (j < len) && bIsBlank; j++ )
+        {
+            if ( rFlash_Buffer[j] != 0xFF )
+            {
+                bIsBlank = FALSE;
+            }
+        }
+    }
+
+    if ( bIsSame )
+    {
+        TRACE_DEBUG((0, "Same MT8507_FlashData_Write  %d ",FlashDestination));
+    }
+    else
+    {
+        if ( bIsBlank == FALSE )
+        {
+            sFLASH_EraseSubSector(FlashDestination);
+        }
+
+        Addr = FlashDestination;
+        sFLASH_WriteBuffer(Flash_Buffer, &Addr, NumByteToWrite);
+        TRACE_DEBUG((0, "Success MT8507_FlashData_Write  %d ",FlashDestination));
+    }
+
+    FlashDestination += NumByteToWrite;
+}
+#endif
 
 static void MT8507_FlashData_Read( uint16_t NumByteToWrite )
 {
@@ -6,6 +6,7 @@
 #define configAPP_ASH 1
 #define configAPP_INTERNAL_DSP_ULD 1
 #define configAPP_EXT_FLASH_FW_UPDATE 0
+#define configMT8507_SECTOR_UPDATE 1 /*MT8507 flash update erases 4KB sectors just in time and skips unchanged ones*/
 #define configLipSync_12steps 1 /* 1 is 20ms*12 steps,0 is 10ms*24steps*/
 
 #if ( configAPP_EXT_FLASH_FW_UPDATE == 1 ) 
@@ -14,6 +14,9 @@
 #include "cs49844.h"
 #include "UIDeviceManager.h"
 #include "ext_flash_driver.h"
+#if ( configCS4953x_CFG_ULZ == 1 )
+#include "cs49844_ulz.h"
+#endif
 
 //___________________________________________________________________________________
 extern AUDIO_LOWLEVEL_DRIVER_OBJECT *pAudLowLevel_ObjCtrl;
@@ -224,6 +227,18 @@ static const CS49844LoadAudioStreamType *pCurtDSP_ULD_TYPE = &gCurDSP_ULD_type;
 static uint8 signal_overthreshold = 1;
 static xSemaphoreHandle _IRQ_SEMA = NULL;
 
+#if ( configCS4953x_IRQ_ISR == 1 )
+/*IRQ edge -> message read latency, bins of 0,1,2-3,4-7,...,64+ ms*/
+#define FCH_LATENCY_BINS 8
+
+static xSemaphoreHandle _FCH_IRQ_SEMA = NULL;
+static portTickType FchIrqEdgeTick = 0;
+static uint16 FchWakeupCount = 0;
+static uint16 FchLatencyHistogram[FCH_LATENCY_BINS];
+
+extern void GPIOLowLevel_CS4953x_ISR_Configure( void );
+#endif
+
 /* PCM load procedure: OS -> tv_cs-> pcm_black_b */
 #if ( configAPP_SPI_FLASH_DSP_ULD == 1 )
 unsigned int PCM_ULD_LOCATION[4][2] = 
@@ -263,6 +278,46 @@ unsigned int ATMOS_ULD_LOCATION[5][2] =
 };
 
 static unsigned char* ULDLoaderbuf = NULL;
+
+#if ( configCS4953x_ULD_DMA == 1 )
+/*two DSPLoadSize halves: one is written to the DSP while the next flash block lands in the other*/
+#define ULD_LOADER_BUF_SIZE ( 2*DSPLoadSize )
+
+static portTickType ULDLoadStartTick = 0; /*reset-to-kickstart time of the last ULD load*/
+
+/*the block read into the idle half while the DSP holds /BUSY*/
+static unsigned char* ULDPrefetchBuf = NULL;
+static unsigned int ULDPrefetchAddr = 0;
+static uint16 ULDPrefetchLength = 0;
+static bool ULDPrefetchDone = FALSE;
+static bool ULDPrefetchError = FALSE;
+#else
+#define ULD_LOADER_BUF_SIZE DSPLoadSize
+#endif
+
+#if ( configCS4953x_ULD_CACHE == 1 )
+/*Segments are keyed by flash location, so the OS ULD shared by every stream type is held
+  once. 6K takes OS + AC3/DTS decoder + their crossbar; the gain ULDs are too big to cache.*/
+#define ULD_CACHE_POOL_SIZE 0x1800
+#define ULD_CACHE_ENTRIES 6
+
+typedef struct _ULD_CACHE_ENTRY
+{
+    unsigned int location;
+    unsigned int length;    /*0: free entry*/
+    unsigned int offset;    /*in ULDCachePool*/
+    uint32 stamp;           /*last use, LRU victim has the smallest*/
+}ULD_CACHE_ENTRY;
+
+static uint8 ULDCachePool[ULD_CACHE_POOL_SIZE];
+static ULD_CACHE_ENTRY ULDCacheEntry[ULD_CACHE_ENTRIES];
+static unsigned int ULDCacheUsed = 0;
+static uint32 ULDCacheClock = 0;
+
+static uint16 ULDCacheHit = 0;
+static uint16 ULDCacheMiss = 0;
+static uint32 ULDCacheSavedBytes = 0; /*bytes not read from SPI flash*/
+#endif
 #endif 
 
 //___________________________________________________________________________
@@ -333,6 +388,14 @@ static int cs49844_LoadDSP_ATMOS_ULD(unsigned char* buf,cs49844_ATMOS_ULD_Type U
 
 #endif 
 
+#if ( configCS4953x_CFG_ULZ == 1 )
+static int8 cs49844_write_packed_cfg( const uint8 *packed, uint32 packed_len );
+
+#define CS49844_WRITE_CFG( table ) cs49844_write_packed_cfg( table##_ULZ, sizeof(table##_ULZ) )
+#else
+#define CS49844_WRITE_CFG( table ) CS49844SPI_write_buffer( (byte*)&table, (sizeof(table)/sizeof(uint8)) )
+#endif
+
 uint8 cs49844_getSignalLevel( void );
 
 static void cs49844_lowlevel_task_setState( TaskHandleState set_state );
@@ -409,6 +472,9 @@ static void cs49844_setMasterGain( uint32 value )
         CS49844SPI_CommandWrite(MASTER_GAIN6, value );
         
         cs49844_spi_mutex_give();
+
+        /*the volume step ends once the new gain is in the DSP*/
+        DEBUG_LATENCY_END( DEBUG_LATENCY_VOLUME_STEP );
     }
 }
 
@@ -1009,6 +1075,54 @@ static void cs49844_parseAudioFMT(CS49844_QUEUE_TYPE *tmp_queue_data, CS49844_AD
     }
 }
 
+#if ( configCS4953x_IRQ_ISR == 1 )
+void cs49844_FchDetector_IrqFromISR( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    if ( _FCH_IRQ_SEMA == NULL )
+        return;
+
+    FchIrqEdgeTick = xTaskGetTickCountFromISR( );
+    xSemaphoreGiveFromISR( _FCH_IRQ_SEMA, &xHigherPriorityTaskWoken );
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+static void cs49844_FchDetector_logLatency( void )
+{
+    portTickType latency = (xTaskGetTickCount( ) - FchIrqEdgeTick)*portTICK_RATE_MS;
+    uint8 bin = 0;
+
+    while( (latency != 0) && (bin < (FCH_LATENCY_BINS - 1)) )
+    {
+        latency >>= 1;
+        bin++;
+    }
+
+    if ( FchLatencyHistogram[bin] != 0xFFFF )
+    {
+        FchLatencyHistogram[bin]++;
+    }
+}
+
+void cs49844_FchDetector_getStatistics( uint16 *wakeups, uint16 *histogram )
+{
+    uint8 i;
+
+    *wakeups = FchWakeupCount;
+    for( i = 0; i < FCH_LATENCY_BINS; i++ )
+    {
+        histogram[i] = FchLatencyHistogram[i];
+    }
+}
+
+void cs49844_FchDetector_resetStatistics( void )
+{
+    FchWakeupCount = 0;
+    memset( FchLatencyHistogram, 0, sizeof(FchLatencyHistogram) );
+}
+#endif
+
 static void cs49844_SendEventToLoader( CS49844_ADECT_MSG msg )
 {
     CS49844_QUEUE_TYPE QUEUE_TYPE;
@@ -1063,6 +1177,12 @@ void cs49844_FchDetector( void *pvParameters )
                     {
                         //TRACE_DEBUG((0, "Read DSP IRQ error ------- !! "));
                     }
+#if ( configCS4953x_IRQ_ISR == 1 )
+                    else
+                    {
+                        cs49844_FchDetector_logLatency( );
+                    }
+#endif
                     cs49844_spi_mutex_give();
                     cs49844_irq_mutex_give();
                 }
@@ -1127,7 +1247,25 @@ void cs49844_FchDetector( void *pvParameters )
              
         }
         #endif  
+#if ( configCS4953x_IRQ_ISR == 1 )
+        /*Sleep until the IRQ edge. A message left pending (mutex busy) keeps the line low
+          without a new edge, so only then fall back to the poll period.*/
+        if ( GPIOMiddleLevel_Read_InBit( __I_SCP1_IRQ ) == 0 )
+        {
+            xSemaphoreTake( _FCH_IRQ_SEMA, FCH_DETECTOR_TIME_TICK );
+        }
+        else
+        {
+            xSemaphoreTake( _FCH_IRQ_SEMA, portMAX_DELAY );
+        }
+
+        if ( FchWakeupCount != 0xFFFF )
+        {
+            FchWakeupCount++;
+        }
+#else
         vTaskDelay( FCH_DETECTOR_TIME_TICK );
+#endif
     }
 
 }
@@ -1293,7 +1431,7 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
 #if ( configAPP_INTERNAL_DSP_ULD == 0 )                
                             if (ULDLoaderbuf == NULL)
                             {
-                                ULDLoaderbuf = (unsigned char*)pvPortMalloc( DSPLoadSize);
+                                ULDLoaderbuf = (unsigned char*)pvPortMalloc( ULD_LOADER_BUF_SIZE );
                             }
                                             
                             if(ULDLoaderbuf == NULL)
@@ -1323,7 +1461,7 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
 #if ( configAPP_INTERNAL_DSP_ULD == 0 )                
                     if (ULDLoaderbuf == NULL)
                     {
-                        ULDLoaderbuf = (unsigned char*)pvPortMalloc( DSPLoadSize);
+                        ULDLoaderbuf = (unsigned char*)pvPortMalloc( ULD_LOADER_BUF_SIZE );
                     }
                                     
                     if(ULDLoaderbuf == NULL)
@@ -1348,6 +1486,10 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
             /*CS49844x Hardware User's Manual p2-8*/
             case LOADER_RESET_DSP:
             {
+#if ( configCS4953x_ULD_DMA == 1 )
+                ULDLoadStartTick = xTaskGetTickCount( );
+#endif
+                DEBUG_LATENCY_BEGIN( DEBUG_LATENCY_ULD_LOAD );
                 cs49844_HardReset( );
                 mLoaderState = LOADER_BOOT_ASSIST;
             }
@@ -1647,7 +1789,7 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
 
             case LOADER_CONIGURATION:
             {
-                if (CS49844SPI_write_buffer((byte*)&PREKICKSTART_CFG, (sizeof(PREKICKSTART_CFG)/sizeof(uint8))) == SCP1_BSY_TIMEOUT )
+                if ( CS49844_WRITE_CFG( PREKICKSTART_CFG ) == SCP1_BSY_TIMEOUT )
                 {
                     mLoaderState = LOADER_ERROR;
                     break;    
@@ -1657,7 +1799,7 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
 
                 if(QueueType.audio_type == CS49844_LOAD_AC3)
                 {
-                    if (CS49844SPI_write_buffer((byte*)&AC3_INITIAL_CFG, (sizeof(AC3_INITIAL_CFG)/sizeof(uint8)) ) == SCP1_BSY_TIMEOUT )
+                    if ( CS49844_WRITE_CFG( AC3_INITIAL_CFG ) == SCP1_BSY_TIMEOUT )
                     {
                         mLoaderState = LOADER_ERROR;
                         break; 
@@ -1665,7 +1807,7 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
                 }
                 else if( QueueType.audio_type == CS49844_LOAD_DTS )
                 {
-                    if (CS49844SPI_write_buffer((byte*)&DTS_INITIAL_CFG, (sizeof(DTS_INITIAL_CFG)/sizeof(uint8)) ) == SCP1_BSY_TIMEOUT )
+                    if ( CS49844_WRITE_CFG( DTS_INITIAL_CFG ) == SCP1_BSY_TIMEOUT )
                     {
                         mLoaderState = LOADER_ERROR;
                         break; 
@@ -1673,7 +1815,7 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
                 }
                 else
                 {
-                    if (CS49844SPI_write_buffer((byte*)&PCM_INITIAL, (sizeof(PCM_INITIAL)/sizeof(uint8)) ) == SCP1_BSY_TIMEOUT )
+                    if ( CS49844_WRITE_CFG( PCM_INITIAL ) == SCP1_BSY_TIMEOUT )
                     {
                         mLoaderState = LOADER_ERROR;
                         break; 
@@ -1692,6 +1834,10 @@ void cs49844_RowDataLoader_Task( void *pvParameters )
                     break;
                 }
                 //TRACE_DEBUG((0, "DSP KICK_START !! "));
+#if ( configCS4953x_ULD_DMA == 1 )
+                TRACE_DEBUG((0, "ULD type %d load time %d ms", QueueType.audio_type, ((xTaskGetTickCount( ) - ULDLoadStartTick)*portTICK_RATE_MS) ));
+#endif
+                DEBUG_LATENCY_END( DEBUG_LATENCY_ULD_LOAD );
 
 #if ( configAPP_INTERNAL_DSP_ULD == 0 )            
                 if(ULDLoaderbuf != NULL)
@@ -1778,6 +1924,15 @@ static void cs49844_FchDetector_TaskCtrl( xOS_TaskCtrl val )
 
 static void cs49844_FchDetector_CreateTask( void )
 {
+#if ( configCS4953x_IRQ_ISR == 1 )
+    if ( _FCH_IRQ_SEMA == NULL )
+    {
+        vSemaphoreCreateBinary( _FCH_IRQ_SEMA );
+    }
+
+    GPIOLowLevel_CS4953x_ISR_Configure( );
+#endif
+
     if ( xTaskCreate( 
             cs49844_FchDetector, 
             ( portCHAR * ) "CS49844_FCH", 
@@ -1934,18 +2089,261 @@ static unsigned int cs49844_Get_DSP_ATMOS_ULD_Length(cs49844_ATMOS_ULD_Type Utyp
 
 #endif 
 
+#if ( configCS4953x_CFG_ULZ == 1 )
+/*256 bytes is a whole number of address/value pairs, so every SPI frame ends on a complete message*/
+#define ULZ_CFG_CHUNK_SIZE 256
+
+static CS49844_ULZ_STREAM ULZCfgStream;
+static byte ULZCfgChunk[ULZ_CFG_CHUNK_SIZE];
+
+static int8 cs49844_write_packed_cfg( const uint8 *packed, uint32 packed_len )
+{
+    uint16 length;
+
+    if ( CS49844ULZ_open( &ULZCfgStream, packed, packed_len ) == FALSE )
+    {
+        return SCP1_BSY_TIMEOUT;
+    }
+
+    while( ULZCfgStream.remain != 0 )
+    {
+        length = CS49844ULZ_read( &ULZCfgStream, ULZCfgChunk, ULZ_CFG_CHUNK_SIZE );
+        if ( length == 0 )
+        {
+            TRACE_ERROR((0, "Packed DSP config is broken !! "));
+            return SCP1_BSY_TIMEOUT;
+        }
+
+        if ( CS49844SPI_write_buffer( ULZCfgChunk, length ) == SCP1_BSY_TIMEOUT )
+        {
+            return SCP1_BSY_TIMEOUT;
+        }
+    }
+
+    return SCP1_PASS;
+}
+#endif
+
+#if ( configAPP_SPI_FLASH_DSP_ULD == 1 ) && ( configCS4953x_ULD_DMA == 1 )
+/*Runs with the SPI bus released while the DSP holds /BUSY*/
+static bool cs49844_LoadDSP_ULD_BusyIdle( void )
+{
+    if ( (ULDPrefetchLength == 0) || (ULDPrefetchDone == TRUE) )
+    {
+        return FALSE;
+    }
+
+    if ( sFLASH_ReadBuffer(ULDPrefetchBuf, ULDPrefetchAddr, ULDPrefetchLength) == FALSE )
+    {
+        ULDPrefetchError = TRUE;
+    }
+    ULDPrefetchDone = TRUE;
+
+    return TRUE;
+}
+
+/*Streams one ULD segment flash -> DSP through the two halves of ULDLoaderbuf. The flash read
+  of block n+1 fills the /BUSY holds of block n; whatever was not read by then is read after.*/
+static int8 cs49844_LoadDSP_ULD_Stream( unsigned int Addr, unsigned int length )
+{
+    unsigned char *pSend = ULDLoaderbuf;
+    unsigned char *pNext = ULDLoaderbuf + DSPLoadSize;
+    unsigned char *pTemp;
+    uint16 block;
+    int8 dsp_spi_ret = SCP1_PASS;
+
+    block = (length > DSPLoadSize) ? DSPLoadSize : length;
+    if ( block == 0 )
+    {
+        return SCP1_PASS;
+    }
+
+    if ( sFLASH_ReadBuffer(pSend, Addr, block) == FALSE )
+    {
+        return SCP1_BSY_TIMEOUT;
+    }
+
+    while( block != 0 )
+    {
+        Addr += block;
+        length -= block;
+
+        ULDPrefetchBuf = pNext;
+        ULDPrefetchAddr = Addr;
+        ULDPrefetchLength = (length > DSPLoadSize) ? DSPLoadSize : length;
+        ULDPrefetchDone = FALSE;
+        ULDPrefetchError = FALSE;
+
+        dsp_spi_ret = CS49844SPI_write_ULD_buffer_idle(pSend, block, cs49844_LoadDSP_ULD_BusyIdle);
+        if ( dsp_spi_ret != SCP1_PASS )
+        {
+            break;
+        }
+
+        cs49844_LoadDSP_ULD_BusyIdle( );
+        if ( ULDPrefetchError == TRUE )
+        {
+            dsp_spi_ret = SCP1_BSY_TIMEOUT;
+            break;
+        }
+
+        block = ULDPrefetchLength;
+        pTemp = pSend;
+        pSend = pNext;
+        pNext = pTemp;
+    }
+
+    ULDPrefetchLength = 0;
+
+    return dsp_spi_ret;
+}
+#endif
+
+#if ( configAPP_SPI_FLASH_DSP_ULD == 1 ) && ( configCS4953x_ULD_CACHE == 1 )
+static void cs49844_ULDCache_evict( uint8 idx )
+{
+    uint8 i;
+    unsigned int offset = ULDCacheEntry[idx].offset;
+    unsigned int length = ULDCacheEntry[idx].length;
+
+    /*keep the pool packed; segments are a few K, so moving them is cheaper than a flash re-read*/
+    memmove( (ULDCachePool + offset), (ULDCachePool + offset + length), (ULDCacheUsed - offset - length) );
+    ULDCacheUsed -= length;
+
+    for( i = 0; i < ULD_CACHE_ENTRIES; i++ )
+    {
+        if ( (ULDCacheEntry[i].length != 0) && (ULDCacheEntry[i].offset > offset) )
+        {
+            ULDCacheEntry[i].offset -= length;
+        }
+    }
+
+    ULDCacheEntry[idx].length = 0;
+}
+
+/*Returns the segment in SRAM, reading it from flash on a miss; NULL if it does not fit the pool*/
+static const uint8* cs49844_ULDCache_fetch( unsigned int location, unsigned int length )
+{
+    uint8 i;
+    uint8 slot = ULD_CACHE_ENTRIES;
+    uint8 victim;
+
+    for( i = 0; i < ULD_CACHE_ENTRIES; i++ )
+    {
+        if ( (ULDCacheEntry[i].length == length) && (ULDCacheEntry[i].location == location) )
+        {
+            ULDCacheEntry[i].stamp = ++ULDCacheClock;
+            ULDCacheHit++;
+            ULDCacheSavedBytes += length;
+            return (ULDCachePool + ULDCacheEntry[i].offset);
+        }
+    }
+
+    ULDCacheMiss++;
+
+    if ( (length == 0) || (length > ULD_CACHE_POOL_SIZE) )
+    {
+        return NULL;
+    }
+
+    for( ;; )
+    {
+        victim = ULD_CACHE_ENTRIES;
+        slot = ULD_CACHE_ENTRIES;
+
+        for( i = 0; i < ULD_CACHE_ENTRIES; i++ )
+        {
+            if ( ULDCacheEntry[i].length == 0 )
+            {
+                if ( slot == ULD_CACHE_ENTRIES )
+                    slot = i;
+            }
+            else if ( (victim == ULD_CACHE_ENTRIES) || (ULDCacheEntry[i].stamp < ULDCacheEntry[victim].stamp) )
+            {
+                victim = i;
+            }
+        }
+
+        if ( (slot != ULD_CACHE_ENTRIES) && ((ULD_CACHE_POOL_SIZE - ULDCacheUsed) >= length) )
+            break;
+
+        cs49844_ULDCache_evict( victim );
+    }
+
+    if ( sFLASH_ReadBuffer( (ULDCachePool + ULDCacheUsed), location, (uint16)length ) == FALSE )
+    {
+        return NULL;
+    }
+
+    ULDCacheEntry[slot].location = location;
+    ULDCacheEntry[slot].length = length;
+    ULDCacheEntry[slot].offset = ULDCacheUsed;
+    ULDCacheEntry[slot].stamp = ++ULDCacheClock;
+    ULDCacheUsed += length;
+
+    return (ULDCachePool + ULDCacheEntry[slot].offset);
+}
+
+void cs49844_ULDCache_getStatistics( uint16 *hit, uint16 *miss, uint32 *saved_bytes )
+{
+    *hit = ULDCacheHit;
+    *miss = ULDCacheMiss;
+    *saved_bytes = ULDCacheSavedBytes;
+}
+
+void cs49844_ULDCache_resetStatistics( void )
+{
+    ULDCacheHit = 0;
+    ULDCacheMiss = 0;
+    ULDCacheSavedBytes = 0;
+}
+#endif
+
 #if ( configAPP_SPI_FLASH_DSP_ULD == 1 )
 static int cs49844_LoadDSP_ULD(unsigned char* buf,CS49844LoadAudioStreamType Stype ,cs49844_ULD_Type Utype )
 {
+#if ( configCS4953x_ULD_DMA == 0 )
     int i;
+    unsigned int NumOfDSPLoad,NumOfSingle,Addr;
+#endif
     int8 dsp_spi_ret;
     unsigned int sLocation,ULDLength;  
-    unsigned int NumOfDSPLoad,NumOfSingle,Addr;
     int8 ret_val = 1;
+#if ( configCS4953x_ULD_CACHE == 1 )
+    const uint8 *pCached;
+#endif
 
     sLocation = cs49844_Get_DSP_ULD_StartLocation(Stype,Utype);
     ULDLength = cs49844_Get_DSP_ULD_Length(Stype,Utype);
 
+#if ( configCS4953x_ULD_CACHE == 1 )
+    /*the hard reset clears the DSP, so every segment is still written; a hit only skips the flash read*/
+    pCached = cs49844_ULDCache_fetch( sLocation, ULDLength );
+    if ( pCached != NULL )
+    {
+#if ( configCS4953x_ULD_DMA == 1 )
+        dsp_spi_ret = CS49844SPI_write_ULD_buffer_idle( pCached, (uint16)ULDLength, NULL );
+#else
+        dsp_spi_ret = CS49844SPI_write_ULD_buffer( pCached, (uint16)ULDLength );
+#endif
+        if ( dsp_spi_ret != SCP1_PASS )
+        {
+            TRACE_DEBUG((0, "Write cached DSP ULD have ERROR !!!\n"));
+            ret_val = 0;
+        }
+
+        return ret_val;
+    }
+#endif
+
+#if ( configCS4953x_ULD_DMA == 1 )
+    dsp_spi_ret = cs49844_LoadDSP_ULD_Stream(sLocation, ULDLength);
+    if ( dsp_spi_ret != SCP1_PASS )
+    {
+        TRACE_DEBUG((0, "Stream DSP ULD have ERROR !!!\n"));
+        ret_val = 0;
+    }
+#else
     Addr = sLocation;
     NumOfDSPLoad = ULDLength/DSPLoadSize;
     NumOfSingle = ULDLength%DSPLoadSize;
@@ -1993,6 +2391,7 @@ static int cs49844_LoadDSP_ULD(unsigned char* buf,CS49844LoadAudioStreamType Sty
             }
         }
     }
+#endif
     
 
     if (ret_val != 0)
@@ -2036,15 +2435,25 @@ static int cs49844_LoadDSP_ULD(unsigned char* buf,CS49844LoadAudioStreamType Sty
 
 static int cs49844_LoadDSP_ATMOS_ULD(unsigned char* buf,cs49844_ATMOS_ULD_Type Utype )
 {
+#if ( configCS4953x_ULD_DMA == 0 )
     int i;
+    unsigned int NumOfDSPLoad,NumOfSingle,Addr;
+#endif
     int8 dsp_spi_ret;
     unsigned int sLocation,ULDLength;  
-    unsigned int NumOfDSPLoad,NumOfSingle,Addr;
     int8 ret_val = 1;
 
     sLocation = cs49844_Get_DSP_ATMOS_ULD_StartLocation(Utype);
     ULDLength = cs49844_Get_DSP_ATMOS_ULD_Length(Utype);
 
+#if ( configCS4953x_ULD_DMA == 1 )
+    dsp_spi_ret = cs49844_LoadDSP_ULD_Stream(sLocation, ULDLength);
+    if ( dsp_spi_ret != SCP1_PASS )
+    {
+        TRACE_DEBUG((0, "Stream DSP ULD have ERROR !!!\n"));
+        ret_val = 0;
+    }
+#else
     Addr = sLocation;
     NumOfDSPLoad = ULDLength/DSPLoadSize;
     NumOfSingle = ULDLength%DSPLoadSize;
@@ -2092,6 +2501,7 @@ static int cs49844_LoadDSP_ATMOS_ULD(unsigned char* buf,cs49844_ATMOS_ULD_Type U
             }
         }
     }
+#endif
     
 
     if (ret_val != 0)
@@ -94,4 +94,18 @@ typedef struct _CS49844_LOWLEVEL_OBJECT
     bool (*loader_load_fmt_mutex_give)( void );
 }DSP_CTRL_OBJECT;
 
+#if ( configCS4953x_ULD_CACHE == 1 )
+void cs49844_ULDCache_getStatistics( uint16 *hit, uint16 *miss, uint32 *saved_bytes );
+
+void cs49844_ULDCache_resetStatistics( void );
+#endif
+
+#if ( configCS4953x_IRQ_ISR == 1 )
+void cs49844_FchDetector_IrqFromISR( void );
+
+void cs49844_FchDetector_getStatistics( uint16 *wakeups, uint16 *histogram );
+
+void cs49844_FchDetector_resetStatistics( void );
+#endif
+
 #endif /*__CS49844_H__*/
@@ -14,6 +14,11 @@
 #define SLAVE_ADDRESS_R_CS49844	0x81
 
 #define TIMEOUT TASK_MSEC2TICKS(500)
+
+#if ( configCS4953x_ULD_DMA == 1 )
+/*/BUSY polls before the bus is handed back; a word is normally taken well within them*/
+#define ULD_BUSY_SPIN 256
+#endif
 /*-------------------------------------------------------------------------------------------*/
 
 /** Endianity Mode*/
@@ -197,6 +202,102 @@ int8 CS49844SPI_write_ULD_buffer(const byte* data, uint16 length)
 }
 
 
+#if ( configCS4953x_ULD_DMA == 1 )
+/*Same 32-bit word /BUSY handshake as CS49844SPI_write_ULD_buffer, the only depth the SCP
+  port documents. When the DSP holds /BUSY past ULD_BUSY_SPIN polls, the chip is deselected
+  and the SPI mutex released around busy_idle(), which may use the bus itself (the next flash
+  block is read there). It returns FALSE when it had nothing to do, then one tick is slept.*/
+int8 CS49844SPI_write_ULD_buffer_idle(const byte* data, uint16 length, bool (*busy_idle)(void))
+{
+    uint16 offset = 0;
+    uint16 word = 0;
+    uint16 spin = 0;
+    uint8 j;
+    portTickType busy_timeout = 0;
+    int ret_val = SCP1_PASS;
+
+    if ( SPILowLevel_isEnable( ) == FALSE )
+    {
+        ret_val = SCP1_BYPASS;
+        return ret_val;
+    }
+    /* SPI lock*/
+    if (SPI_mutex_lock() == FALSE)
+    {
+        ret_val = SCP1_BSY_TIMEOUT;
+        return ret_val;
+    }
+
+    /* Select SPI chip.*/
+    SPI_selectChip(CS49844_SPI_NPCS);
+    SPI_write( SLAVE_ADDRESS_W_CS49844 );
+
+    while ( offset < length )
+    {
+        word = length - offset;
+        if ( word > 4 )
+        {
+            word = 4;
+        }
+
+        for ( j = 0; j < word; j++ )
+        {
+            SPI_write(*(data+offset+j));
+        }
+        offset += word;
+
+        spin = 0;
+        busy_timeout = xTaskGetTickCount( );
+        while( GPIOMiddleLevel_Read_InBit( __I_SCP1_BUSY ) == 0 )
+        {
+            if ( ((xTaskGetTickCount() - busy_timeout)/portTICK_RATE_MS) > TIMEOUT )
+            {
+                ret_val = SCP1_BSY_TIMEOUT;
+                break;
+            }
+
+            spin++;
+            if ( spin < ULD_BUSY_SPIN )
+            {
+                continue;
+            }
+
+            /*a word boundary, so the next frame just starts with the slave address again*/
+            SPI_unselectChip(CS49844_SPI_NPCS);
+            SPI_mutex_unlock();
+
+            if ( (busy_idle == NULL) || (busy_idle( ) == FALSE) )
+            {
+                vTaskDelay( TASK_MSEC2TICKS(1) );
+            }
+
+            if (SPI_mutex_lock() == FALSE)
+            {
+                ret_val = SCP1_BSY_TIMEOUT;
+                return ret_val;
+            }
+
+            SPI_selectChip(CS49844_SPI_NPCS);
+            SPI_write( SLAVE_ADDRESS_W_CS49844 );
+            spin = 0;
+        }
+
+        if (ret_val == SCP1_BSY_TIMEOUT)
+        {
+            break;
+        }
+    }
+
+    SPI_unselectChip(CS49844_SPI_NPCS);
+
+    /* SPI unlock*/
+    SPI_mutex_unlock();
+
+    return ret_val;
+}
+#endif
+
+
 int8 CS49844SPI_read_buffer( byte* data, uint16 length )
 {
     portTickType irq_timeout = 0;
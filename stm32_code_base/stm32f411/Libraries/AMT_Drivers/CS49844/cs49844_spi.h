@@ -32,5 +32,9 @@ bool CS49844SPI_ReadSolicited( uint32 cmd, uint32 *pValue );
 
 int8 CS49844SPI_write_ULD_buffer(const byte* data, uint16 length);
 
+#if ( configCS4953x_ULD_DMA == 1 )
+int8 CS49844SPI_write_ULD_buffer_idle(const byte* data, uint16 length, bool (*busy_idle)(void));
+#endif
+
 
 #endif /*__CS49XXXX_SPI_H__*/
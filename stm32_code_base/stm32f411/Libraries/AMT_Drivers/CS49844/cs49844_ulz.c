@@ -0,0 +1,102 @@
+#include "Defs.h"
+#include "cs49844_ulz.h"
+
+#define ULZ_MIN_MATCH 3
+#define ULZ_TOKEN_MATCH 0x80
+
+bool CS49844ULZ_open( CS49844_ULZ_STREAM *stream, const uint8 *packed, uint32 packed_len )
+{
+    if ( (stream == NULL) || (packed == NULL) || (packed_len < ULZ_HEADER_SIZE) )
+        return FALSE;
+
+    stream->src = packed;
+    stream->src_len = packed_len;
+    stream->src_pos = ULZ_HEADER_SIZE;
+    stream->remain = (uint32)packed[0] | ((uint32)packed[1] << 8) | ((uint32)packed[2] << 16) | ((uint32)packed[3] << 24);
+    stream->win_pos = 0;
+    stream->literal = 0;
+    stream->match = 0;
+    stream->distance = 0;
+    stream->history[0] = 0;
+    stream->history[1] = 0;
+
+    return ((stream->remain % 4) == 0);
+}
+
+static bool CS49844ULZ_nextByte( CS49844_ULZ_STREAM *stream, uint8 *value )
+{
+    uint8 token;
+
+    while( (stream->literal == 0) && (stream->match == 0) )
+    {
+        if ( stream->src_pos >= stream->src_len )
+            return FALSE;
+
+        token = stream->src[stream->src_pos++];
+        if ( token < ULZ_TOKEN_MATCH )
+        {
+            stream->literal = token + 1;
+        }
+        else
+        {
+            if ( stream->src_pos >= stream->src_len )
+                return FALSE;
+
+            stream->match = (token & 0x7F) + ULZ_MIN_MATCH;
+            stream->distance = (uint16)stream->src[stream->src_pos++] + 1;
+        }
+    }
+
+    if ( stream->literal != 0 )
+    {
+        if ( stream->src_pos >= stream->src_len )
+            return FALSE;
+
+        *value = stream->src[stream->src_pos++];
+        stream->literal--;
+    }
+    else
+    {
+        /*uint8 index wraps with the 256 byte window*/
+        *value = stream->window[(uint8)(stream->win_pos - stream->distance)];
+        stream->match--;
+    }
+
+    stream->window[stream->win_pos++] = *value;
+
+    return TRUE;
+}
+
+uint16 CS49844ULZ_read( CS49844_ULZ_STREAM *stream, byte *data, uint16 length )
+{
+    uint16 count = 0;
+    uint32 word;
+    uint8 i, value;
+
+    while( (count + 4 <= length) && (stream->remain != 0) )
+    {
+        word = 0;
+        for( i = 0; i < 4; i++ )
+        {
+            if ( CS49844ULZ_nextByte( stream, &value ) == FALSE )
+            {
+                stream->remain = 0;
+                return 0;
+            }
+            word |= ((uint32)value << (i*8));
+        }
+
+        /*undo the stride-2 delta*/
+        word += stream->history[0];
+        stream->history[0] = stream->history[1];
+        stream->history[1] = word;
+
+        data[count++] = (byte)(word & 0xFF);
+        data[count++] = (byte)((word >> 8) & 0xFF);
+        data[count++] = (byte)((word >> 16) & 0xFF);
+        data[count++] = (byte)((word >> 24) & 0xFF);
+        stream->remain -= 4;
+    }
+
+    return count;
+}
@@ -0,0 +1,30 @@
+#ifndef __CS49844_ULZ_H__
+#define __CS49844_ULZ_H__
+
+#include "Defs.h"
+
+/*ULZ: byte LZ with a 256 byte window over stride-2 delta coded 32-bit words.
+  Packed by EWARM/uld_pack.py; the first 4 bytes hold the raw length.*/
+#define ULZ_WINDOW_SIZE 256
+#define ULZ_HEADER_SIZE 4
+
+typedef struct _CS49844_ULZ_STREAM
+{
+    const uint8 *src;
+    uint32 src_len;
+    uint32 src_pos;
+    uint32 remain;          /*raw bytes still to be produced*/
+    uint8 window[ULZ_WINDOW_SIZE];
+    uint8 win_pos;
+    uint8 literal;          /*literal bytes left in the current token*/
+    uint8 match;            /*copy bytes left in the current token*/
+    uint16 distance;
+    uint32 history[2];      /*w[n-2], w[n-1]*/
+}CS49844_ULZ_STREAM;
+
+bool CS49844ULZ_open( CS49844_ULZ_STREAM *stream, const uint8 *packed, uint32 packed_len );
+
+/*Decodes up to length bytes (a multiple of 4) into data; returns the bytes written, 0 at the end or on a broken stream*/
+uint16 CS49844ULZ_read( CS49844_ULZ_STREAM *stream, byte *data, uint16 length );
+
+#endif /*__CS49844_ULZ_H__*/
@@ -63,3 +63,15 @@ bool CS5346_WriteI2C_Byte(byte RegAddr,byte uc)
     return TRUE;
 }
 
+#if ( configI2C2_SCRIPT == 1 )
+bool CS5346_WriteI2C_Script(const I2C2_SCRIPT_ENTRY *script, uint16 count)
+{
+    if ( I2C2_runScript(CS5346_I2C_ADDR, script, count) == FALSE )
+    {
+        TRACE_ERROR((0, " CS5346 I2C script error !! "));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
@@ -9,5 +9,9 @@ byte CS5346_ReadI2C_Byte(byte RegAddr);
 
 bool CS5346_WriteI2C_Byte(byte RegAddr,byte uc);
 
+#if ( configI2C2_SCRIPT == 1 )
+bool CS5346_WriteI2C_Script(const I2C2_SCRIPT_ENTRY *script, uint16 count);
+#endif
+
 
 #endif /*__CS5346_I2C_H__*/
@@ -261,12 +261,31 @@ void CS5346_Select_Divider(uint8 value)
 	
 }
 
+#if ( configI2C2_SCRIPT == 1 )
+static const I2C2_SCRIPT_ENTRY m_InitScript[] = 
+{
+    I2C2_SCRIPT_WRITE(CS5346_POWER_CONTROL, 0x01),                /*power down*/
+    I2C2_SCRIPT_UPDATE(CS5346_ADC_CONTROL, 0x15, 0x10),           /*unmute, slave, I2S in one read-modify-write*/
+    I2C2_SCRIPT_WRITE(CS5346_ANALOG_INPUT_CONTROL, 0x19),         /*ANALOG_INPUT_1*/
+
+    //0x00 ->0db , 0x06 ->3db
+    I2C2_SCRIPT_WRITE(CS5346_PGA_CH_A_GAIN_CONTROL, 0x04),
+    I2C2_SCRIPT_WRITE(CS5346_PGA_CH_B_GAIN_CONTROL, 0x04),
+
+    I2C2_SCRIPT_UPDATE(CS5346_MCLK_FREQUENCY, 0x70, 0x00),        /*DIVIDER_1*/
+    I2C2_SCRIPT_WRITE(CS5346_POWER_CONTROL, 0x00)                 /*power up*/
+};
+#endif
+
 static void CS5346_Initialize( void )
 {
     //
     // Send required startup commands, these are apparently required for ADC temperature stability
     //
 
+#if ( configI2C2_SCRIPT == 1 )
+    CS5346_WriteI2C_Script(m_InitScript, I2C2_SCRIPT_LENGTH(m_InitScript));
+#else
     CS5346_PowerUpDown(0);
     CS5346_Mute(0);
     CS5346_setInputPath(ANALOG_INPUT_1);
@@ -278,5 +297,6 @@ static void CS5346_Initialize( void )
     CS5346_Select_Format(I2S);
     CS5346_Select_Divider(0);
     CS5346_PowerUpDown(1);
+#endif
 }
 
@@ -174,9 +174,19 @@ void CS8422_ISR_Handler( void *pvParameters )
                         pAudLowLevel_ObjCtrl->ExceptionSender(&tmp_QueueType);
                     }
                 }
+
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+                /*Lock or format has changed: the ADM detectors read the receiver once*/
+                if ( cs8422_int_status.bits.fch || cs8422_int_status.bits.rerr )
+                {
+                    AudioDeviceManager_SrcDetector_wakeup( );
+                }
+#endif
             }            
         }
+#if ( configCS8422_EVENT_DETECTOR == 0 )
 		vTaskDelay(TASK_MSEC2TICKS(1));
+#endif
     }
 }
 
@@ -219,7 +229,11 @@ static void CS8422_ISR_IntConfig( void )
     pGPIOIsr_ObjCtrl->src_isr_configure( );
     
     mCS8422IsrParsms.QParams.xQueue = xQueueCreate( CS8422_ISR_QUEUE_LENGTH, FRTOS_SIZE(uint8) );
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+    mCS8422IsrParsms.QParams.xBlockTime = portMAX_DELAY; /*only the EXTI wakes this task*/
+#else
     mCS8422IsrParsms.QParams.xBlockTime = BLOCK_TIME(0);
+#endif
     if( mCS8422IsrParsms.QParams.xQueue == NULL )
     {
        TRACE_ERROR((0, "mCS8422IsrParsms queue creates failure " ));
@@ -76,3 +76,21 @@ bool CS8422_WriteI2C_Byte(byte RegAddr,byte uc)
 
     return TRUE;
 }
+
+#if ( configI2C2_SCRIPT == 1 )
+bool CS8422_WriteI2C_Script(const I2C2_SCRIPT_ENTRY *script, uint16 count)
+{
+    AUDIO_EXCEPTION_QUEUE_TYPE tmp_QueueType;
+
+    if ( I2C2_runScript(CS8422_I2C_ADDR, script, count) == FALSE )
+    {
+        TRACE_ERROR((0, "CS8422 I2C script error !!"));
+        tmp_QueueType.event = SRC_BUS_FAULT;
+        pAudLowLevel_ObjCtrl->ExceptionSender(&tmp_QueueType);
+        
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
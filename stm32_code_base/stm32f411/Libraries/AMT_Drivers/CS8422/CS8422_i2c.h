@@ -8,5 +8,9 @@ byte CS8422_ReadI2C_Byte(byte RegAddr);
 
 bool CS8422_WriteI2C_Byte(byte RegAddr,byte uc);
 
+#if ( configI2C2_SCRIPT == 1 )
+bool CS8422_WriteI2C_Script(const I2C2_SCRIPT_ENTRY *script, uint16 count);
+#endif
+
 
 #endif /*__CS8422_I2C_H__*/
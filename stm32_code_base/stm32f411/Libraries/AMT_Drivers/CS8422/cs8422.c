@@ -432,8 +432,37 @@ static void CS8422_SRC_setPath_SerialAudioInput(void)
     CS8422_SerialAudioOutput( 2 );    /*Set serial data output */
 }
 
+#if ( configI2C2_SCRIPT == 1 )
+/*Register values and comments of the register writes in CS8422_init below*/
+static const I2C2_SCRIPT_ENTRY m_InitScript[] = 
+{
+    // Here is for crystal 12.288 Mhz @{
+    I2C2_SCRIPT_WRITE(0x00, 0x00),
+    I2C2_SCRIPT_WRITE(0x01, 0x10),
+    I2C2_SCRIPT_WRITE(0x02, 0x62),  /*Clock Control: SWCLK, INT open drain active low*/
+    I2C2_SCRIPT_WRITE(0x03, 0x80),  /*Receiver Input Control*/
+    I2C2_SCRIPT_WRITE(0x04, 0x04), 
+    I2C2_SCRIPT_WRITE(0x05, 0x90),  /*CS8422 GPO0 is 96KHZ indicator; GPO1 is receiver error indicator*/
+    I2C2_SCRIPT_WRITE(0x06, 0x30),  /*GPO2 is for interrupt pin*/
+    I2C2_SCRIPT_WRITE(0x07, 0x48),  /* Serial Audio Input Clock Control*/
+    I2C2_SCRIPT_WRITE(0x08, 0x40),  /*SAO_MCLK[3] Selects the MCLK as XTI/O*/
+    I2C2_SCRIPT_WRITE(0x09, 0x48),  /* Recevered MasterClock Ration Control */
+    I2C2_SCRIPT_WRITE(0x0A, 0x52),  /*Data Routing Control*/
+    I2C2_SCRIPT_WRITE(0x0B, 0x88),  /*Serial Audio Input Data Format as 48Khz*/
+    I2C2_SCRIPT_WRITE(0x0C, 0x84),  /*SDOUT1 - Master mode; I2S output*/
+    I2C2_SCRIPT_WRITE(0x0D, 0x80),  /*SDOUT2*/
+    I2C2_SCRIPT_WRITE(0x0E, 0xFF),  /*Receiver Error Unmasking*/
+    I2C2_SCRIPT_WRITE(0x0F, 0x0A),  /*INTERRUPT UNMASK*/
+    I2C2_SCRIPT_WRITE(0x10, 0x05),  /*Set ERROR is Falling edge*/
+    I2C2_SCRIPT_WRITE(0x16, 0x10)
+};
+#endif
+
 void CS8422_init(void)
 {
+#if ( configI2C2_SCRIPT == 1 )
+    CS8422_WriteI2C_Script(m_InitScript, I2C2_SCRIPT_LENGTH(m_InitScript));
+#else
      // Here is for crystal 12.288 Mhz @{
     CS8422_WriteI2C_Byte(0x00,0x00);
     CS8422_WriteI2C_Byte(0x01,0x10);
@@ -498,6 +527,7 @@ void CS8422_init(void)
     CS8422_WriteI2C_Byte(0x10,0x05);
     
     CS8422_WriteI2C_Byte(0x16,0x10);
+#endif
 }
 
 static void CS8422_SRC_Initialize( void )
@@ -1,6 +1,10 @@
 #include "ext_flash_driver.h"
 #include "SPILowLevel.h"
 
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+#include "freertos_conf.h"
+#endif
+
 #if ( configSPI_FLASH == 1 )
 //___________________________________________________________________________________________
 
@@ -47,20 +51,176 @@
 #define W25Q80BV_STATUS_BUSY 0x01
 #define W25Q80BV_DEVICE_ID_RES 0x13 /* Expected device_id for W25Q80BV */
 
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+/*shorter data phases are polled, the DMA setup and wake-up cost more than the bytes*/
+#define sFLASH_DMA_MIN_LENGTH     32
+/*a page program takes about 1ms, a sector erase hundreds of ms*/
+#define sFLASH_PROGRAM_POLL_TICKS ( 1 )
+#define sFLASH_ERASE_POLL_TICKS   ( 10/portTICK_RATE_MS )
+#endif
+
+#if defined ( FREE_RTOS )
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+#define sFLASH_LOCK()   sFLASH_Acquire()
+#else
+#define sFLASH_LOCK()   SPI_mutex_lock()
+#endif
+#endif
+
 
 //___________________________________________________________________________________________
 uint8_t device_id;
+
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+/*a program/erase was issued and WIP has not been seen clear yet; every access waits it out first*/
+static volatile bool sFLASH_bPending = FALSE;
+static portTickType sFLASH_PollTicks = sFLASH_PROGRAM_POLL_TICKS;
+static xTimerHandle sFLASH_PollTimer = NULL;
+#endif
 //___________________________________________________________________________________________
 
 static void sFLASH_WriteEnable(void);
 
 static void sFLASH_WaitForWriteEnd(void);
 
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+static bool sFLASH_Acquire(void);
+#endif
+
 //static
     uint32_t sFLASH_ReadID(void);
 
 
 //___________________________________________________________________________________
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+/*Reads the status register once; the caller holds the SPI mutex*/
+static bool sFLASH_IsWriteInProgress(void)
+{
+  uint8_t flashstatus = 0;
+
+  sFLASH_CS_LOW();
+  sFLASH_SendByte(sFLASH_CMD_RDSR);
+  flashstatus = sFLASH_SendByte(sFLASH_DUMMY_BYTE);
+  sFLASH_CS_HIGH();
+
+  return ((flashstatus & sFLASH_WIP_FLAG) == SET) ? TRUE : FALSE;
+}
+
+/*Status-poll timer: notes the end of a program/erase nobody is waiting on*/
+static void sFLASH_PollTimer_Callback( xTimerHandle xTimer )
+{
+  /*bus in use, look again next period*/
+  if (SPI_mutex_trylock() == FALSE)
+  {
+    return;
+  }
+
+  if ((sFLASH_bPending == FALSE) || (sFLASH_IsWriteInProgress() == FALSE))
+  {
+    sFLASH_bPending = FALSE;
+    xTimerStop( xTimer, 0 );
+  }
+
+  SPI_mutex_unlock();
+}
+
+/*Marks a program/erase as started and arms the status-poll timer; the caller holds the SPI mutex*/
+static void sFLASH_SetPending( portTickType PollTicks )
+{
+  sFLASH_bPending = TRUE;
+  sFLASH_PollTicks = PollTicks;
+
+  if (sFLASH_PollTimer == NULL)
+  {
+    sFLASH_PollTimer = xTimerCreate( "sFLASH", PollTicks, pdTRUE, NULL, sFLASH_PollTimer_Callback );
+  }
+
+  if (sFLASH_PollTimer != NULL)
+  {
+    /*also (re)starts the timer; a full timer queue is harmless, the next access polls anyway*/
+    xTimerChangePeriod( sFLASH_PollTimer, PollTicks, 0 );
+  }
+}
+
+/*Takes the SPI mutex with the flash idle. A pending program/erase is waited out
+  with the mutex released, so the DSP can use the bus meanwhile*/
+static bool sFLASH_Acquire(void)
+{
+  if (SPI_mutex_lock() == FALSE)
+  {
+    return FALSE;
+  }
+
+  while (sFLASH_bPending == TRUE)
+  {
+    if (sFLASH_IsWriteInProgress() == FALSE)
+    {
+      sFLASH_bPending = FALSE;
+      break;
+    }
+
+    SPI_mutex_unlock();
+    vTaskDelay( sFLASH_PollTicks );
+
+    if (SPI_mutex_lock() == FALSE)
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  * @brief  Tells whether a program/erase is still running in the FLASH.
+  * @param  None
+  * @retval TRUE until the status-poll timer or a later access has seen WIP clear.
+  */
+bool sFLASH_IsBusy(void)
+{
+  return sFLASH_bPending;
+}
+
+/**
+  * @brief  Starts a sector erase and returns at once. The status-poll timer
+  *         notes its end; any later FLASH access waits for it.
+  * @param  SectorAddr: address of the sector to erase.
+  * @retval TRUE if the erase was issued.
+  */
+bool sFLASH_EraseSector_Async(uint32_t SectorAddr)
+{
+  if (sFLASH_Acquire() == FALSE)
+  {
+    return FALSE;
+  }
+
+  /*!< Send write enable instruction */
+  sFLASH_WriteEnable();
+
+  /*!< Sector Erase instruction and 24-bit address */
+  sFLASH_CS_LOW();
+  sFLASH_SendByte(sFLASH_CMD_SE);
+  sFLASH_SendByte((SectorAddr & 0xFF0000) >> 16);
+  sFLASH_SendByte((SectorAddr & 0xFF00) >> 8);
+  sFLASH_SendByte(SectorAddr & 0xFF);
+  sFLASH_CS_HIGH();
+
+  sFLASH_SetPending( sFLASH_ERASE_POLL_TICKS );
+
+  SPI_mutex_unlock();
+
+  return TRUE;
+}
+
+void sFLASH_EraseSector(uint32_t SectorAddr)
+{
+  if (sFLASH_EraseSector_Async(SectorAddr) == TRUE)
+  {
+    /*!< Wait the end of Flash writing */
+    sFLASH_WaitForWriteEnd();
+  }
+}
+#else
 void sFLASH_EraseSector(uint32_t SectorAddr)
 {
 
@@ -96,6 +256,7 @@ void sFLASH_EraseSector(uint32_t SectorAddr)
 #endif 
 
 }
+#endif
 
 /**
   * @brief  Erases the entire FLASH.
@@ -104,6 +265,27 @@ void sFLASH_EraseSector(uint32_t SectorAddr)
   */
 void sFLASH_EraseChip(void)
 {
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+  if (sFLASH_Acquire() == FALSE)
+  {
+    return;
+  }
+
+  /*!< Send write enable instruction */
+  sFLASH_WriteEnable();
+
+  /*!< Send Bulk Erase instruction  */
+  sFLASH_CS_LOW();
+  sFLASH_SendByte(sFLASH_CMD_CE);
+  sFLASH_CS_HIGH();
+
+  sFLASH_SetPending( sFLASH_ERASE_POLL_TICKS );
+
+  SPI_mutex_unlock();
+
+  /*!< Wait the end of Flash writing */
+  sFLASH_WaitForWriteEnd();
+#else
 
 #if defined ( FREE_RTOS )
     if (SPI_mutex_lock() == FALSE)
@@ -129,6 +311,7 @@ void sFLASH_EraseChip(void)
 #if defined ( FREE_RTOS )  
   SPI_mutex_unlock();
 #endif 
+#endif
 
 }
 
@@ -141,14 +324,60 @@ void sFLASH_EraseChip(void)
   * @param  WriteAddr: FLASH's internal address to write to.
   * @param  NumByteToWrite: number of bytes to write to the FLASH, must be equal
   *         or less than "sFLASH_PAGESIZE" value.
-  * @retval None
+  * @retval TRUE if the whole page was sent to the FLASH.
   */
-void sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWrite)
+bool sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWrite)
 {
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+  bool ret = TRUE;
+
+  if (NumByteToWrite == 0)
+  {
+    return TRUE;
+  }
+
+  if (sFLASH_Acquire() == FALSE)
+  {
+    return FALSE;
+  }
+
+  /*!< Enable the write access to the FLASH */
+  sFLASH_WriteEnable();
+
+  /*!< Send "Write to Memory " instruction and 24-bit address */
+  sFLASH_CS_LOW();
+  sFLASH_SendByte(sFLASH_CMD_WRITE);
+  sFLASH_SendByte((WriteAddr & 0xFF0000) >> 16);
+  sFLASH_SendByte((WriteAddr & 0xFF00) >> 8);
+  sFLASH_SendByte(WriteAddr & 0xFF);
+
+  if (NumByteToWrite >= sFLASH_DMA_MIN_LENGTH)
+  {
+    ret = SPI_DMA_writeBuffer(pBuffer, NumByteToWrite);
+  }
+  else
+  {
+    while (NumByteToWrite--)
+    {
+      sFLASH_SendByte(*pBuffer);
+      pBuffer++;
+    }
+  }
+
+  /*!< Deselect the FLASH: Chip Select high */
+  sFLASH_CS_HIGH();
+
+  /*the program runs on while the caller prepares the next page; the next access waits for it*/
+  sFLASH_SetPending( sFLASH_PROGRAM_POLL_TICKS );
+
+  SPI_mutex_unlock();
+
+  return ret;
+#else
 #if defined ( FREE_RTOS )  
     if (SPI_mutex_lock() == FALSE)
     {
-      return;
+      return FALSE;
     }
 #endif 	
 
@@ -184,6 +413,9 @@ void sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWr
 #if defined ( FREE_RTOS )  
 	SPI_mutex_unlock();
 #endif 
+
+	return TRUE;
+#endif
 }
 
 /**
@@ -193,21 +425,21 @@ void sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWr
   *         to the FLASH.
   * @param  WriteAddr: FLASH's internal address to write to.
   * @param  NumByteToWrite: number of bytes to write to the FLASH.
-  * @retval None
+  * @retval TRUE if every page was written; *pWriteAddr is only advanced then.
   */
-void sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByteToWrite)
+bool sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByteToWrite)
 {
     uint8_t NumOfPage = 0, NumOfSingle = 0, Addr = 0, count = 0, temp = 0;
     uint32_t WriteAddr = 0;
 
     if ( pBuffer == NULL )
-        return;
+        return FALSE;
 
     if ( pWriteAddr == NULL )
-        return;
+        return FALSE;
 
     if ( NumByteToWrite == 0 )
-        return;        
+        return TRUE;        
 
 
     WriteAddr = *pWriteAddr;
@@ -220,18 +452,21 @@ void sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByte
     {
         if (NumOfPage == 0) /*!< NumByteToWrite < sFLASH_PAGESIZE */
         {
-            sFLASH_WritePage(pBuffer, WriteAddr, NumByteToWrite);
+            if (sFLASH_WritePage(pBuffer, WriteAddr, NumByteToWrite) == FALSE)
+                return FALSE;
         }
         else /*!< NumByteToWrite > sFLASH_PAGESIZE */
         {
             while (NumOfPage--)
             {
-                sFLASH_WritePage(pBuffer, WriteAddr, sFLASH_SPI_PAGESIZE);
+                if (sFLASH_WritePage(pBuffer, WriteAddr, sFLASH_SPI_PAGESIZE) == FALSE)
+                    return FALSE;
                 WriteAddr +=  sFLASH_SPI_PAGESIZE;
                 pBuffer += sFLASH_SPI_PAGESIZE;
             }
 
-            sFLASH_WritePage(pBuffer, WriteAddr, NumOfSingle);
+            if (sFLASH_WritePage(pBuffer, WriteAddr, NumOfSingle) == FALSE)
+                return FALSE;
         }
     }
     else /*!< WriteAddr is not sFLASH_PAGESIZE aligned  */
@@ -242,15 +477,18 @@ void sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByte
             {
                 temp = NumOfSingle - count;
 
-                sFLASH_WritePage(pBuffer, WriteAddr, count);
+                if (sFLASH_WritePage(pBuffer, WriteAddr, count) == FALSE)
+                    return FALSE;
                 WriteAddr +=  count;
                 pBuffer += count;
 
-                sFLASH_WritePage(pBuffer, WriteAddr, temp);
+                if (sFLASH_WritePage(pBuffer, WriteAddr, temp) == FALSE)
+                    return FALSE;
             }
             else
             {
-                sFLASH_WritePage(pBuffer, WriteAddr, NumByteToWrite);
+                if (sFLASH_WritePage(pBuffer, WriteAddr, NumByteToWrite) == FALSE)
+                    return FALSE;
             }
         }
         else /*!< NumByteToWrite > sFLASH_PAGESIZE */
@@ -259,27 +497,30 @@ void sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByte
             NumOfPage =  NumByteToWrite / sFLASH_SPI_PAGESIZE;
             NumOfSingle = NumByteToWrite % sFLASH_SPI_PAGESIZE;
 
-            sFLASH_WritePage(pBuffer, WriteAddr, count);
+            if (sFLASH_WritePage(pBuffer, WriteAddr, count) == FALSE)
+                return FALSE;
             WriteAddr +=  count;
             pBuffer += count;
 
             while (NumOfPage--)
             {
-                sFLASH_WritePage(pBuffer, WriteAddr, sFLASH_SPI_PAGESIZE);
+                if (sFLASH_WritePage(pBuffer, WriteAddr, sFLASH_SPI_PAGESIZE) == FALSE)
+                    return FALSE;
                 WriteAddr +=  sFLASH_SPI_PAGESIZE;
                 pBuffer += sFLASH_SPI_PAGESIZE;
             }
 
             if (NumOfSingle != 0)
             {
-                sFLASH_WritePage(pBuffer, WriteAddr, NumOfSingle);
+                if (sFLASH_WritePage(pBuffer, WriteAddr, NumOfSingle) == FALSE)
+                    return FALSE;
             }
         }
     }
 
   *pWriteAddr = WriteAddr;
 
-  
+  return TRUE;
 }
 
 /**
@@ -287,14 +528,16 @@ void sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByte
   * @param  pBuffer: pointer to the buffer that receives the data read from the FLASH.
   * @param  ReadAddr: FLASH's internal address to read from.
   * @param  NumByteToRead: number of bytes to read from the FLASH.
-  * @retval None
+  * @retval TRUE if the whole block was read.
   */
-void sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRead)
+bool sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRead)
 {
+	bool ret = TRUE;
+
 #if defined ( FREE_RTOS )	
-	if (SPI_mutex_lock() == FALSE)
+	if (sFLASH_LOCK() == FALSE)
 	{
-		return;
+		return FALSE;
 	}
 #endif 	
 
@@ -312,6 +555,14 @@ void sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRe
 	/*!< Send ReadAddr low nibble address byte to read from */
 	sFLASH_SendByte(ReadAddr & 0xFF);
 
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+	if (NumByteToRead >= sFLASH_DMA_MIN_LENGTH)
+	{
+		ret = SPI_DMA_readBuffer(pBuffer, NumByteToRead);
+		NumByteToRead = 0;
+	}
+#endif
+
 	while (NumByteToRead--) /*!< while there is data to be read */
 	{
 		/*!< Read a byte from the FLASH */
@@ -327,8 +578,47 @@ void sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRe
 	SPI_mutex_unlock();
 #endif 
 
+	return ret;
 }
 
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+/**
+  * @brief  Same as sFLASH_ReadBuffer(), but the data phase is moved by SPI DMA
+  *         and the calling task sleeps until the transfer completes.
+  * @param  pBuffer: pointer to the buffer that receives the data read from the FLASH.
+  * @param  ReadAddr: FLASH's internal address to read from.
+  * @param  NumByteToRead: number of bytes to read from the FLASH.
+  * @retval TRUE if the whole block was read.
+  */
+bool sFLASH_ReadBuffer_DMA(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRead)
+{
+	bool ret;
+
+	if (sFLASH_LOCK() == FALSE)
+	{
+		return FALSE;
+	}
+
+	/*!< Select the FLASH: Chip Select low */
+	sFLASH_CS_LOW();
+
+	/*!< Send "Read from Memory " instruction and 24-bit address */
+	sFLASH_SendByte(sFLASH_CMD_READ);
+	sFLASH_SendByte((ReadAddr & 0xFF0000) >> 16);
+	sFLASH_SendByte((ReadAddr& 0xFF00) >> 8);
+	sFLASH_SendByte(ReadAddr & 0xFF);
+
+	ret = SPI_DMA_readBuffer(pBuffer, NumByteToRead);
+
+	/*!< Deselect the FLASH: Chip Select high */
+	sFLASH_CS_HIGH();
+
+	SPI_mutex_unlock();
+
+	return ret;
+}
+#endif 
+
 /**
   * @brief  Reads FLASH identification.
   * @param  None
@@ -339,7 +629,7 @@ uint32_t sFLASH_ReadID(void)
   uint32_t Temp = 0, Temp0 = 0, Temp1 = 0, Temp2 = 0;
 
 #if defined ( FREE_RTOS )
-  if (SPI_mutex_lock() == FALSE)
+  if (sFLASH_LOCK() == FALSE)
   {
     return 0;
   }
@@ -384,7 +674,7 @@ uint32_t sFLASH_ReadID(void)
 void sFLASH_StartReadSequence(uint32_t ReadAddr)
 {
 #if defined ( FREE_RTOS )
-    if (SPI_mutex_lock() == FALSE)
+    if (sFLASH_LOCK() == FALSE)
     {
       return ;
     }
@@ -470,19 +760,13 @@ uint16_t sFLASH_SendHalfWord(uint16_t HalfWord)
 
 /**
   * @brief  Enables the write access to the FLASH.
+  * @note   The caller holds the SPI mutex, which is not recursive.
   * @param  None
   * @retval None
   */
 void sFLASH_WriteEnable(void)
 {
-#if defined ( FREE_RTOS )	
   /*!< Select the FLASH: Chip Select low */
-  if (SPI_mutex_lock() == FALSE)
-  {
-    return ;
-  }
-#endif 
-
   sFLASH_CS_LOW();
 
   /*!< Send "Write Enable" instruction */
@@ -490,31 +774,28 @@ void sFLASH_WriteEnable(void)
 
   /*!< Deselect the FLASH: Chip Select high */
   sFLASH_CS_HIGH();
-
-#if defined ( FREE_RTOS )
-  SPI_mutex_unlock();
-#endif 
-
-
 }
 
 /**
   * @brief  Polls the status of the Write In Progress (WIP) flag in the FLASH's
   *         status register and loop until write opertaion has completed.
+  * @note   With configSPI_FLASH_DMA the task sleeps between polls and the SPI
+  *         mutex is taken here; otherwise the caller holds it.
   * @param  None
   * @retval None
   */
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
 void sFLASH_WaitForWriteEnd(void)
 {
-  uint8_t flashstatus = 0;
-
-#if defined ( FREE_RTOS )
-
-  if (SPI_mutex_lock() == FALSE)
+  if (sFLASH_Acquire() == TRUE)
   {
-    return ;
+    SPI_mutex_unlock();
   }
-#endif   
+}
+#else
+void sFLASH_WaitForWriteEnd(void)
+{
+  uint8_t flashstatus = 0;
 
   /*!< Select the FLASH: Chip Select low */
   sFLASH_CS_LOW();
@@ -534,11 +815,7 @@ void sFLASH_WaitForWriteEnd(void)
 
   /*!< Deselect the FLASH: Chip Select high */
   sFLASH_CS_HIGH();
-
-#if defined ( FREE_RTOS )
-  SPI_mutex_unlock();
-#endif 
-
 }
+#endif
 
 #endif /*EXT_FLASH*/
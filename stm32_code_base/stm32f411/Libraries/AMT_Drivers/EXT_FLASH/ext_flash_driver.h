@@ -4,16 +4,33 @@
 #include "Defs.h"
 #include "device_config.h"
 
+/*SPI flash layout shared by the application and the loader: the last 64KB block
+  holds the application's USB media index and is never programmed by the IAP*/
+#define sFLASH_SIZE               ((uint32_t)0x100000) /*1024 KBytes*/
+#define sFLASH_SECTOR_SIZE        ((uint32_t)0x10000)  /*sFLASH_EraseSector granularity*/
+#define sFLASH_USB_INDEX_SIZE     ((uint32_t)0x10000)
+#define sFLASH_USB_INDEX_ADDR     ( sFLASH_SIZE - sFLASH_USB_INDEX_SIZE )
+
 #if ( configSPI_FLASH == 1 )
 void sFLASH_EraseSector(uint32_t SectorAddr);
 
 void sFLASH_EraseChip(void);
 
-void sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWrite);
+bool sFLASH_WritePage(uint8_t* pBuffer, uint32_t WriteAddr, uint16_t NumByteToWrite);
+
+bool sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByteToWrite);
+
+bool sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRead);
+
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+bool sFLASH_ReadBuffer_DMA(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRead);
+#endif
 
-void sFLASH_WriteBuffer(uint8_t* pBuffer, uint32_t *pWriteAddr, uint16_t NumByteToWrite);
+#if ( configSPI_FLASH_DMA == 1 ) && defined ( FREE_RTOS )
+bool sFLASH_EraseSector_Async(uint32_t SectorAddr);
 
-void sFLASH_ReadBuffer(uint8_t* pBuffer, uint32_t ReadAddr, uint16_t NumByteToRead);
+bool sFLASH_IsBusy(void);
+#endif
 
 void sFLASH_StartReadSequence(uint32_t ReadAddr);
 
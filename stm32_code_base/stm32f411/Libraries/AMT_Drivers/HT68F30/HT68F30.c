@@ -188,6 +188,31 @@ static uint8 nScanCount;
 static uint8 nStepsCount;      
 
 static bool LightBar_DemoTimeOut = FALSE;    //Angus added , for auto setting timeout led after diaplay another led behavior.(2014/11/5)
+
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+#define LIGHT_BAR_REG_NUM         0x0E /* duty registers 0x01~0x0E */
+#define LIGHT_BAR_FRAME_TIME      50   /* msec */
+#define LIGHT_BAR_DUTY_INVALID    0xFF /* above LIGHT_BAR_DUTY_MAX, forces a write */
+
+/* Breath ramp, one step per frame, played up and down */
+const static uint8 mLightBar_BreathDuty[] = 
+{
+    LIGHT_BAR_DUTY(10), LIGHT_BAR_DUTY(15), LIGHT_BAR_DUTY(20), LIGHT_BAR_DUTY(25), 
+    LIGHT_BAR_DUTY(30), LIGHT_BAR_DUTY(35), LIGHT_BAR_DUTY(40), LIGHT_BAR_DUTY(45), 
+    LIGHT_BAR_DUTY(50), LIGHT_BAR_DUTY(55), LIGHT_BAR_DUTY(60), LIGHT_BAR_DUTY(65), 
+    LIGHT_BAR_DUTY(70), LIGHT_BAR_DUTY(75), LIGHT_BAR_DUTY(80), LIGHT_BAR_DUTY(85), 
+    LIGHT_BAR_DUTY(90), LIGHT_BAR_DUTY(95), LIGHT_BAR_DUTY(100)
+};
+
+#define BREATH_STEP_NUM           (sizeof(mLightBar_BreathDuty)/sizeof(uint8))
+#define BREATH_PERIOD             (2*(BREATH_STEP_NUM-1))
+
+static uint8 nBreathStep;
+
+/* Frame built by the task and the duty the HT68F30 holds, indexed by register - 1 */
+static uint8 mLightBarFrame[LIGHT_BAR_REG_NUM];
+static uint8 mLightBarShadow[LIGHT_BAR_REG_NUM];
+#endif
 //______________________________________________________________________________
 
 void HT68F30_setStatus(const void *parms)
@@ -201,8 +226,12 @@ void HT68F30_setStatus(const void *parms)
 void HT68F30_LightBarControl( uint8 position, uint8 duty )
 {
     mLightBarParams[position].duty = duty;
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+    /* Written with the next frame */
+#else
     HT68F30_WriteI2C_Byte( mLightBarParams[position].light_addr, 
                            mLightBarParams[position].duty );
+#endif
 }
 
 void HT68F30_CleanALL(uint8 StartPos, uint8 EndPos,uint16 Holdtime, bool background)
@@ -619,11 +648,75 @@ bool HT68F30_IsControllingLED(void)
     return TRUE;
 }
 
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+/* Writes the registers whose duty differs from what the HT68F30 holds. A failed
+ * write keeps the old shadow so the register is tried again next frame. */
+static void HT68F30_LightBar_FlushFrame( void )
+{
+    uint8 reg;
+#if ( configHT68F30_I2C_BURST == 1 )
+    uint8 first = LIGHT_BAR_REG_NUM;
+    uint8 last = 0;
+
+    /* One write from the first to the last dirty register, the clean ones in
+     * between cost a byte each, far less than another transfer */
+    for (reg = 0; reg < LIGHT_BAR_REG_NUM; reg++)
+    {
+        if (mLightBarFrame[reg] != mLightBarShadow[reg])
+        {
+            if (first == LIGHT_BAR_REG_NUM)
+            {
+                first = reg;
+            }
+            last = reg;
+        }
+    }
+
+    if (first == LIGHT_BAR_REG_NUM)
+    {
+        return;
+    }
+
+    if (HT68F30_WriteI2C_Buffer( first + 1, &mLightBarFrame[first], last - first + 1 ) == TRUE)
+    {
+        for (reg = first; reg <= last; reg++)
+        {
+            mLightBarShadow[reg] = mLightBarFrame[reg];
+        }
+    }
+#else
+    for (reg = 0; reg < LIGHT_BAR_REG_NUM; reg++)
+    {
+        if (mLightBarFrame[reg] != mLightBarShadow[reg])
+        {
+            if (HT68F30_WriteI2C_Byte( reg + 1, mLightBarFrame[reg] ) == TRUE)
+            {
+                mLightBarShadow[reg] = mLightBarFrame[reg];
+            }
+        }
+    }
+#endif
+}
+#endif
+
 void HT68F30_LightBar_task( void *pvParameters )
 {
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+    portTickType xLastWakeTime;
+    uint8 reg;
+
+    for (reg = 0; reg < LIGHT_BAR_REG_NUM; reg++)
+    {
+        mLightBarShadow[reg] = LIGHT_BAR_DUTY_INVALID;
+    }
+    xLastWakeTime = xTaskGetTickCount();
+#endif
+
     for(;;)
     {
+#if ( configHT68F30_FRAME_FLUSH == 0 )
         static bool bBreatheVector = TRUE;/* conunt down */
+#endif
         static bool bScanningVector = TRUE;/* left to right */
         static bool bStepsVector = TRUE;/* left to right */    
         uint8 i;
@@ -634,6 +727,10 @@ void HT68F30_LightBar_task( void *pvParameters )
             if (i == 0) 
             {
                 /* Breath */
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+                nBreathStep = (nBreathStep + 1) % BREATH_PERIOD;
+                nDuty = mLightBar_BreathDuty[(nBreathStep < BREATH_STEP_NUM) ? nBreathStep : (BREATH_PERIOD - nBreathStep)];
+#else
                 if (bBreatheVector == FALSE)
                 {
                     nDuty = nDuty - 5;
@@ -650,6 +747,7 @@ void HT68F30_LightBar_task( void *pvParameters )
                         bBreatheVector = FALSE;
                     }
                 }
+#endif
 
                 /* Scaning*/
                 if (bScanningVector == FALSE) /*right to left*/
@@ -806,7 +904,11 @@ void HT68F30_LightBar_task( void *pvParameters )
                     
                 case HT68F30_BREATH:
                 {
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+                    mLightBarParams[i].duty = nDuty;
+#else
                     mLightBarParams[i].duty = LIGHT_BAR_DUTY(nDuty);
+#endif
                     mLightBarParams[i].changed= TRUE;
                 }
                     break;
@@ -883,14 +985,31 @@ void HT68F30_LightBar_task( void *pvParameters )
                     break;
             }
             
+#if ( configHT68F30_FRAME_FLUSH == 0 )
             if (mLightBarParams[i].changed == TRUE)
             {         
                 mLightBarParams[i].changed = FALSE;
                 HT68F30_WriteI2C_Byte( mLightBarParams[i].light_addr, 
                                        mLightBarParams[i].duty );
             }
+#endif
         }
+
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+        /* Effects may still touch the power light after its turn, so the
+         * frame is taken once every position is done */
+        for(i=0 ; i <= MAX_LED_LEVEL_INDEX; i++)
+        {
+            mLightBarFrame[mLightBarParams[i].light_addr - 1] = mLightBarParams[i].duty;
+            mLightBarParams[i].changed = FALSE;
+        }
+        HT68F30_LightBar_FlushFrame();
+
+        /* Fixed frame rate, the I2C time is part of the period */
+        vTaskDelayUntil( &xLastWakeTime, TASK_MSEC2TICKS(LIGHT_BAR_FRAME_TIME) );
+#else
         vTaskDelay(TASK_MSEC2TICKS(50)); 
+#endif
     }
 }
 
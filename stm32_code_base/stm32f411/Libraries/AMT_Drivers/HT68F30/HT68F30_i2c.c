@@ -40,3 +40,32 @@ bool HT68F30_WriteI2C_Byte(byte RegAddr,byte uc)
 
     return TRUE;
 }
+
+#if ( configHT68F30_I2C_BURST == 1 )
+bool HT68F30_WriteI2C_Buffer(byte RegAddr, const byte *data, uint8 length)
+{
+    bool  ret;
+    int i;
+    
+    if (App_I2C1_sema_mutex_take() != TRUE)
+    {
+        return FALSE;
+    }
+    
+    for( i = 0; i < HT68_RETRY_TIME; i++ )
+    {
+        ret=I2C_writeSlave(HT68F30_I2C_ADDR ,RegAddr ,(byte*)data,length,FALSE,FALSE);
+
+        vTaskDelay( TASK_MSEC2TICKS(HT68F30_I2C_INTERVAL_TIME) );
+
+        if ( ret == TRUE )
+        {
+            break;
+        }   
+    }
+
+    App_I2C1_sema_mutex_give();
+
+    return ret;
+}
+#endif
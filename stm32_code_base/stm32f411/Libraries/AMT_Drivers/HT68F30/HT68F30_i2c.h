@@ -3,9 +3,15 @@
 
 #include "Defs.h"
 #include "I2C1LowLevel.h"
+#include "device_config.h"
 
 
 bool HT68F30_WriteI2C_Byte(byte RegAddr, byte uc);
 
+#if ( configHT68F30_I2C_BURST == 1 )
+/*Writes length duty registers starting at RegAddr in one transfer*/
+bool HT68F30_WriteI2C_Buffer(byte RegAddr, const byte *data, uint8 length);
+#endif
+
 
 #endif /*__HT68F30_I2C_H__*/
@@ -166,8 +166,43 @@ void TAS5713_shutdown(bool Address,bool value )
     }
 }
 
+#if ( configI2C2_SCRIPT == 1 )
+static const I2C2_SCRIPT_ENTRY m_InitScript_C[] = 
+{
+    I2C2_SCRIPT_DELAY(50),
+
+    /*3. Trim oscillator (write 0x00 to register 0x1B) and wait at least 50 ms.*/
+    I2C2_SCRIPT_WRITE(OSC_TRIM_REG, 0x00),
+    I2C2_SCRIPT_DELAY(50),
+    I2C2_SCRIPT_WRITE_N(PWM_MUX_REG, m_PwmMux2),
+    I2C2_SCRIPT_WRITE(PWM_SHUTDOWN_REG, 0x3A),
+
+    I2C2_SCRIPT_WRITE(CHANNEL_1_VOL_REG, 0x30),
+    I2C2_SCRIPT_WRITE(CHANNEL_2_VOL_REG, 0x30),
+    I2C2_SCRIPT_WRITE(CHANNEL_3_VOL_REG, 0x30),
+    I2C2_SCRIPT_WRITE(MASTER_VOL_REG, 0xff),
+
+    I2C2_SCRIPT_WRITE(INPUT_MUX_REG, 0x88),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_1_REG, 0xB8),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_2_REG, 0x60),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_3_REG, 0xA0),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_4_REG, 0x48),
+    /*Exit shutdown*/
+    I2C2_SCRIPT_WRITE(SYS_CONTROL_2_REG, 0x02),
+    I2C2_SCRIPT_DELAY(165),
+    //DRC
+    I2C2_SCRIPT_WRITE_N(DRC_CTRL_REG, m_Drc_ctrl),
+    I2C2_SCRIPT_WRITE_N(DRC_1_ATT_REL_THRESHOLD_REG, m_Drc1_att_rel_threshold_C),
+    I2C2_SCRIPT_WRITE_N(DRC_1_SOFTENING_FILTER_AE_OM_REG, m_Drc1_sofrening_filter_ae_om_C),
+    I2C2_SCRIPT_WRITE_N(DRC_1_ATT_REL_RATE_REG, m_Drc1_att_rel_rate_C)
+};
+#endif
+
 static void TAS5713_initialization_C( bool Address )
 {
+#if ( configI2C2_SCRIPT == 1 )
+    TAS5713_I2C_write_script(Address, m_InitScript_C, I2C2_SCRIPT_LENGTH(m_InitScript_C));
+#else
     //TAS5713_I2C_address(value);    /*Smith Mark*/
     vTaskDelay(TASK_MSEC2TICKS(50));
     
@@ -194,7 +229,7 @@ static void TAS5713_initialization_C( bool Address )
     TAS5713_I2C_write_n_byte(Address, DRC_1_ATT_REL_THRESHOLD_REG, m_Drc1_att_rel_threshold_C,8);
     TAS5713_I2C_write_n_byte(Address, DRC_1_SOFTENING_FILTER_AE_OM_REG, m_Drc1_sofrening_filter_ae_om_C,8);
     TAS5713_I2C_write_n_byte(Address, DRC_1_ATT_REL_RATE_REG, m_Drc1_att_rel_rate_C,8);
-
+#endif
 }
 
 #endif 
@@ -12,4 +12,8 @@ bool TAS5713_I2C_read_n_byte(bool Address,byte reg_addr, byte *data, int N);
 
 bool TAS5713_I2C_write_n_byte(bool Address,byte reg_addr, byte* data,int N);
 
+#if ( configI2C2_SCRIPT == 1 )
+bool TAS5713_I2C_write_script(bool Address, const I2C2_SCRIPT_ENTRY *script, uint16 count);
+#endif
+
 #endif /*__TAS5713_I2C_H__*/
@@ -200,8 +200,46 @@ void TAS5727_shutdown(bool Address,bool value )
     }
 }
 
+#if ( configI2C2_SCRIPT == 1 )
+static const I2C2_SCRIPT_ENTRY m_InitScript_LR[] = 
+{
+    /*3. Trim oscillator (write 0x00 to register 0x1B) and wait at least 50 ms.*/
+    I2C2_SCRIPT_WRITE(OSC_TRIM_REG, 0x00),
+    I2C2_SCRIPT_DELAY(50),
+
+    //Input Mux Register(BD mode,opt.)
+    I2C2_SCRIPT_WRITE_N(PWM_MUX_REG, m_PwmMux_Data),
+
+    I2C2_SCRIPT_WRITE_N(MASTER_VOL_REG, m_Master_Vol_mute),
+    I2C2_SCRIPT_WRITE_N(CHANNEL_1_VOL_REG, m_CHANNEL_1_VOL_REG), //0dB
+    I2C2_SCRIPT_WRITE_N(CHANNEL_2_VOL_REG, m_CHANNEL_2_VOL_REG), //0dB
+    I2C2_SCRIPT_WRITE_N(CHANNEL_3_VOL_REG, m_CHANNEL_3_VOL_REG), //0dB
+
+    I2C2_SCRIPT_WRITE(SOFT_MUTE_REG, 0x07),
+    I2C2_SCRIPT_WRITE(SYS_CONTROL_1_REG, 0x80),
+    I2C2_SCRIPT_WRITE(SERIAL_DATA_REG, 0x05),
+    I2C2_SCRIPT_WRITE(SYS_CONTROL_2_REG, TAS5727_ENTERSHUTDOWN),
+
+    I2C2_SCRIPT_WRITE(VOL_CONFIG_REG, 0x91),
+    I2C2_SCRIPT_WRITE(MODULATION_LIMIT_REG, 0x02),
+    I2C2_SCRIPT_WRITE(START_STOP_PERIOD_REG, 0x0a),
+    I2C2_SCRIPT_WRITE(BKND_ERR_REG, 0x02),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_1_REG, TAS5727_ICD1),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_2_REG, TAS5727_ICD2),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_3_REG, TAS5727_ICD3),
+    I2C2_SCRIPT_WRITE(IC_DEALY_CH_4_REG, TAS5727_ICD4),
+    I2C2_SCRIPT_WRITE_N(INPUT_MUX_REG, m_inputMux_Data),
+
+    I2C2_SCRIPT_WRITE(SYS_CONTROL_2_REG, TAS5727_EXITSHUTDOWN), /*Exit all-channel shutdown (hard mute)*/
+    I2C2_SCRIPT_DELAY(165)
+};
+#endif
+
 static void TAS5727_initialization_LR( bool Address )
 {
+#if ( configI2C2_SCRIPT == 1 )
+    TAS5727_I2C_write_script(Address, m_InitScript_LR, I2C2_SCRIPT_LENGTH(m_InitScript_LR));
+#else
     /*3. Trim oscillator (write 0x00 to register 0x1B) and wait at least 50 ms.*/
     TAS5727_I2C_write(Address,OSC_TRIM_REG, 0x00);
     vTaskDelay(TASK_MSEC2TICKS(50));
@@ -231,7 +269,7 @@ static void TAS5727_initialization_LR( bool Address )
     TAS5727_I2C_write_n_byte(Address,INPUT_MUX_REG,m_inputMux_Data,4); 
     
     TAS5727_shutdown(Address,TAS5727_EXIT_SHUTDOWN);
-
+#endif
 }
 
 #endif 
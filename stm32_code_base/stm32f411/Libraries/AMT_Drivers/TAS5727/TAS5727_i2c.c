@@ -142,3 +142,28 @@ bool TAS5727_I2C_write_n_byte(bool Address,byte reg_addr, byte* data,int N)
 
     return TRUE;
 }
+
+#if ( configI2C2_SCRIPT == 1 )
+bool TAS5727_I2C_write_script(bool Address, const I2C2_SCRIPT_ENTRY *script, uint16 count)
+{
+    bool ret;
+
+    /*retries per transaction are done by the script engine*/
+    if(Address)
+    {
+        ret = I2C2_runScript(TAS5727_HIGH_DEVICE_ADDR, script, count);
+    }
+    else
+    {
+        ret = I2C2_runScript(TAS5727_LOW_DEVICE_ADDR, script, count);
+    }
+
+    if ( ret == FALSE )
+    {
+        TRACE_ERROR((0, " TAS5727 I2C script error !! "));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
@@ -297,6 +297,8 @@ static CS4953xLoadAudioStreamType cs4953x_GetAudioStreamType( void );
 static uint8 cs4953x_GetLoadrState( void );
 
 #if ( configAPP_SPI_FLASH_DSP_ULD == 1 )
+static int8 cs495x_LoadDSP_ULD_Block( unsigned int Addr, unsigned int length );
+
 static int cs495x_LoadDSP_ULD(unsigned char* buf,CS4953xLoadAudioStreamType Stype ,cs495x_ULD_Type Utype );
 #endif 
 
@@ -1844,6 +1846,17 @@ static unsigned int cs495x_Get_DSP_ULD_Length(CS4953xLoadAudioStreamType Stype ,
 #endif 
 
 #if ( configAPP_SPI_FLASH_DSP_ULD == 1 )
+static int8 cs495x_LoadDSP_ULD_Block( unsigned int Addr, unsigned int length )
+{
+    if ( sFLASH_ReadBuffer(ULDLoaderbuf, Addr, length) == FALSE )
+    {
+        return SCP1_BSY_TIMEOUT;
+    }
+    vTaskDelay(TASK_MSEC2TICKS(1));
+
+    return CS4953xSPI_write_ULD_buffer(ULDLoaderbuf, length);
+}
+
 static int cs495x_LoadDSP_ULD(unsigned char* buf,CS4953xLoadAudioStreamType Stype ,cs495x_ULD_Type Utype )
 {
     int i;
@@ -1861,10 +1874,7 @@ static int cs495x_LoadDSP_ULD(unsigned char* buf,CS4953xLoadAudioStreamType Styp
 
     if( NumOfDSPLoad == 0 )
     {
-        sFLASH_ReadBuffer(ULDLoaderbuf, Addr, NumOfSingle);
-        vTaskDelay(TASK_MSEC2TICKS(1));
-
-        dsp_spi_ret = CS4953xSPI_write_ULD_buffer(ULDLoaderbuf, NumOfSingle);
+        dsp_spi_ret = cs495x_LoadDSP_ULD_Block(Addr, NumOfSingle);
         if( dsp_spi_ret != SCP1_PASS )
         {
             TRACE_DEBUG((0, "Step 1. Write DSP ULD have ERROR !!!\n"));
@@ -1875,10 +1885,7 @@ static int cs495x_LoadDSP_ULD(unsigned char* buf,CS4953xLoadAudioStreamType Styp
     {
         for( i=0; i < NumOfDSPLoad; i++)
         {
-            sFLASH_ReadBuffer(ULDLoaderbuf, Addr, DSPLoadSize);
-            vTaskDelay(TASK_MSEC2TICKS(1));
-
-            dsp_spi_ret = CS4953xSPI_write_ULD_buffer(ULDLoaderbuf, DSPLoadSize);
+            dsp_spi_ret = cs495x_LoadDSP_ULD_Block(Addr, DSPLoadSize);
             if ( dsp_spi_ret != SCP1_PASS )
             {
                 TRACE_DEBUG((0, "Step 2. Write DSP ULD have ERROR !!!\n"));
@@ -1891,10 +1898,7 @@ static int cs495x_LoadDSP_ULD(unsigned char* buf,CS4953xLoadAudioStreamType Styp
 
         if (ret_val != 0)
         {
-            sFLASH_ReadBuffer(ULDLoaderbuf, Addr, NumOfSingle);
-            vTaskDelay(TASK_MSEC2TICKS(1));
-
-            dsp_spi_ret = CS4953xSPI_write_ULD_buffer(ULDLoaderbuf, NumOfSingle);
+            dsp_spi_ret = cs495x_LoadDSP_ULD_Block(Addr, NumOfSingle);
             if ( dsp_spi_ret != SCP1_PASS )
             {
                 TRACE_DEBUG((0, "Step 3. Write DSP ULD have ERROR !!!\n"));
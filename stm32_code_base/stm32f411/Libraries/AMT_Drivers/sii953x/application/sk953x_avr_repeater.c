@@ -17,6 +17,7 @@
 #include "si_debugger_hdmigear.h"
 #include "si_eeprom.h"
 #include "si_gpio.h"
+#include "si_drv_device.h"
 #if INC_RTPI
 #include "si_rtpi_component.h"
 #endif
@@ -39,6 +40,12 @@
 //------------------------------------------------------------------------------
 #define HDMI_REPEATER_TIME_TICK TASK_MSEC2TICKS(50) /*Smith todo: it could be 100 msec*/
 #define HDMI_RST_TIME_TICK TASK_MSEC2TICKS(5000)
+
+#if ( configSII953x_INT_WAKEUP == 1 )
+#define HDMI_REPEATER_PENDING_TICK TASK_MSEC2TICKS(2) /*INT line still low after a pass, doubles up to the heartbeat*/
+#define HDMI_REPEATER_HEARTBEAT_TICK TASK_MSEC2TICKS(100) /*driver/CEC timers while powered on*/
+#define HDMI_REPEATER_STANDBY_TICK TASK_MSEC2TICKS(500)
+#endif
 //------------------------------------------------------------------------------
 
 typedef struct HDMI_MANAGER_VOL_PARAMETERS 
@@ -49,6 +56,11 @@ typedef struct HDMI_MANAGER_VOL_PARAMETERS
 	TaskHandleState ServiceState;
 	xQueueParameters QParams;
     xOS_TaskErrIndicator xOS_ErrId;
+#if ( configSII953x_INT_WAKEUP == 1 )
+    xSemaphoreHandle repeater_wakeup_sema;
+    portTickType repeater_pending_tick;     /*next retry while the INT line stays low*/
+    bool repeater_repoll;                   /*this pass only retries a low INT line*/
+#endif
 } xOS_HDMI_Params;
 
 
@@ -260,6 +272,79 @@ int main(void)
 }
 #endif /*( configSII_DEV_953x_PORTING == 0 )*/ 
 
+#if ( configSII953x_INT_WAKEUP == 1 )
+static void HdmiDeviceManager_RepeaterWakeup( void )
+{
+    if ( xOS_HDMI_Parms.repeater_wakeup_sema != NULL )
+    {
+        xSemaphoreGive( xOS_HDMI_Parms.repeater_wakeup_sema );
+    }
+}
+
+/*Called from the SiI953x INT EXTI handler*/
+void HdmiDeviceManager_RepeaterWakeupFromISR( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    if ( xOS_HDMI_Parms.repeater_wakeup_sema != NULL )
+    {
+        xSemaphoreGiveFromISR( xOS_HDMI_Parms.repeater_wakeup_sema, &xHigherPriorityTaskWoken );
+    }
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+static portTickType HdmiManager_RepeaterHeartbeat( void )
+{
+    switch( app.powerState )
+    {
+        case APP_POWERSTATUS_ON:
+            return HDMI_REPEATER_HEARTBEAT_TICK;
+
+        case APP_POWERSTATUS_STANDBY:
+            return HDMI_REPEATER_STANDBY_TICK;
+
+        default:
+            return HDMI_REPEATER_TIME_TICK;
+    }
+}
+
+/*How long the repeater may sleep when no INT edge or command arrives*/
+static portTickType HdmiManager_RepeaterBlockTime( void )
+{
+    portTickType heartbeat = HdmiManager_RepeaterHeartbeat( );
+    portTickType block;
+
+    if ( SiiPlatformInterruptStateGet() == false )
+    {
+        xOS_HDMI_Parms.repeater_pending_tick = HDMI_REPEATER_PENDING_TICK;
+        return heartbeat;
+    }
+
+    /*the INT line did not go high again, no new edge will come*/
+    block = xOS_HDMI_Parms.repeater_pending_tick;
+    if ( block >= heartbeat )
+    {
+        return heartbeat;
+    }
+
+    xOS_HDMI_Parms.repeater_pending_tick = block*2;
+    if ( xOS_HDMI_Parms.repeater_pending_tick >= heartbeat )
+    {
+        TRACE_ERROR((0, "HDMI INT line stuck low, groups 0x%X", SiiDrvDeviceInterruptGroups() ));
+    }
+
+    return block;
+}
+
+/*A retry of a low INT line skips the passes whose interrupt group is clear*/
+static bool HdmiManager_RepeaterPass( uint8 group )
+{
+    if ( xOS_HDMI_Parms.repeater_repoll == FALSE )
+        return TRUE;
+
+    return ( ( SiiDrvDeviceInterruptGroups() & group ) != 0 );
+}
+#endif
 
 static void sii953x_repeater_task( void )
 {
@@ -292,6 +377,9 @@ static void sii953x_repeater_task( void )
     SkAppTaskSiiDevice();
 
 #if INC_CEC
+#if ( configSII953x_INT_WAKEUP == 1 )
+    if ( HdmiManager_RepeaterPass( SiiDEV_INT_GROUP_CEC ) == TRUE )
+#endif
     SkAppTaskCec();
 #endif
 
@@ -310,11 +398,17 @@ static void sii953x_repeater_task( void )
 		//---------------------------------------------------------------------
 #if ( configSII_DEV_953x_PORTING_CBUS == 1 )	 
 #if INC_CBUS
+#if ( configSII953x_INT_WAKEUP == 1 )
+		if ( HdmiManager_RepeaterPass( SiiDEV_INT_GROUP_CBUS ) == TRUE )
+#endif
 		SkAppTaskCbus();
 #endif
 #endif
         SkAppTaskSwitch();
         SkAppTaskRepeater();
+#if ( configSII953x_INT_WAKEUP == 1 )
+        if ( HdmiManager_RepeaterPass( SiiDEV_INT_GROUP_TX0 ) == TRUE )
+#endif
         SkAppTaskTx();
         
 #if INC_IPV
@@ -424,6 +518,14 @@ static void HdmiDeviceManager_handleCommand( xHMISystemParams params  )
             case SYS_EVENT_SAC_SYSTEM_UP:
             case SYS_EVENT_ARC_SYSTEM_UP:
 		{
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+			/*runs beside the audio device init, only the rails have to be settled*/
+			if ( pPowerHandle_ObjCtrl->boot_wait( POWER_BOOT_HDMI ) == FALSE )
+			{
+				TRACE_ERROR((0, "HDMI power up skipped, the rails were not switched on"));
+				break;
+			}
+#endif
 			if ( params.input_src == AUDIO_SOURCE_HDMI_ARC )
 			{
                                 HdmiManager_DeviceEnable( TRUE );
@@ -454,6 +556,9 @@ static void HdmiDeviceManager_handleCommand( xHMISystemParams params  )
                         AmTArcTaskAssign(ARC_TASK_TERM_PRIVATELY);	//terminate ARC but keep flag enable
 #endif								
 			}*/
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+			pPowerHandle_ObjCtrl->boot_done( POWER_BOOT_HDMI );
+#endif
                 }
 			break;
 
@@ -609,7 +714,25 @@ static void HdmiManager_RepeaterTask( void *pvParameters )
 
 		}
 		
+#if ( configSII953x_INT_WAKEUP == 1 )
+        xOS_HDMI_Parms.repeater_repoll = FALSE;
+        if ( xOS_HDMI_Parms.hdmi_avr_repeater_state == TASK_RUNING )
+        {
+            portTickType block = HdmiManager_RepeaterBlockTime();
+
+            if ( ( xSemaphoreTake( xOS_HDMI_Parms.repeater_wakeup_sema, block ) != pdTRUE )
+                && ( block < HdmiManager_RepeaterHeartbeat() ) )
+            {
+                xOS_HDMI_Parms.repeater_repoll = TRUE;
+            }
+        }
+        else
+        {
+            vTaskDelay( HDMI_REPEATER_TIME_TICK );
+        }
+#else
         vTaskDelay( HDMI_REPEATER_TIME_TICK );
+#endif
     }
 }
 
@@ -618,6 +741,21 @@ static void HdmiDeviceManager_ServiceHandle( void *pvParameters )
 {
 	xHMISystemParams systemParams;
 	
+#if ( configSII953x_INT_WAKEUP == 1 )
+	for( ;; )
+	{
+		/*commands are only taken once the repeater runs*/
+		if ( xOS_HDMI_Parms.hdmi_avr_repeater_state != TASK_RUNING )
+		{
+			vTaskDelay( HDMI_REPEATER_TIME_TICK );
+		}
+		else if ( xQueueReceive( xOS_HDMI_Parms.QParams.xQueue, &systemParams, portMAX_DELAY ) == pdPASS )
+		{
+			HdmiDeviceManager_handleCommand( systemParams );
+			HdmiDeviceManager_RepeaterWakeup( );
+		}
+	}
+#else
 	for( ;; )
 	{
 		switch( xOS_HDMI_Parms.ServiceState )
@@ -661,6 +799,7 @@ static void HdmiDeviceManager_ServiceHandle( void *pvParameters )
 
 		vTaskDelay( TASK_MSEC2TICKS(1) );
 	}
+#endif
 
 }
 
@@ -672,6 +811,20 @@ static void HdmiDeviceManager_CreateTask( void )
 	{
 	}
 
+#if ( configSII953x_INT_WAKEUP == 1 )
+    xOS_HDMI_Parms.repeater_pending_tick = HDMI_REPEATER_PENDING_TICK;
+    xOS_HDMI_Parms.repeater_repoll = FALSE;
+    vSemaphoreCreateBinary( xOS_HDMI_Parms.repeater_wakeup_sema );
+    if ( xOS_HDMI_Parms.repeater_wakeup_sema == NULL )
+    {
+        TRACE_ERROR((0, "HDMI repeater wakeup semaphore creates failure " ));
+    }
+    else
+    {
+        xSemaphoreTake( xOS_HDMI_Parms.repeater_wakeup_sema, 0 );
+    }
+#endif
+
     if ( xTaskCreate( HdmiManager_RepeaterTask, 
             ( portCHAR * ) "SII9535_ENTRY", 
             (STACK_SIZE*2), NULL, tskSII9535_PRIORITY,&xOS_HDMI_Parms.hdmi_avr_repeater_task_handle) != pdPASS )
@@ -792,6 +945,9 @@ void AmTArcAppTaskAssign( AmTArcTaskEvent event)
 			break;
 	}
     //TRACE_DEBUG((0, "SYS_CEC_ARC_APP_TASK %d", SYS_CEC_ARC_APP_TASK ));
+#if ( configSII953x_INT_WAKEUP == 1 )
+    HdmiDeviceManager_RepeaterWakeup( );
+#endif
 }
 
 
@@ -831,5 +987,8 @@ void AmTSacAppTaskAssign(AmTSacTaskEvent sac_event)
 		        break;
 		}
         }
+#if ( configSII953x_INT_WAKEUP == 1 )
+        HdmiDeviceManager_RepeaterWakeup( );
+#endif
 }
 
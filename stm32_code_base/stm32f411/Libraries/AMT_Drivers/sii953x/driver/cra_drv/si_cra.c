@@ -36,6 +36,23 @@ extern pageConfig_t g_addrDescriptor[SII_CRA_MAX_DEVICE_INSTANCES][SII_CRA_DEVIC
 extern SiiReg_t     g_siiRegPageBaseReassign [];
 extern SiiReg_t     g_siiRegPageBaseRegs[SII_CRA_DEVICE_PAGE_COUNT];
 
+#if ( configSII_DEV_953x_PORTING == 1 ) && ( configSII_CRA_CACHE == 1 )
+// Shadow copy of one cacheable register, tagged with the physical I2C device
+// and offset so that a write through an aliased page drops it as well.
+typedef struct _CraCacheEntry_t
+{
+    uint8_t     deviceId;
+    uint8_t     regOffset;
+    uint8_t     value;
+    bool_t      valid;
+} CraCacheEntry_t;
+
+extern SiiReg_t     g_siiRegCacheable [];
+extern SiiReg_t     g_siiRegCacheFlush [];
+
+static CraCacheEntry_t l_craCache[SII_CRA_MAX_DEVICE_INSTANCES][SII_CRA_CACHE_SIZE];
+#endif
+
 CraInstanceData_t craInstance =
 {
     0,                          // structVersion
@@ -193,6 +210,105 @@ static SiiResultCodes_t CraWriteBlockI2c ( prefuint_t busIndex, uint8_t deviceId
 }
 
 #if ( configSII_DEV_953x_PORTING == 1 )
+#if ( configSII_CRA_CACHE == 1 )
+//-------------------------------------------------------------------------------------------------
+//! @brief      Resolve a virtual register address to the I2C device and register offset.
+//! @return     false if the page is not on the main I2C bus.
+//-------------------------------------------------------------------------------------------------
+static bool_t CraPhysicalAddr ( SiiReg_t virtualAddr, uint8_t *pDeviceId, uint8_t *pRegOffset )
+{
+    prefuint_t          page = virtualAddr >> 8;
+    pageConfig_t        *pPage = &g_addrDescriptor[ l_pageInstance[ page]][ page];
+
+    switch ( pPage->busType )
+    {
+        case DEV_I2C_0:
+            *pDeviceId  = (uint8_t)pPage->address;
+            *pRegOffset = (uint8_t)virtualAddr;
+            return( true );
+        case DEV_I2C_OFFSET:
+            *pDeviceId  = (uint8_t)pPage->address;
+            *pRegOffset = (uint8_t)virtualAddr + (uint8_t)(pPage->address >> 8);
+            return( true );
+        default:
+            break;
+    }
+
+    return( false );
+}
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      Shadow entry of a register listed in g_siiRegCacheable, for the current page instance.
+//! @return     NULL if the register is volatile.
+//-------------------------------------------------------------------------------------------------
+static CraCacheEntry_t *CraCacheEntry ( SiiReg_t virtualAddr )
+{
+    prefuint_t i;
+
+    for ( i = 0; ( i < SII_CRA_CACHE_SIZE ) && ( g_siiRegCacheable[ i] != 0xFFFF ); i++ )
+    {
+        if ( g_siiRegCacheable[ i] == virtualAddr )
+        {
+            return( &l_craCache[ l_pageInstance[ virtualAddr >> 8]][ i] );
+        }
+    }
+
+    return( NULL );
+}
+
+static void CraCacheFill ( CraCacheEntry_t *pEntry, SiiReg_t virtualAddr, uint8_t value )
+{
+    if (( pEntry != NULL ) && CraPhysicalAddr( virtualAddr, &pEntry->deviceId, &pEntry->regOffset ))
+    {
+        pEntry->value = value;
+        pEntry->valid = true;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//! @brief      Update the shadow copies after a write of count registers at virtualAddr.
+//!             Every entry in the written range is dropped, whatever page it was cached
+//!             through; a single register write that succeeded is cached again.
+//-------------------------------------------------------------------------------------------------
+static void CraCacheWritten ( SiiReg_t virtualAddr, const uint8_t *pBuffer, uint16_t count )
+{
+    prefuint_t  i, j;
+    uint8_t     deviceId, regOffset;
+
+    for ( i = 0; g_siiRegCacheFlush[ i] != 0xFFFF; i++ )
+    {
+        if ((( g_siiRegCacheFlush[ i] >> 8 ) == ( virtualAddr >> 8 )) &&
+            ((uint8_t)( g_siiRegCacheFlush[ i] - virtualAddr ) < count ))
+        {
+            SiiCraCacheInvalidate();
+            return;
+        }
+    }
+
+    if ( !CraPhysicalAddr( virtualAddr, &deviceId, &regOffset ))
+    {
+        return;
+    }
+
+    for ( i = 0; i < SII_CRA_MAX_DEVICE_INSTANCES; i++ )
+    {
+        for ( j = 0; j < SII_CRA_CACHE_SIZE; j++ )
+        {
+            if (( l_craCache[ i][ j].deviceId == deviceId ) &&
+                ((uint8_t)( l_craCache[ i][ j].regOffset - regOffset ) < count ))
+            {
+                l_craCache[ i][ j].valid = false;
+            }
+        }
+    }
+
+    if (( count == 1 ) && ( craInstance.lastResultCode == RESULT_CRA_SUCCESS ))
+    {
+        CraCacheFill( CraCacheEntry( virtualAddr ), virtualAddr, *pBuffer );
+    }
+}
+#endif
+
 static void _AmtranRegReadBlock ( SiiReg_t virtualAddr, uint8_t *pBuffer, uint16_t count )
 {
     uint8_t             regOffset = (uint8_t)virtualAddr;
@@ -220,6 +336,16 @@ uint8_t _AmtranRegRead ( SiiReg_t virtualAddr )
     uint8_t             value = 0;
     uint8_t             regOffset = (uint8_t)virtualAddr;
     pageConfig_t        *pPage;
+#if ( configSII_CRA_CACHE == 1 )
+    SiiReg_t            cacheAddr = virtualAddr;
+    CraCacheEntry_t     *pEntry = CraCacheEntry( virtualAddr );
+
+    if (( pEntry != NULL ) && pEntry->valid )
+    {
+        craInstance.lastResultCode = RESULT_CRA_SUCCESS;
+        return( pEntry->value );
+    }
+#endif
 
     virtualAddr >>= 8;
     pPage = &g_addrDescriptor[ l_pageInstance[ virtualAddr]][ virtualAddr];
@@ -237,6 +363,13 @@ uint8_t _AmtranRegRead ( SiiReg_t virtualAddr )
             break;
     }
 
+#if ( configSII_CRA_CACHE == 1 )
+    if ( craInstance.lastResultCode == RESULT_CRA_SUCCESS )
+    {
+        CraCacheFill( pEntry, cacheAddr, value );
+    }
+#endif
+
     return( value );
 }
 
@@ -244,6 +377,9 @@ static void _AmtranRegWriteBlock ( SiiReg_t virtualAddr, const uint8_t *pBuffer,
 {
     uint8_t             regOffset = (uint8_t)virtualAddr;
     pageConfig_t        *pPage;
+#if ( configSII_CRA_CACHE == 1 )
+    SiiReg_t            cacheAddr = virtualAddr;
+#endif
 
     virtualAddr >>= 8;
     pPage = &g_addrDescriptor[l_pageInstance[virtualAddr]][virtualAddr];
@@ -260,6 +396,10 @@ static void _AmtranRegWriteBlock ( SiiReg_t virtualAddr, const uint8_t *pBuffer,
             craInstance.lastResultCode = RESULT_CRA_INVALID_PARAMETER;
             break;
     }
+
+#if ( configSII_CRA_CACHE == 1 )
+    CraCacheWritten( cacheAddr, pBuffer, count );
+#endif
 }
 
 static void _AmtranRegWrite ( SiiReg_t virtualAddr, uint8_t value )
@@ -267,6 +407,9 @@ static void _AmtranRegWrite ( SiiReg_t virtualAddr, uint8_t value )
     uint8_t             regOffset = (uint8_t)virtualAddr;
     pageConfig_t        *pPage;
 	uint8_t buffer = value;
+#if ( configSII_CRA_CACHE == 1 )
+    SiiReg_t            cacheAddr = virtualAddr;
+#endif
 
     virtualAddr >>= 8;
     pPage = &g_addrDescriptor[l_pageInstance[virtualAddr]][virtualAddr];
@@ -290,7 +433,51 @@ static void _AmtranRegWrite ( SiiReg_t virtualAddr, uint8_t value )
             break;
     }
 
+#if ( configSII_CRA_CACHE == 1 )
+    CraCacheWritten( cacheAddr, &buffer, 1 );
+#endif
 }
+
+#if ( configSII_CRA_CACHE == 1 )
+//-------------------------------------------------------------------------------------------------
+//! @brief      Read-modify-write of one register under a single bus lock.  A cacheable
+//!             register is read from its shadow copy and only written if it changes;
+//!             a volatile one is always written unless onlyIfChanged is set.
+//-------------------------------------------------------------------------------------------------
+static void CraRegUpdate ( SiiReg_t virtualAddr, uint8_t clearBits, uint8_t setBits, bool_t onlyIfChanged )
+{
+    uint8_t oldByte, newByte;
+
+    if (App_I2C1_sema_mutex_take() != TRUE)
+    {
+        return;
+    }
+
+    oldByte = _AmtranRegRead( virtualAddr );
+    if ( craInstance.lastResultCode == RESULT_CRA_SUCCESS )
+    {
+        newByte = ( oldByte & ~clearBits ) | setBits;
+        if (( newByte != oldByte ) || ( !onlyIfChanged && ( CraCacheEntry( virtualAddr ) == NULL )))
+        {
+            _AmtranRegWrite( virtualAddr, newByte );
+        }
+    }
+
+    App_I2C1_sema_mutex_give();
+}
+
+//------------------------------------------------------------------------------
+// Function:    SiiCraCacheInvalidate
+// Description: Drop all shadow register copies, e.g. after the device has
+//              been reset.
+// Parameters:  none
+// Returns:     None
+//------------------------------------------------------------------------------
+void SiiCraCacheInvalidate ( void )
+{
+    memset( l_craCache, 0, sizeof( l_craCache ));
+}
+#endif
 #endif 
 
 //------------------------------------------------------------------------------
@@ -305,6 +492,10 @@ bool_t SiiCraInitialize ( void )
     prefuint_t i, index;
     craInstance.lastResultCode = RESULT_CRA_SUCCESS;
 
+#if ( configSII_DEV_953x_PORTING == 1 ) && ( configSII_CRA_CACHE == 1 )
+    SiiCraCacheInvalidate();    // Device has been reset, nothing in the shadow copy is valid
+#endif
+
     for (i = 0; i < SII_CRA_DEVICE_PAGE_COUNT; i++)
     {
         l_pageInstance[i] = 0;
@@ -560,12 +751,16 @@ void SiiRegWrite ( SiiReg_t virtualAddr, uint8_t value )
 //------------------------------------------------------------------------------
 void SiiRegModify ( SiiReg_t virtualAddr, uint8_t mask, uint8_t value)
 {
+#if ( configSII_DEV_953x_PORTING == 1 ) && ( configSII_CRA_CACHE == 1 )
+    CraRegUpdate( virtualAddr, mask, (mask & value), false );
+#else
     uint8_t aByte;
 
     aByte = SiiRegRead( virtualAddr );
     aByte &= (~mask);                       // first clear all bits in mask
     aByte |= (mask & value);                // then set bits from value
     SiiRegWrite( virtualAddr, aByte );
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -578,11 +773,15 @@ void SiiRegModify ( SiiReg_t virtualAddr, uint8_t mask, uint8_t value)
 //------------------------------------------------------------------------------
 void SiiRegBitsSet ( SiiReg_t virtualAddr, uint8_t bitMask, bool_t setBits )
 {
+#if ( configSII_DEV_953x_PORTING == 1 ) && ( configSII_CRA_CACHE == 1 )
+    CraRegUpdate( virtualAddr, bitMask, (setBits) ? bitMask : 0, false );
+#else
     uint8_t aByte;
 
     aByte = SiiRegRead( virtualAddr );
     aByte = (setBits) ? (aByte | bitMask) : (aByte & ~bitMask);
     SiiRegWrite( virtualAddr, aByte );
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -597,6 +796,9 @@ void SiiRegBitsSet ( SiiReg_t virtualAddr, uint8_t bitMask, bool_t setBits )
 //------------------------------------------------------------------------------
 void SiiRegBitsSetNew ( SiiReg_t virtualAddr, uint8_t bitMask, bool_t setBits )
 {
+#if ( configSII_DEV_953x_PORTING == 1 ) && ( configSII_CRA_CACHE == 1 )
+    CraRegUpdate( virtualAddr, bitMask, (setBits) ? bitMask : 0, true );
+#else
     uint8_t newByte, oldByte;
 
     oldByte = SiiRegRead( virtualAddr );
@@ -605,6 +807,7 @@ void SiiRegBitsSetNew ( SiiReg_t virtualAddr, uint8_t bitMask, bool_t setBits )
     {
         SiiRegWrite( virtualAddr, newByte );
     }
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -28,6 +28,10 @@ void    SiiRegModify ( SiiReg_t virtualAddr, uint8_t mask, uint8_t value);
 void    SiiRegBitsSet ( SiiReg_t virtualAddr, uint8_t bitMask, bool_t setBits );
 void    SiiRegBitsSetNew ( SiiReg_t virtualAddr, uint8_t bitMask, bool_t setBits );
 
+#if ( configSII_DEV_953x_PORTING == 1 ) && ( configSII_CRA_CACHE == 1 )
+void    SiiCraCacheInvalidate ( void );
+#endif
+
 // Special purpose
 void    SiiRegEdidReadBlock ( SiiReg_t segmentAddr, SiiReg_t virtualAddr, uint8_t *pBuffer, uint16_t count );
 
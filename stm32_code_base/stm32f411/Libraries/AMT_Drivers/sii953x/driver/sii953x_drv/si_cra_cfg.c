@@ -14,6 +14,11 @@
 #include "si_cra.h"
 #include "si_cra_cfg.h"
 #include "si_regs_pp953x.h"
+#if ( configSII_CRA_CACHE == 1 )
+#include "si_regs_gpio953x.h"
+#include "si_regs_rxedid953x.h"
+#include "si_regs_audio953x.h"
+#endif
 
 
 //------------------------------------------------------------------------------
@@ -132,3 +137,55 @@ SiiReg_t g_siiRegPageBaseReassign [] =
 
         0xFFFF      // End of reassignment list
 };
+
+#if ( configSII_CRA_CACHE == 1 )
+// Registers the CRA layer keeps a shadow copy of, so that SiiRegModify and
+// SiiRegBitsSet need no I2C read and skip the write if nothing changes.
+// Only registers that the MCU alone writes may be listed: interrupt enables
+// and masks, GPIO setup and port/FIFO selects.  Status, interrupt status,
+// FIFO, trigger and self-clearing registers must stay out of this list.
+SiiReg_t g_siiRegCacheable [] =
+{
+        REG_RX_PORT_SEL,
+        REG_INT_ENABLE_2,
+        REG_INT_ENABLE_5,
+        REG_RX_TMDS_TERM_0,
+        REG_INT_ENABLE_9,
+        REG_INT_ENABLE_GPIO_1,
+        REG_INT_ENABLE_GPIO_2,
+        REG_INT_MASK_19,
+        REG_INT_MASK_20,
+
+        REG_INT_ENABLE_IP1,
+        REG_INT_ENABLE_P1,
+        REG_INT_ENABLE_P2,
+        REG_INT_ENABLE_IP2,
+        REG_INT_ENABLE_P3,
+        REG_INT_ENABLE_P4,
+        REG_INT_ENABLE_IP3,
+        REG_INT_ENABLE_IP4,
+        REG_INT_ENABLE_IP5,
+        REG_PORT_INFOFRAME_SELECT,
+
+        REG_EDID_FIFO_SEL,
+        REG_GPIO_ALTEN,
+        REG_GPIO_ALTEN_DIR,
+        REG_GPIO_DIR,
+        REG_GPIO_PU_SEL_EN,
+        REG_GPIO_PU_EN,
+
+        REG_AUDIO_INTR11_MASK,
+
+        0xFFFF      // End of cacheable list
+};
+
+// A write to one of these resets register blocks; the whole shadow copy is dropped
+SiiReg_t g_siiRegCacheFlush [] =
+{
+        REG_SYS_RESET_1,
+        REG_SYS_RESET_2,
+        REG_SYS_RESET_3,
+
+        0xFFFF      // End of flush list
+};
+#endif
@@ -122,6 +122,7 @@ typedef enum _SiiRegPageIndex_t
 
 #define SII_CRA_MAX_DEVICE_INSTANCES    2   // Maximum size of instance dimension of address descriptor array
 #define SII_CRA_DEVICE_PAGE_COUNT       25  // Number of entries in pageConfig_t array
+#define SII_CRA_CACHE_SIZE              32  // Maximum number of entries in g_siiRegCacheable array
 
 typedef struct pageConfig
 {
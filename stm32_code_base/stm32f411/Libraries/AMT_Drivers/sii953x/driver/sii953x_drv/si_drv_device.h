@@ -86,6 +86,15 @@ void SiiDrvDeviceMpResDetectionEnable(bool_t isEnabled);
 
 SiiDrvDeviceStatus_t SiiDrvDeviceStatus ( void );
 
+typedef enum
+{
+    SiiDEV_INT_GROUP_TX0        = 0x01,    // Tx0 interrupts
+    SiiDEV_INT_GROUP_CBUS       = 0x02,    // CBUS interrupts
+    SiiDEV_INT_GROUP_CEC        = 0x04     // CEC interrupts
+} SiiDrvDeviceIntGroup_t;
+
+uint8_t SiiDrvDeviceInterruptGroups ( void );
+
 void SiiDrvDevice3dMarkerGpioEnable( uint8_t enableFlags );
 void SiiDrvDevice3dMarkerConfigure( uint16_t optionFlags, uint16_t markerDelay720p, uint16_t markerDelay1080p );
 void SiiDrvDeviceGet3dMarkerConfiguration( uint16_t *pOptionFlags, uint16_t *pMarkerDelay720p, uint16_t *pMarkerDelay1080p );
@@ -606,6 +606,23 @@ SiiDrvDeviceStatus_t SiiDrvDeviceStatus ( void )
 	return( x );
 }
 
+#if ( configSII953x_INT_WAKEUP == 1 )
+static uint8_t intGroups = 0;
+
+//------------------------------------------------------------------------------
+// Function:    SiiDrvDeviceInterruptGroups
+// Description: Returns the interrupt groups found by the last call of
+//				SiiDrvDeviceManageInterrupts, 0 if the INT line was not set.
+// Parameters:  none
+// Returns:     SiiDrvDeviceIntGroup_t flags
+//------------------------------------------------------------------------------
+
+uint8_t SiiDrvDeviceInterruptGroups ( void )
+{
+    return( intGroups );
+}
+#endif
+
 
 //------------------------------------------------------------------------------
 // Function:    SiiDrvDeviceStandby
@@ -871,6 +888,10 @@ bool_t SiiDrvDeviceManageInterrupts ( bool_t fullPowerMode )
 #endif
     bool_t initGpioStatus = false;
 
+#if ( configSII953x_INT_WAKEUP == 1 )
+    intGroups = 0;
+#endif
+
     // Check the hardware interrupt
     if ( SiiPlatformInterruptStateGet() == false )
     {
@@ -881,6 +902,21 @@ bool_t SiiDrvDeviceManageInterrupts ( bool_t fullPowerMode )
     intStatus = SiiRegRead( REG_INT_GROUP_STATE_0 );
     intStatus1 = SiiRegRead( REG_INT_GROUP_STATE_1 );
 
+#if ( configSII953x_INT_WAKEUP == 1 )
+    if ( intStatus & BIT_INTR_TX0 )
+    {
+        intGroups |= SiiDEV_INT_GROUP_TX0;
+    }
+    if ( intStatus & BIT_INTR_GRP5 )
+    {
+        intGroups |= SiiDEV_INT_GROUP_CBUS;
+    }
+    if ( intStatus & BIT_INTR_GRP6 )
+    {
+        intGroups |= SiiDEV_INT_GROUP_CEC;
+    }
+#endif
+
 #if INTERRUPT_DEBUG
     if( ( lastIntStatus != intStatus ) || ( lastIntStatus1 != intStatus1 ) )
     {
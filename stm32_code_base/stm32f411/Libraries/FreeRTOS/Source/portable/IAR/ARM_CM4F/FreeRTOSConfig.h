@@ -168,5 +168,12 @@ standard names. */
 #define xPortPendSVHandler PendSV_Handler
 #define xPortSysTickHandler SysTick_Handler
 
+/* Context switch counter of the application debug build, reported per second
+by the Debug service (configDEBUG_TASK_SWITCH). */
+#if defined ( __ICCARM__ ) && defined ( DEBUG ) && defined ( FREE_RTOS )
+	extern volatile uint32_t ulDebugTaskSwitchCount;
+	#define traceTASK_SWITCHED_IN()		( ulDebugTaskSwitchCount++ )
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
 
@@ -44,7 +44,7 @@
  #include "usbh_usr.h"
  #include "usbh_core.h"
  #include "usbh_msc_core.h"
- #include "pdm_filter.h"
+ #include "pdm_decimator.h"
 #endif
  
 /* Exported types ------------------------------------------------------------*/
@@ -69,6 +69,17 @@
                                            More the size is higher, the recorded quality is better */ 
   #define TIME_REC                3000 /* Recording time in millisecond(Systick Time Base*TIME_REC= 10ms*3000)
                                          (default: 30s) */
+
+  /* Comment this define to filter the microphone with the PDM_Filter library
+     inside the SPI interrupt instead of the CIC + half-band decimator
+     (pdm_decimator.c) run from the recording loop on DMA buffers */
+  #define USE_PDM_DECIMATOR
+
+  #if defined USE_PDM_DECIMATOR
+  #define REC_PDM_FREQ            16000 /* PCM output rate: 16000, 32000 or 48000 Hz */
+  #define REC_PDM_DECIMATION      PDM_DECIMATION_64 /* PDM clock = REC_PDM_FREQ x 64 (or 128) */
+  #define REC_PDM_GAIN            (PDM_GAIN_0DB * 8) /* +18 dB, the microphone is -26 dBFS at 94 dB SPL */
+  #endif
 #endif /* MEDIA_USB_KEY */
 
 /* Exported macro ------------------------------------------------------------*/
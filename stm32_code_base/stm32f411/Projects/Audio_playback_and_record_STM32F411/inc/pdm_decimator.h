@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    Audio_playback_and_record/inc/pdm_decimator.h 
+  * @brief   Header for pdm_decimator.c module
+  ******************************************************************************
+  */ 
+  
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PDM_DECIMATOR_H
+#define __PDM_DECIMATOR_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx.h"
+
+/* Exported Defines ----------------------------------------------------------*/
+/* Order of the CIC (sinc^N) first stage */
+#define PDM_CIC_ORDER           4
+
+/* Half-band FIR length (4k+3 taps, only the odd ones and the centre are non-zero) */
+#define PDM_HB_TAPS             47
+
+/* Supported total decimation ratios: CIC by 32/64, then half-band by 2 */
+#define PDM_DECIMATION_64       64
+#define PDM_DECIMATION_128      128
+
+/* Q8 gain, 256 is 0 dB */
+#define PDM_GAIN_0DB            256
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Decimation;                  /* 64 or 128 */
+  uint32_t CicWords;                    /* PDM words per CIC output */
+  uint32_t CicShift;                    /* CIC output to Q15 */
+  uint32_t CicOffset;                   /* CIC output of an idle (50% density) stream */
+  uint32_t CicInt[PDM_CIC_ORDER];       /* integrators, modulo 2^32 */
+  uint32_t CicComb[PDM_CIC_ORDER];      /* comb delays, modulo 2^32 */
+  uint32_t CicCount;                    /* words into the current CIC output */
+  int32_t  HbLine[2 * PDM_HB_TAPS];     /* half-band delay line, written twice so the window is linear */
+  uint32_t HbPos;
+  uint32_t HbPhase;                     /* odd CIC outputs produce a PCM sample */
+  int32_t  DcLevel;                     /* DC estimate, Q8 */
+  int32_t  Gain;                        /* Q8 */
+} PDM_DecimatorTypeDef;
+
+/* Exported functions ------------------------------------------------------- */
+uint32_t PDM_Decimator_Init(PDM_DecimatorTypeDef *Dec, uint32_t Decimation, int32_t Gain);
+uint32_t PDM_Decimator_Process(PDM_DecimatorTypeDef *Dec, const uint16_t *pPdm, uint32_t Words, int16_t *pPcm);
+
+#endif /* __PDM_DECIMATOR_H */
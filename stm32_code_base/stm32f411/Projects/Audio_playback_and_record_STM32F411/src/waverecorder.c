@@ -21,7 +21,9 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#if !defined USE_PDM_DECIMATOR
 #include "pdm_filter.h"
+#endif
 #include "waverecorder.h" 
 
 /** @addtogroup STM32F4-Discovery_Audio_Player_Recorder
@@ -45,6 +47,25 @@
 
 #define AUDIO_REC_SPI_IRQHANDLER          SPI2_IRQHandler
 
+#if defined USE_PDM_DECIMATOR
+/* SPI2_RX: DMA1 Stream3 Channel0 */
+#define AUDIO_REC_DMA_CLOCK               RCC_AHB1Periph_DMA1
+#define AUDIO_REC_DMA_STREAM              DMA1_Stream3
+#define AUDIO_REC_DMA_CHANNEL             DMA_Channel_0
+#define AUDIO_REC_DMA_IRQ                 DMA1_Stream3_IRQn
+#define AUDIO_REC_DMA_IRQHANDLER          DMA1_Stream3_IRQHandler
+#define AUDIO_REC_DMA_FLAG_HT             DMA_IT_HTIF3
+#define AUDIO_REC_DMA_FLAG_TC             DMA_IT_TCIF3
+
+/* Audio recording frequency in Hz */
+#define REC_FREQ                          REC_PDM_FREQ
+
+/* PDM words per DMA half: 32 ms at 16 kHz / 64x, enough to ride out an f_write */
+#define PDM_DMA_HALF_WORDS      2048
+
+/* PCM buffer output size, one DMA half */
+#define PCM_OUT_SIZE            ((PDM_DMA_HALF_WORDS * 16) / REC_PDM_DECIMATION)
+#else
 /* Audio recording frequency in Hz */
 #define REC_FREQ                          8000  
 
@@ -53,6 +74,7 @@
 
 /* PCM buffer output size */
 #define PCM_OUT_SIZE            16
+#endif
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -70,7 +92,9 @@ uint16_t counter = 0;
 uint8_t WaveRecStatus = 0;
 /* Current state of the audio recorder interface intialization */
 static uint32_t AudioRecInited = 0;
+#if !defined USE_PDM_DECIMATOR
 PDMFilter_InitStruct Filter;
+#endif
 /* Audio recording Samples format (from 8 to 16 bits) */
 uint32_t AudioRecBitRes = 16; 
 uint16_t RecBuf[PCM_OUT_SIZE], RecBuf1[PCM_OUT_SIZE];
@@ -83,14 +107,27 @@ uint16_t* pAudioRecBuf;
 /* Current size of the recorded buffer */
 uint32_t AudioRecCurrSize = 0; 
 uint16_t bytesWritten;
+#if defined USE_PDM_DECIMATOR
+/* Circular DMA buffer of PDM words, HT and TC hand a half over to the recording loop */
+static uint16_t PdmDmaBuf[2 * PDM_DMA_HALF_WORDS];
+static __IO uint8_t PdmHalfFull[2];
+static uint8_t PdmNextHalf = 0;
+/* Halves refilled before the recording loop got to them */
+__IO uint32_t PdmOverrun = 0;
+static PDM_DecimatorTypeDef Decimator;
+#else
 /* Temporary data sample */
 static uint16_t InternalBuffer[INTERNAL_BUFF_SIZE];
 static uint32_t InternalBufferSize = 0;
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 static void WaveRecorder_GPIO_Init(void);
 static void WaveRecorder_SPI_Init(uint32_t Freq);
 static void WaveRecorder_NVIC_Init(void);
+#if defined USE_PDM_DECIMATOR
+static void WaveRecorder_DMA_Init(void);
+#endif
 
 /* Private functions ---------------------------------------------------------*/
 
@@ -111,6 +148,7 @@ uint32_t WaveRecorderInit(uint32_t AudioFreq, uint32_t BitRes, uint32_t ChnlNbr)
   }
   else
   {
+#if !defined USE_PDM_DECIMATOR
     /* Enable CRC module */
     RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
     
@@ -122,6 +160,7 @@ uint32_t WaveRecorderInit(uint32_t AudioFreq, uint32_t BitRes, uint32_t ChnlNbr)
     Filter.In_MicChannels = 1;
     
     PDM_Filter_Init((PDMFilter_InitStruct *)&Filter);
+#endif
     
     /* Configure the GPIOs */
     WaveRecorder_GPIO_Init();
@@ -131,6 +170,11 @@ uint32_t WaveRecorderInit(uint32_t AudioFreq, uint32_t BitRes, uint32_t ChnlNbr)
     
     /* Configure the SPI */
     WaveRecorder_SPI_Init(AudioFreq);
+
+#if defined USE_PDM_DECIMATOR
+    /* Configure the SPI Rx DMA */
+    WaveRecorder_DMA_Init();
+#endif
     
     /* Set the local parameters */
     AudioRecBitRes = BitRes;
@@ -159,9 +203,21 @@ uint8_t WaveRecorderStart(uint16_t* pbuf, uint32_t size)
     pAudioRecBuf = pbuf;
     AudioRecCurrSize = size;
     
+#if defined USE_PDM_DECIMATOR
+    PDM_Decimator_Init(&Decimator, REC_PDM_DECIMATION, REC_PDM_GAIN);
+    PdmHalfFull[0] = 0;
+    PdmHalfFull[1] = 0;
+    PdmNextHalf = 0;
+
+    /* The PDM words are moved by DMA, the recording loop decimates them */
+    DMA_SetCurrDataCounter(AUDIO_REC_DMA_STREAM, (2 * PDM_DMA_HALF_WORDS));
+    DMA_Cmd(AUDIO_REC_DMA_STREAM, ENABLE);
+    SPI_I2S_DMACmd(SPI2, SPI_I2S_DMAReq_Rx, ENABLE);
+#else
     /* Enable the Rx buffer not empty interrupt */
     SPI_I2S_ITConfig(SPI2, SPI_I2S_IT_RXNE, ENABLE);
     /* The Data transfer is performed in the SPI interrupt routine */
+#endif
     /* Enable the SPI peripheral */
     I2S_Cmd(SPI2, ENABLE); 
    
@@ -188,6 +244,11 @@ uint32_t WaveRecorderStop(void)
     
     /* Stop conversion */
     I2S_Cmd(SPI2, DISABLE); 
+
+#if defined USE_PDM_DECIMATOR
+    SPI_I2S_DMACmd(SPI2, SPI_I2S_DMAReq_Rx, DISABLE);
+    DMA_Cmd(AUDIO_REC_DMA_STREAM, DISABLE);
+#endif
     
     /* Return 0 if all operations are OK */
     return 0;
@@ -199,6 +260,61 @@ uint32_t WaveRecorderStop(void)
   }
 }
 
+#if defined USE_PDM_DECIMATOR
+/**
+  * @brief  This function handles the AUDIO_REC_DMA stream interrupt request:
+  *         HT hands half 0 to the recording loop, TC half 1.
+  * @param  None
+  * @retval None
+*/
+void AUDIO_REC_DMA_IRQHANDLER(void)
+{
+  uint8_t half = 2;
+
+  if (DMA_GetITStatus(AUDIO_REC_DMA_STREAM, AUDIO_REC_DMA_FLAG_HT) != RESET)
+  {
+    DMA_ClearITPendingBit(AUDIO_REC_DMA_STREAM, AUDIO_REC_DMA_FLAG_HT);
+    half = 0;
+  }
+  else if (DMA_GetITStatus(AUDIO_REC_DMA_STREAM, AUDIO_REC_DMA_FLAG_TC) != RESET)
+  {
+    DMA_ClearITPendingBit(AUDIO_REC_DMA_STREAM, AUDIO_REC_DMA_FLAG_TC);
+    half = 1;
+  }
+
+  if (half < 2)
+  {
+    if (PdmHalfFull[half] != 0)
+    {
+      PdmOverrun++;
+    }
+    PdmHalfFull[half] = 1;
+  }
+}
+
+/**
+  * @brief  Decimate the next PDM half filled by the DMA.
+  * @param  pbuf: PCM output, PCM_OUT_SIZE samples
+  * @retval Number of PCM samples, 0 if no half is ready yet
+  */
+static uint32_t WaveRecorder_Decimate(uint16_t* pbuf)
+{
+  uint32_t count;
+
+  if (PdmHalfFull[PdmNextHalf] == 0)
+  {
+    return 0;
+  }
+
+  count = PDM_Decimator_Process(&Decimator, &PdmDmaBuf[PdmNextHalf * PDM_DMA_HALF_WORDS],
+                                PDM_DMA_HALF_WORDS, (int16_t *)pbuf);
+
+  PdmHalfFull[PdmNextHalf] = 0;
+  PdmNextHalf ^= 1;
+
+  return count;
+}
+#else
 /**
   * @brief  This function handles AUDIO_REC_SPI global interrupt request.
   * @param  None
@@ -228,6 +344,7 @@ void AUDIO_REC_SPI_IRQHANDLER(void)
     }
   }
 }
+#endif
 
 /**
   * @brief  Initialize the wave header file
@@ -276,7 +393,11 @@ uint32_t WavaRecorderHeaderInit(uint8_t* pHeadBuf)
   pHeadBuf[21]  = 0x00;
 
   /* Write the number of channels, must be 0x01 (Mono) or 0x02 (Stereo) */
+#if defined USE_PDM_DECIMATOR
+  pHeadBuf[22]  = 0x01;
+#else
   pHeadBuf[22]  = 0x02;
+#endif
   pHeadBuf[23]  = 0x00;
 
   /* Write the Sample Rate 8000 Hz */
@@ -286,10 +407,17 @@ uint32_t WavaRecorderHeaderInit(uint8_t* pHeadBuf)
   pHeadBuf[27]  = (uint8_t)((REC_FREQ >> 24) & 0xFF);
 
   /* Write the Byte Rate */
+#if defined USE_PDM_DECIMATOR
+  pHeadBuf[28]  = (uint8_t)(((REC_FREQ * 2) & 0xFF));
+  pHeadBuf[29]  = (uint8_t)(((REC_FREQ * 2) >> 8) & 0xFF);
+  pHeadBuf[30]  = (uint8_t)(((REC_FREQ * 2) >> 16) & 0xFF);
+  pHeadBuf[31]  = (uint8_t)(((REC_FREQ * 2) >> 24) & 0xFF);
+#else
   pHeadBuf[28]  = (uint8_t)((REC_FREQ & 0xFF));
   pHeadBuf[29]  = (uint8_t)((REC_FREQ >> 8) & 0xFF);
   pHeadBuf[30]  = (uint8_t)((REC_FREQ >> 16) & 0xFF);
   pHeadBuf[31]  = (uint8_t)((REC_FREQ >> 24) & 0xFF);
+#endif
 
   /* Write the block alignment */
   pHeadBuf[32]  = 0x02;/*0x02*/
@@ -328,6 +456,12 @@ uint32_t WavaRecorderHeaderInit(uint8_t* pHeadBuf)
   */
 void WaveRecorderUpdate(void)
 {     
+#if defined USE_PDM_DECIMATOR
+  uint32_t PcmCount = 0;
+#else
+  uint32_t PcmCount = PCM_OUT_SIZE;
+#endif
+
   WaveRecorderInit(32000,16, 1);
   WaveCounter = 0;
   LED_Toggle = 7;
@@ -369,6 +503,12 @@ void WaveRecorderUpdate(void)
     /* Wait for the recording time */  
     if (Time_Rec_Base <= TIME_REC)
     {
+#if defined USE_PDM_DECIMATOR
+      /* Wait for a PDM half from the DMA and turn it into PCM here, outside the interrupt */
+      while(((PcmCount = WaveRecorder_Decimate(RecBuf)) == 0) && HCD_IsDeviceConnected(&USB_OTG_Core));
+      writebuffer = RecBuf;
+      WaveCounter += (PcmCount * 2);
+#else
       /* Wait for the data to be ready with PCM form */
       while((Data_Status == 0)&& HCD_IsDeviceConnected(&USB_OTG_Core));
       Data_Status =0;
@@ -388,8 +528,9 @@ void WaveRecorderUpdate(void)
         WaveCounter += 32;
         Switch = 1;
       }
+#endif
       
-      for (counter=0; counter<16; counter++)
+      for (counter=0; counter<PcmCount; counter++)
       {
         LED_Toggle = 3;
         if (buf_idx< RAM_BUFFER_SIZE)
@@ -505,7 +646,12 @@ static void WaveRecorder_SPI_Init(uint32_t Freq)
   
   /* SPI configuration */
   SPI_I2S_DeInit(SPI2);
+#if defined USE_PDM_DECIMATOR
+  /* 16-bit frames are 32 clocks per "sample", the bit clock is the PDM clock */
+  I2S_InitStructure.I2S_AudioFreq = (REC_FREQ * REC_PDM_DECIMATION) / 32;
+#else
   I2S_InitStructure.I2S_AudioFreq = 32000;
+#endif
   I2S_InitStructure.I2S_Standard = I2S_Standard_LSB;
   I2S_InitStructure.I2S_DataFormat = I2S_DataFormat_16b;
   I2S_InitStructure.I2S_CPOL = I2S_CPOL_High;
@@ -514,10 +660,48 @@ static void WaveRecorder_SPI_Init(uint32_t Freq)
   /* Initialize the I2S peripheral with the structure above */
   I2S_Init(SPI2, &I2S_InitStructure);
 
+#if !defined USE_PDM_DECIMATOR
   /* Enable the Rx buffer not empty interrupt */
   SPI_I2S_ITConfig(SPI2, SPI_I2S_IT_RXNE, ENABLE);
+#endif
 }
 
+#if defined USE_PDM_DECIMATOR
+/**
+  * @brief  Initialize the SPI Rx DMA: circular over both PDM halves, HT and TC interrupts.
+  * @param  None
+  * @retval None
+  */
+static void WaveRecorder_DMA_Init(void)
+{
+  DMA_InitTypeDef DMA_InitStructure;
+
+  RCC_AHB1PeriphClockCmd(AUDIO_REC_DMA_CLOCK, ENABLE);
+
+  DMA_Cmd(AUDIO_REC_DMA_STREAM, DISABLE);
+  DMA_DeInit(AUDIO_REC_DMA_STREAM);
+
+  DMA_InitStructure.DMA_Channel = AUDIO_REC_DMA_CHANNEL;
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(SPI2->DR);
+  DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)PdmDmaBuf;
+  DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+  DMA_InitStructure.DMA_BufferSize = (2 * PDM_DMA_HALF_WORDS);
+  DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+  DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+  DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+  DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+  DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+  DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+  DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+  DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+  DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+  DMA_Init(AUDIO_REC_DMA_STREAM, &DMA_InitStructure);
+
+  DMA_ITConfig(AUDIO_REC_DMA_STREAM, DMA_IT_HT | DMA_IT_TC, ENABLE);
+}
+#endif
+
 
 /**
   * @brief  Initialize the NVIC.
@@ -529,8 +713,13 @@ static void WaveRecorder_NVIC_Init(void)
   NVIC_InitTypeDef NVIC_InitStructure;
 
   NVIC_PriorityGroupConfig(NVIC_PriorityGroup_3); 
+#if defined USE_PDM_DECIMATOR
+  /* Configure the SPI Rx DMA interrupt priority */
+  NVIC_InitStructure.NVIC_IRQChannel = AUDIO_REC_DMA_IRQ;
+#else
   /* Configure the SPI interrupt priority */
   NVIC_InitStructure.NVIC_IRQChannel = SPI2_IRQn;
+#endif
   NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
   NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
   NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
@@ -19,13 +19,16 @@ extern CTRL_CMD_HANDLE_OBJECT *pCtrlCmd_ObjCtrl;
 
 
 //__________________________________________________________________________________________
-#define WAIT_TIMEOUT VIRTUAL_TIMER_MSEC2TICKS(50)
-#define UART_TIME_TICK TASK_MSEC2TICKS(1)
+#define WAIT_TIMEOUT TASK_MSEC2TICKS(50) /*drop a frame that stops arriving*/
 
 #define FAC_HEADER 0xC5
 #define CTRL_HEADER 0xCA
 #define PACKAGE_MAX 136 /*header+ command type + data[128] + checksum*/
 
+#define FAC_LEN_POS 2 /*header + command type + length + ... + checksum*/
+#define FAC_LEN_MIN 5 /*header + command type + length + opcode + checksum*/
+#define CTRL_OPCODE_POS 1 /*header + opcode + params*/
+
 //__________________________________________________________________________________________
 const static xHMIUserEvents IRNumberTable[] =
 {
@@ -71,8 +74,13 @@ const static xHMIUserEvents IRAlphaTable[] =
     USER_EVENT_NULL     	/* z */
 };
 
+/*received bytes; a frame being assembled always starts at mBuffer[0]*/
 static uint8 mBuffer[PACKAGE_MAX]={0xff};
 static uint8 *pPackage = mBuffer;
+static uint16 mLength = 0;
+
+/*set after a false header; skipped bytes are then not taken as key codes*/
+static bool mResync = FALSE;
 
 
 //___________________________________________________________________________________
@@ -92,43 +100,127 @@ xHMIUserEvents UartCmdDispatcher_UserEventHandle(char UartCode)
     }
 }
 
-void UARTCmdDispatcher_poll( void *data )
+static void UARTCmdDispatcher_discard( uint16 length )
 {
-    xHMISrvEventParams srv_parms = {xHMI_EVENT_UART, USER_EVENT_UNDEFINED };
-    byte data_len = 0;
+    mLength -= length;
+    memmove( pPackage, ( pPackage + length ), mLength );
+}
 
-    for( ;; )
+/*total length of the frame at pPackage[0]. while the length is not known yet
+  it is the number of bytes needed to know it, so a frame is complete once
+  mLength reaches the returned value. 0 if the frame is invalid*/
+static uint16 UARTCmdDispatcher_frameLength( void )
+{
+    uint16 length;
+
+    if ( *( pPackage + 0 ) == FAC_HEADER )
     {
-        data_len = UARTLowLevel_getDataLength( );
+        if ( mLength <= FAC_LEN_POS )
+        {
+            return ( FAC_LEN_POS + 1 );
+        }
 
-        if ( data_len > 0 )
+        length = *( pPackage + FAC_LEN_POS );
+        if ( ( length < FAC_LEN_MIN ) || ( length > FACTORY_PACKAGE_MAX ) )
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        if ( mLength <= CTRL_OPCODE_POS )
+        {
+            return ( CTRL_OPCODE_POS + 1 );
+        }
+
+        length = ( CTRL_OPCODE_POS + 1 ) +
+            pCtrlCmd_ObjCtrl->params_length( *( pPackage + CTRL_OPCODE_POS ),
+                                             ( pPackage + CTRL_OPCODE_POS + 1 ),
+                                             ( mLength - CTRL_OPCODE_POS - 1 ) );
+        if ( length > PACKAGE_MAX )
+        {
+            return 0;
+        }
+    }
+
+    return length;
+}
+
+/*hands every complete frame in mBuffer over and keeps a partial one at the
+  start of the buffer for the next bytes*/
+static void UARTCmdDispatcher_parse( void )
+{
+    xHMISrvEventParams srv_parms = {xHMI_EVENT_UART, USER_EVENT_UNDEFINED };
+    uint16 length;
+
+    while ( mLength > 0 )
+    {
+        if ( ( *( pPackage + 0 ) != FAC_HEADER ) && ( *( pPackage + 0 ) != CTRL_HEADER ) )
         {
-            if ( UARTLowLevel_readData(VIRTUAL_PORT, pPackage, data_len ) == data_len )
-            {
-                if(*( pPackage + 0 ) == FAC_HEADER ) /*it could be factroy command header*/
-                {
-                    if (*( pPackage + 2 ) == data_len )
-                    {
 #if ( configAPP_UART_CTRL == 1)
-                        pFMD_ObjCtrl->Transfer2Task( pPackage );
+            if ( mResync == FALSE )
+            {
+                srv_parms.event = UartCmdDispatcher_UserEventHandle(*pPackage);
+                pHS_ObjCtrl->SendEvent( &srv_parms );
+            }
 #endif
-                    }
-                }
-				else if (*( pPackage + 0 ) == CTRL_HEADER )
-				{
-					pCtrlCmd_ObjCtrl->control_command( *( pPackage + 1 ),  ( pPackage + 2 ) );
-				}
-                else
-                {
+            UARTCmdDispatcher_discard( 1 );
+            continue;
+        }
+
+        length = UARTCmdDispatcher_frameLength( );
+        if ( length == 0 )
+        {
+            /*not a frame header after all; look for the next one*/
+            mResync = TRUE;
+            UARTCmdDispatcher_discard( 1 );
+            continue;
+        }
+
+        if ( mLength < length )
+        {
+            /*wait for the rest of the frame*/
+            break;
+        }
+
+        if ( *( pPackage + 0 ) == FAC_HEADER )
+        {
+            /*the checksum is left to the factory handler, which answers a bad one with checksum NG*/
 #if ( configAPP_UART_CTRL == 1)
-                    srv_parms.event = UartCmdDispatcher_UserEventHandle(*pPackage);
-                    pHS_ObjCtrl->SendEvent( &srv_parms );
+            pFMD_ObjCtrl->Transfer2Task( pPackage );
 #endif
-                }
-            }
+        }
+        else
+        {
+            pCtrlCmd_ObjCtrl->control_command( *( pPackage + CTRL_OPCODE_POS ), ( pPackage + CTRL_OPCODE_POS + 1 ) );
+        }
 
+        mResync = FALSE;
+        UARTCmdDispatcher_discard( length );
+    }
+
+    if ( mLength == 0 )
+    {
+        mResync = FALSE;
+    }
+}
+
+void UARTCmdDispatcher_poll( void *data )
+{
+    for( ;; )
+    {
+        /*sleep until the VCP delivers data; a partial frame only waits so long*/
+        if ( UARTLowLevel_waitData( ( mLength > 0 ) ? WAIT_TIMEOUT : portMAX_DELAY ) )
+        {
+            mLength += UARTLowLevel_readData( VIRTUAL_PORT, ( pPackage + mLength ), ( PACKAGE_MAX - mLength ) );
         }
-        vTaskDelay( UART_TIME_TICK );
+        else if ( mLength > 0 )
+        {
+            mResync = TRUE;
+            UARTCmdDispatcher_discard( 1 );
+        }
+
+        UARTCmdDispatcher_parse( );
     }
 }
 
@@ -687,6 +687,7 @@ typedef enum
     STORAGE_DEVICE_CELL_PROGRAM_KEY_VOLUME_UP,
     STORAGE_DEVICE_CELL_PROGRAM_KEY_VOLUME_DN,
     STORAGE_DEVICE_CELL_PROGRAM_KEY_VOLUME_MUTE,
+    STORAGE_DEVICE_CELL_USER_JOURNAL_SEQ,
     STORAGE_DEVICE_CELL_END
 }STORAGE_DEVICE_CELL;
 
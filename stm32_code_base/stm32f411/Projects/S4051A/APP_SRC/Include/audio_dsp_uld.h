@@ -15,6 +15,9 @@
 #include "../App_SRC/Include/s4051_dsp_sdram_uld/pcm_initial.h"
 #include "../App_SRC/Include/s4051_dsp_sdram_uld/api_doc.h"
 #include "../App_SRC/Include/s4051_dsp_sdram_uld/ULD_Location.h"
+#if ( configCS4953x_CFG_ULZ == 1 )
+#include "../App_SRC/Include/s4051_dsp_sdram_uld/cfg_ulz.h"
+#endif
 #endif
 
 #elif defined ( S4551A ) 
@@ -27,6 +30,9 @@
 #include "../App_SRC/Include/s4551_dsp_sdram_uld/pcm_initial.h"
 #include "../App_SRC/Include/s4551_dsp_sdram_uld/api_doc.h"
 #include "../App_SRC/Include/s4551_dsp_sdram_uld/ULD_Location.h"
+#if ( configCS4953x_CFG_ULZ == 1 )
+#include "../App_SRC/Include/s4551_dsp_sdram_uld/cfg_ulz.h"
+#endif
 #endif
 
 #else
@@ -6,6 +6,9 @@
 #define configSTM32F411_PORTING 0
 
 #define configRTOS_DEBUG 0
+#define configDEBUG_DEFERRED 1 /*TRACE_* only queues a record, a low priority task prints it*/
+#define configDEBUG_LATENCY 0 /*DWT cycle counter probes print input switch, volume step, ULD load and power up latency*/
+#define configDEBUG_TASK_SWITCH 0 /*the drain task prints the context switches per second, needs configDEBUG_DEFERRED*/
 #define configAPP_UART_CTRL 0
 #define configAPP_ASH 1
 #define configAPP_USB_WAV_PLAYER 1 /*TODO*/
@@ -14,6 +17,8 @@
 #define configAPP_UDM 1
 #define configAPP_APD 1
 #define configAPP_AID 1
+#define configHMI_EVENT_DRIVEN 1 /*HMI service sleeps on its queue, APD/AID checks run on software timers*/
+#define configPOWER_BOOT_SEQUENCER 1 /*power up stages wait for the stages they depend on plus a settle time, not fixed delays*/
 #define configAPP_IR_REMOTE 1 
 #define configAPP_BTN_CTRL 1
 #define configAPP_DEV_SII9533 1
@@ -24,6 +29,11 @@
 #define configAPP_AUDIO_301 0
 #define configAPP_STORAGE_MANAGER 1 /*for EEPROM */
 
+#if ( configAPP_STORAGE_MANAGER == 1 )
+#define configSTORAGE_JOURNAL 1 /*user parameters are journaled, only changed bytes reach the EEPROM*/
+#define configSTORAGE_JOURNAL_DELAY 3000 /*msec a parameter has to stay unchanged before it is written*/
+#endif
+
 #if ( configAPP_INTERNAL_DSP_ULD == 0 )
 #define configAPP_SPI_FLASH_DSP_ULD 1 
 #endif
@@ -32,14 +42,32 @@
 #define configSPI_FLASH 1
 #endif
 
+#if ( configAPP_SPI_FLASH_DSP_ULD == 1 )
+#define configCS4953x_ULD_DMA 1 /*ULD is streamed through two buffers, the next flash block (SPI DMA) is read while the DSP holds /BUSY*/
+#define configSPI_DMA 1
+#define configCS4953x_ULD_CACHE 1 /*keep small ULD segments in SRAM between format switches*/
+#endif
+
+#if ( configSPI_DMA == 1 )
+#define configSPI_FLASH_DMA 1 /*flash data phases by SPI DMA, program/erase busy time is slept with the SPI bus released*/
+#endif
+
+#if ( configAPP_USB_VCP == 1 )
+#define configUART_RX_BUFFER_SIZE 256 /*VCP receive ring, power of two*/
+#define configUART_RX_OVERRUN_COUNT 1 /*count bytes dropped on a full ring*/
+#endif
+
 #if ( configAPP_USB_WAV_PLAYER == 1 )
 #define configUSB_WAV_PLAYER 1
+#define configUSB_WAV_CIRCULAR_DMA 1 /*one circular I2S DMA buffer, the reader refills the half freed by HT/TC*/
+#define configUSB_MEDIA_INDEX 1 /*USB wave list is kept as 8.3 entries in the SPI flash, keyed by the volume serial*/
 #else
 #define configUSB_WAV_PLAYER 0
 #endif 
 
 #if ( configAPP_IR_REMOTE == 1 )
 #define configIR 1
+#define configIR_STREAM_DECODER 1 /*IR protocols are decoded edge by edge, a key is sent at the end of its frame*/
 #endif 
 
 #define configDSP_SRAM 1
@@ -49,10 +77,16 @@
 #define configDAP_TAS5707 0 /*for LR channel*/
 #define configDAP_TAS5713 1 /*for center*/
 #define configCS4953x 1
+#define configCS4953x_CFG_ULZ 1 /*configuration tables packed by EWARM/uld_pack.py*/
 #define configCS8422 1
 #define configEEPROM 1
+#define configHT68F30_FRAME_FLUSH 1 /*light bar frames are built in RAM, only the changed duty registers are written*/
 #define configSII_DEV_9535 0    //SII_DEV_9535
 
+#if ( configHT68F30_FRAME_FLUSH == 1 )
+#define configHT68F30_I2C_BURST 0 /*needs light bar firmware with duty register auto increment, a dirty run is one I2C write*/
+#endif
+
 #if ( configEEPROM ==  1 )
 #define configEEPROM_512 1
 #else
@@ -61,15 +95,25 @@
 
 #if ( configCS8422 == 1 )
 #define configCS8422_ISR 1
+#define configCS8422_EVENT_DETECTOR 1 /*signal/digital detectors run on the CS8422 INT instead of polling the SRC*/
 #endif 
 
+#define configI2C2_SCRIPT 1 /*DAP/SRC/ADC init sequences run as register scripts from the I2C3 irqs*/
+
+#if ( configCS4953x == 1 )
+#define configCS4953x_IRQ_ISR 1 /*SCP1 IRQ (PC2) on EXTI2 wakes the FCH detector*/
+#endif
+
 #define errSII_DEV_953x_PORTING_BUILD_ERROR 0
 #define configSII_DEV_953x_PORTING 1
 #define configSII_DEV_953x_PORTING_CBUS 0 /*Smith modify: We could not support CBUS (MHL) */
 #define configRTOS_TIMER 1
+#define configVIRTUAL_TIMER_TICKLESS 1 /*TIM3 counts the 50us VirtualTimer ticks, its ISR only runs on the counter overflow*/
 
 #if ( configSII_DEV_953x_PORTING == 1 )
 #define configSIL953x_ISR 1
+#define configSII_CRA_CACHE 1 /*shadow copy of the MCU owned SiI953x registers, see g_siiRegCacheable*/
+#define configSII953x_INT_WAKEUP 1 /*SiI953x INT (EXTI1) wakes the repeater task, 50 ms polling becomes a slow heartbeat*/
 #else
 #error "sil953x driver has not been enabled"	
 #endif
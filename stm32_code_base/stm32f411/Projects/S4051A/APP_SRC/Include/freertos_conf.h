@@ -14,10 +14,12 @@
 #define configLIB_VIRUTAL_TIMER_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 1 )
 #define configLIB_IR_DECODE_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 2 )
 #define configLIB_CS8422_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 3 )
+#define configLIB_CS4953x_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 3 )
 #define configLIB_MSC_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 4 )
 #define configLIB_I2C_DMA_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 5 )
 #define configLIB_AUDIO_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 6 )
 #define configLIB_SIL9535_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 7 )
+#define configLIB_SPI_DMA_INTERRUPT_PRIORITY (configLIBRARY_KERNEL_INTERRUPT_PRIORITY - 8 )
 
 
 
@@ -42,9 +42,12 @@ typedef enum{
 #define tskCS49844_LowLevelDetection_PRIORITY ( tskIDLE_PRIORITY )
 #define tskADM_SIGNAL_DETECTOR_PRIORITY ( tskIDLE_PRIORITY )
 #define tskADM_DIGITAL_DETECTOR_PRIORITY ( tskIDLE_PRIORITY )
+#define tskADM_SRC_DETECTOR_PRIORITY ( tskIDLE_PRIORITY+1 )
 #define tskHMI_APC_PRIORITY (tskIDLE_PRIORITY)
 #define tskUI_PRIORITY (tskIDLE_PRIORITY)
 #define tskH68F30_PRIORITY (tskIDLE_PRIORITY)
+#define tskDEBUG_DRAIN_PRIORITY (tskIDLE_PRIORITY)
+#define tskSTORAGE_JOURNAL_PRIORITY (tskIDLE_PRIORITY)
 
 #define tskHMI_SERVICE_PRIORITY (tskIDLE_PRIORITY+1)
 #define tskFCI_SERVICE_PRIORITY (tskIDLE_PRIORITY+1)
@@ -0,0 +1,384 @@
+#ifndef __CFG_ULZ_H__
+#define __CFG_ULZ_H__
+
+/***********************************************
+This file is created by EWARM/uld_pack.py, do not edit.
+ULZ packed copies of the configuration tables, see cs49844_ulz.h
+************************************************/
+
+/* preKickStart.h: 260 bytes packed from 528 */
+static const uint8 code PREKICKSTART_CFG_ULZ[] = 
+{
+  0x10, 0x02, 0x00, 0x00, 0x0b, 0x12, 0x00, 0x00, 0x9b, 0x02, 0x00, 0x00, 0x00, 0xee, 0xff, 0xff,
+  0xe6, 0x80, 0x06, 0x04, 0x00, 0x5c, 0x00, 0x00, 0xff, 0x81, 0x00, 0x80, 0x17, 0x01, 0x00, 0x7f,
+  0x80, 0x18, 0x08, 0x92, 0xff, 0xff, 0x00, 0x80, 0xfd, 0xff, 0xff, 0x54, 0x80, 0x17, 0x00, 0x05,
+  0x80, 0x13, 0x17, 0xcc, 0xff, 0x7f, 0x00, 0xfb, 0xff, 0xfe, 0xff, 0x00, 0x00, 0xc0, 0xff, 0x00,
+  0x1f, 0x01, 0x01, 0x01, 0x00, 0x40, 0x00, 0x00, 0xe1, 0xfe, 0xfe, 0xb5, 0x0f, 0x08, 0xfc, 0xff,
+  0x3f, 0x00, 0xff, 0xe0, 0xdf, 0xfe, 0x01, 0x81, 0x7c, 0x80, 0x00, 0x95, 0x07, 0x06, 0xfc, 0xff,
+  0xbf, 0xff, 0x01, 0x00, 0x30, 0x96, 0x1f, 0x87, 0x07, 0x05, 0xc0, 0xff, 0x10, 0xd1, 0xf8, 0x0f,
+  0x81, 0xd3, 0x04, 0xf0, 0x3e, 0xf7, 0xef, 0xd9, 0x80, 0xbf, 0x0a, 0x02, 0xf0, 0xff, 0xff, 0x2c,
+  0x00, 0x80, 0xff, 0xfd, 0xdf, 0xff, 0x80, 0x43, 0x83, 0x00, 0x00, 0xfe, 0x81, 0x4f, 0x80, 0x8a,
+  0x00, 0x12, 0x80, 0x2f, 0x01, 0x11, 0x57, 0x87, 0x3f, 0x00, 0xee, 0x80, 0xdf, 0x01, 0x7e, 0x88,
+  0x80, 0x34, 0x80, 0x17, 0x00, 0x91, 0x80, 0x0f, 0x00, 0x04, 0x80, 0x07, 0x01, 0xe1, 0xff, 0x87,
+  0x37, 0xad, 0x07, 0x00, 0xf5, 0x81, 0xdf, 0x00, 0x06, 0x87, 0x0f, 0x00, 0xff, 0x81, 0x0f, 0x00,
+  0xe8, 0x87, 0x4f, 0x00, 0xd3, 0x80, 0x6f, 0x01, 0x01, 0x10, 0x82, 0x0a, 0x00, 0x31, 0x84, 0x13,
+  0x82, 0x06, 0x80, 0x04, 0x00, 0x21, 0x85, 0x0c, 0x00, 0x9e, 0x84, 0x07, 0x00, 0x6c, 0x80, 0x87,
+  0x00, 0x07, 0x80, 0x92, 0x03, 0xf5, 0xff, 0x9f, 0x0f, 0xa3, 0x7f, 0x01, 0x60, 0xf0, 0x8b, 0x0f,
+  0x00, 0xa0, 0x84, 0x37, 0x85, 0x17, 0x02, 0x20, 0x00, 0xed, 0x80, 0x53, 0x02, 0x00, 0x01, 0xe0,
+  0x83, 0x8f, 0x80, 0x0b,
+};
+
+/* ac3_initial.h: 1927 bytes packed from 5248 */
+static const uint8 code AC3_INITIAL_CFG_ULZ[] = 
+{
+  0x80, 0x14, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x9b, 0x01, 0x80, 0x04, 0x81, 0x03, 0x00, 0xff,
+  0x80, 0x00, 0x81, 0x07, 0x00, 0x04, 0x84, 0x0f, 0x00, 0xfd, 0x84, 0x0f, 0x8d, 0x03, 0x00, 0x03,
+  0x8c, 0x0f, 0x00, 0xfe, 0x84, 0x27, 0x03, 0xfb, 0xff, 0xff, 0x07, 0x81, 0x07, 0x81, 0x00, 0xa4,
+  0x07, 0x00, 0xf8, 0x85, 0x43, 0x04, 0xf2, 0xff, 0xff, 0xe5, 0x06, 0x84, 0x0b, 0x00, 0xf9, 0x80,
+  0x4f, 0x00, 0x02, 0x88, 0x5f, 0x81, 0x00, 0x81, 0x0f, 0x01, 0x7f, 0xbb, 0x83, 0x07, 0x01, 0x87,
+  0x44, 0x83, 0x6f, 0x81, 0x27, 0x00, 0x07, 0x83, 0x12, 0x82, 0x27, 0x85, 0x33, 0x85, 0xc7, 0x85,
+  0x17, 0x85, 0x57, 0x85, 0x0f, 0x00, 0xfc, 0x8c, 0xd7, 0x00, 0x08, 0x8c, 0xcf, 0x80, 0xc7, 0x92,
+  0xf7, 0x91, 0xff, 0x03, 0xdf, 0xff, 0xff, 0x0c, 0x85, 0x77, 0x00, 0xf0, 0x8c, 0x37, 0x03, 0xfd,
+  0xff, 0xff, 0x7f, 0x85, 0x77, 0x00, 0x1c, 0x83, 0x13, 0x00, 0x80, 0x81, 0x0f, 0x03, 0x20, 0x56,
+  0x2a, 0x1e, 0x89, 0x8f, 0x85, 0x07, 0x03, 0x20, 0x61, 0x8a, 0x16, 0x81, 0x07, 0x02, 0xc0, 0x91,
+  0x96, 0x82, 0x07, 0x03, 0x00, 0xb7, 0xb4, 0xb4, 0x81, 0x07, 0x03, 0x40, 0xb7, 0xb4, 0x34, 0x82,
+  0x17, 0x02, 0x48, 0x4b, 0xcb, 0x82, 0x17, 0x02, 0x49, 0x4b, 0x4b, 0x82, 0xe7, 0x00, 0xb6, 0x83,
+  0x17, 0x85, 0x57, 0x8d, 0x4f, 0x80, 0x8e, 0x82, 0x7f, 0x99, 0x1f, 0x03, 0xce, 0xff, 0xff, 0x4a,
+  0x80, 0x0b, 0x00, 0xc0, 0x84, 0x17, 0x85, 0x07, 0x8a, 0x27, 0xa8, 0x07, 0x00, 0x40, 0xff, 0x47,
+  0xff, 0x47, 0xff, 0x47, 0xee, 0x47, 0xf6, 0x07, 0x00, 0x09, 0x80, 0x03, 0x03, 0x60, 0x13, 0x3d,
+  0x14, 0x81, 0x0f, 0x03, 0xe0, 0xf1, 0x11, 0xfa, 0x81, 0x07, 0x03, 0xc0, 0xfa, 0xb0, 0xf1, 0x81,
+  0x07, 0x03, 0x40, 0x05, 0x4f, 0x0e, 0x91, 0x37, 0x85, 0x1f, 0x8d, 0x17, 0x85, 0x2f, 0x03, 0x20,
+  0x0e, 0xee, 0x05, 0x89, 0x4f, 0x8d, 0x37, 0x85, 0x27, 0x95, 0x47, 0xed, 0x07, 0x85, 0x03, 0x00,
+  0xff, 0x80, 0x00, 0x03, 0x7f, 0xff, 0xff, 0x04, 0x90, 0x17, 0x00, 0x03, 0x84, 0x07, 0x00, 0x7b,
+  0x8c, 0x37, 0x00, 0x90, 0x84, 0x07, 0x00, 0xf0, 0x89, 0x17, 0x03, 0x7f, 0xc4, 0x20, 0x20, 0x81,
+  0x07, 0x03, 0xf8, 0x4f, 0x8d, 0xe7, 0x81, 0x07, 0x03, 0x89, 0xeb, 0x51, 0xf8, 0x82, 0x17, 0x02,
+  0x99, 0x99, 0x59, 0x81, 0x07, 0x03, 0x80, 0x99, 0x99, 0x19, 0x82, 0x2f, 0x0a, 0x9a, 0x99, 0xd9,
+  0xf3, 0xff, 0xff, 0xd2, 0x01, 0x33, 0x33, 0xb3, 0x85, 0x7f, 0x89, 0x47, 0x00, 0x09, 0x84, 0x07,
+  0x00, 0xf8, 0x84, 0x17, 0x00, 0x07, 0x84, 0x0f, 0x00, 0xf9, 0x84, 0x0f, 0x03, 0x7f, 0x66, 0x66,
+  0x26, 0x81, 0x07, 0x03, 0x81, 0x99, 0x99, 0xd9, 0x89, 0x0f, 0x80, 0x5f, 0x82, 0x0f, 0x00, 0x80,
+  0x8c, 0x1f, 0x85, 0x03, 0x00, 0x7e, 0x9c, 0x17, 0x03, 0xc0, 0xcc, 0xcc, 0x0c, 0x81, 0x07, 0x03,
+  0xbf, 0xcc, 0xcc, 0x4c, 0x84, 0x1b, 0x00, 0xc0, 0x84, 0x97, 0x85, 0x07, 0x86, 0x33, 0x89, 0x0f,
+  0x9d, 0x07, 0x80, 0xb6, 0x00, 0x3f, 0x89, 0x07, 0x03, 0x01, 0xfa, 0x7e, 0xda, 0x82, 0x1f, 0x02,
+  0x06, 0x81, 0xa5, 0x85, 0x27, 0x00, 0x02, 0x84, 0x07, 0x02, 0xdd, 0xff, 0xff, 0x8e, 0x5f, 0x85,
+  0x03, 0x00, 0xfe, 0x84, 0x3f, 0x88, 0xdf, 0x00, 0x99, 0x84, 0x57, 0x00, 0x5f, 0x84, 0x23, 0x00,
+  0xa0, 0x81, 0x07, 0x0c, 0x3f, 0x33, 0x33, 0x33, 0xf8, 0xff, 0xff, 0x20, 0x5f, 0xcd, 0xcc, 0x4c,
+  0x04, 0x80, 0x0f, 0x03, 0x61, 0xff, 0xff, 0x7f, 0x84, 0x4f, 0x00, 0x80, 0x83, 0x07, 0x00, 0x80,
+  0x84, 0x0f, 0x00, 0x80, 0xc6, 0x0f, 0x00, 0x15, 0x80, 0x05, 0x02, 0xed, 0xd3, 0x85, 0x82, 0x0f,
+  0x03, 0x43, 0x5f, 0x2d, 0x85, 0x81, 0x07, 0x03, 0x90, 0x80, 0x43, 0x0c, 0x81, 0x07, 0x03, 0x1a,
+  0xff, 0x8c, 0x6e, 0x81, 0x07, 0x03, 0x26, 0x4d, 0xfc, 0x83, 0x81, 0x07, 0x03, 0x40, 0x3c, 0x3d,
+  0x10, 0x81, 0x07, 0x03, 0x18, 0xeb, 0x00, 0x6c, 0x82, 0x0f, 0x01, 0x72, 0x5b, 0x82, 0x2f, 0x03,
+  0x48, 0xbf, 0xbd, 0xeb, 0x81, 0x07, 0x03, 0x20, 0xf7, 0x32, 0x91, 0x81, 0x07, 0x03, 0x60, 0x16,
+  0xdc, 0x87, 0x82, 0x0f, 0x02, 0xae, 0x47, 0xe2, 0x82, 0x57, 0x02, 0x49, 0x0b, 0x94, 0x81, 0x07,
+  0x03, 0x09, 0x6f, 0x13, 0x82, 0x81, 0x07, 0x03, 0xf4, 0x3c, 0x18, 0x04, 0x82, 0x3f, 0x02, 0x6e,
+  0x85, 0x7c, 0x81, 0x07, 0x03, 0xd0, 0x54, 0x62, 0x81, 0x81, 0x07, 0x03, 0xf0, 0x70, 0x09, 0xf0,
+  0x81, 0x07, 0x03, 0xa8, 0x58, 0x99, 0x8e, 0x81, 0x07, 0x02, 0xd8, 0x9c, 0xc3, 0x82, 0x4f, 0x03,
+  0x8a, 0xfe, 0x45, 0xea, 0x81, 0x07, 0x02, 0x36, 0xde, 0xad, 0x82, 0xa7, 0x03, 0xa0, 0x89, 0x72,
+  0x89, 0x81, 0x07, 0x03, 0x7e, 0x9f, 0x28, 0xf8, 0x81, 0x07, 0x02, 0xba, 0x22, 0x83, 0x82, 0xd7,
+  0x02, 0xf4, 0x70, 0x87, 0x82, 0x47, 0x03, 0x04, 0xde, 0x22, 0xf3, 0x81, 0x07, 0x03, 0xf9, 0x4a,
+  0x15, 0x8a, 0x81, 0x07, 0x03, 0xd7, 0xa3, 0x94, 0x95, 0x81, 0x07, 0x02, 0xa9, 0x91, 0xf4, 0x82,
+  0x47, 0x02, 0xa3, 0xd2, 0x15, 0x82, 0x27, 0x02, 0xac, 0x9b, 0xf5, 0x82, 0xbf, 0x03, 0x88, 0x75,
+  0x91, 0xe1, 0x81, 0x07, 0x03, 0xe0, 0xf0, 0xd4, 0x96, 0x81, 0x07, 0x80, 0x00, 0x82, 0x67, 0x81,
+  0x00, 0x82, 0x07, 0x01, 0x40, 0x1f, 0x83, 0x0f, 0x01, 0xc0, 0xe0, 0x82, 0xd7, 0x80, 0x00, 0x00,
+  0x08, 0x84, 0x07, 0x00, 0x70, 0x92, 0x2f, 0x87, 0x0f, 0x8c, 0x47, 0x00, 0x9c, 0x84, 0x47, 0x00,
+  0x63, 0x82, 0x77, 0x80, 0x00, 0x82, 0x8f, 0x02, 0x00, 0x80, 0xb5, 0x82, 0xe7, 0x02, 0x00, 0x80,
+  0x4a, 0x82, 0xaf, 0x86, 0x2f, 0x02, 0xe0, 0xdd, 0x74, 0x82, 0x07, 0x02, 0x20, 0x22, 0x8b, 0x84,
+  0x17, 0x00, 0xd4, 0x83, 0x17, 0x01, 0x12, 0xa3, 0x83, 0x17, 0x01, 0xed, 0x88, 0x84, 0x17, 0x00,
+  0xb8, 0x82, 0x07, 0x02, 0x60, 0x27, 0xbc, 0x82, 0x07, 0x02, 0xa0, 0xd8, 0x8f, 0x84, 0x17, 0x00,
+  0xe4, 0x83, 0x07, 0x01, 0x1a, 0x90, 0x83, 0x07, 0x01, 0xe6, 0x7f, 0x84, 0x17, 0x00, 0xf0, 0x84,
+  0x07, 0x00, 0x8c, 0x91, 0xa7, 0x02, 0x33, 0xd3, 0x05, 0x82, 0x0f, 0x02, 0xfd, 0x5f, 0x2d, 0x82,
+  0xa7, 0x03, 0x10, 0xae, 0x47, 0x0c, 0x81, 0x07, 0x03, 0xf3, 0xd1, 0x88, 0x6e, 0x81, 0x07, 0x03,
+  0xcd, 0x4c, 0xfc, 0x83, 0x81, 0x07, 0x03, 0xa0, 0x70, 0x3d, 0x10, 0x81, 0x07, 0x03, 0x60, 0xaf,
+  0x00, 0x6c, 0x81, 0x07, 0x02, 0x98, 0x79, 0x5b, 0x82, 0x2f, 0x03, 0x58, 0x8f, 0xc2, 0xeb, 0x82,
+  0x37, 0x01, 0x27, 0x2e, 0x82, 0xd7, 0x03, 0x60, 0x16, 0xdc, 0x87, 0x81, 0x07, 0x03, 0x20, 0xae,
+  0x47, 0xe2, 0x81, 0x07, 0x03, 0x80, 0x4b, 0x0b, 0x94, 0x81, 0x07, 0x03, 0xcc, 0x6c, 0x13, 0x82,
+  0x81, 0x07, 0x03, 0xe4, 0x7a, 0x14, 0x04, 0x81, 0x07, 0x03, 0x50, 0x38, 0x89, 0x7c, 0x81, 0x07,
+  0x03, 0xd0, 0x4c, 0x62, 0x81, 0x81, 0x07, 0x02, 0x70, 0x3d, 0x0a, 0x82, 0xa7, 0x03, 0xc0, 0x85,
+  0x98, 0x8e, 0x81, 0x07, 0x02, 0x40, 0xa3, 0xc3, 0x82, 0x4f, 0x03, 0xbe, 0xa1, 0x45, 0xea, 0x81,
+  0x07, 0x02, 0x02, 0x3b, 0xae, 0x82, 0xa7, 0x03, 0xa0, 0x89, 0x72, 0x89, 0x81, 0x07, 0x03, 0xbc,
+  0xf5, 0x28, 0xf8, 0x81, 0x07, 0x02, 0xa4, 0xd0, 0x82, 0x82, 0xe7, 0x02, 0xcc, 0x6c, 0x87, 0x82,
+  0x47, 0x03, 0x54, 0xb8, 0x1e, 0xf3, 0x81, 0x07, 0x03, 0x46, 0x71, 0x19, 0x8a, 0x81, 0x07, 0x03,
+  0x3a, 0xa3, 0x94, 0x95, 0x81, 0x07, 0x02, 0x64, 0xbc, 0xf4, 0x82, 0x47, 0x02, 0xfc, 0xa9, 0x15,
+  0x82, 0x27, 0x02, 0x98, 0x99, 0xf5, 0x82, 0xbf, 0x03, 0x28, 0x5c, 0x8f, 0xe1, 0x82, 0x6f, 0x02,
+  0x4a, 0xf6, 0x96, 0x81, 0x07, 0x02, 0x00, 0xc0, 0xe0, 0x82, 0xbf, 0x80, 0x00, 0x82, 0xa7, 0x03,
+  0x00, 0x80, 0xc5, 0x74, 0x83, 0x07, 0x00, 0x3a, 0x85, 0x17, 0x00, 0xe8, 0x84, 0x07, 0x00, 0x90,
+  0x84, 0x07, 0x82, 0x97, 0x81, 0x00, 0x83, 0x27, 0x00, 0xb5, 0x82, 0x5f, 0x02, 0x00, 0x80, 0x4a,
+  0x82, 0x7f, 0x86, 0x17, 0x02, 0xe0, 0x12, 0x77, 0x82, 0x07, 0x02, 0x20, 0xed, 0x88, 0x84, 0x17,
+  0x00, 0xcc, 0x83, 0x27, 0x01, 0x07, 0xa8, 0x83, 0x07, 0x01, 0xf8, 0x83, 0x84, 0x17, 0x00, 0x08,
+  0x84, 0x07, 0x83, 0x77, 0x8d, 0x5f, 0x87, 0x0f, 0xd3, 0x17, 0x01, 0x40, 0x1f, 0x83, 0x0f, 0x01,
+  0xc0, 0xe0, 0x85, 0xef, 0x00, 0x04, 0x83, 0x9f, 0x00, 0xc5, 0x83, 0x8f, 0x01, 0x80, 0x3a, 0x85,
+  0x17, 0x00, 0xe8, 0x84, 0x07, 0x00, 0x90, 0x92, 0x47, 0x02, 0x80, 0xb5, 0x81, 0x83, 0x07, 0x01,
+  0x4a, 0x8a, 0x8a, 0x17, 0x02, 0xe0, 0x12, 0x77, 0x82, 0x07, 0x02, 0x20, 0xed, 0x88, 0x84, 0x17,
+  0x00, 0xcc, 0x83, 0x27, 0x01, 0x07, 0xa8, 0x83, 0x07, 0x01, 0xf8, 0x83, 0x84, 0x17, 0x00, 0x08,
+  0x84, 0x07, 0x83, 0x77, 0xd5, 0xef, 0x94, 0x17, 0x02, 0x66, 0xd6, 0x01, 0x82, 0x0f, 0x02, 0x9a,
+  0x29, 0xfe, 0x83, 0x8f, 0x02, 0x41, 0x2b, 0x11, 0x81, 0x07, 0x03, 0xd7, 0xc8, 0xdb, 0x6a, 0x81,
+  0x07, 0x01, 0x29, 0xf6, 0x83, 0xa7, 0x03, 0x80, 0xb1, 0xc5, 0x10, 0x82, 0x07, 0x02, 0x3e, 0x40,
+  0x6b, 0x82, 0x27, 0x02, 0x10, 0xfa, 0x97, 0x84, 0x47, 0x00, 0xe8, 0x81, 0x07, 0x02, 0xe2, 0xa4,
+  0x03, 0x82, 0x47, 0x02, 0x4e, 0xb7, 0x8b, 0x82, 0xef, 0x03, 0xc0, 0xcb, 0xfa, 0xfa, 0x81, 0x07,
+  0x03, 0x10, 0xd8, 0x75, 0x7c, 0xf1, 0xd7, 0xa9, 0x17, 0x04, 0x16, 0xff, 0xff, 0xfe, 0x3f, 0x84,
+  0x1f, 0x03, 0xc1, 0xff, 0xff, 0xff, 0x8c, 0x2f, 0xda, 0x07, 0x80, 0x6e, 0x00, 0x7f, 0xa1, 0x27,
+  0x80, 0x03, 0x86, 0xaf, 0x04, 0xeb, 0xff, 0xff, 0x04, 0x01, 0x80, 0x0c, 0x00, 0x02, 0x80, 0x0b,
+  0x02, 0x32, 0x32, 0x33, 0x82, 0x1f, 0x01, 0x66, 0x66, 0x83, 0x27, 0x01, 0x9a, 0x99, 0x83, 0xbf,
+  0x02, 0x33, 0x33, 0xe1, 0x8a, 0xc7, 0x02, 0x9a, 0x99, 0xeb, 0x8e, 0xd7, 0x05, 0xbf, 0x00, 0x00,
+  0x17, 0xb8, 0x0b, 0x83, 0x0f, 0x02, 0x41, 0x44, 0x91, 0x82, 0x07, 0x04, 0xe3, 0x4c, 0x39, 0x7e,
+  0xf6, 0x80, 0x94, 0x03, 0xdc, 0x6e, 0x35, 0x81, 0x89, 0x17, 0x03, 0x99, 0x94, 0x68, 0x08, 0x81,
+  0x6f, 0x03, 0x26, 0x27, 0x06, 0xf7, 0x89, 0x17, 0x04, 0x07, 0xb0, 0x6e, 0x07, 0xee, 0x80, 0x2f,
+  0x80, 0x47, 0x00, 0xf8, 0x89, 0x17, 0x03, 0x71, 0x36, 0x83, 0x5e, 0x85, 0x67, 0x00, 0xf1, 0x80,
+  0x1f, 0x03, 0x4e, 0x85, 0xeb, 0xa0, 0x8d, 0x37, 0x85, 0x1f, 0x00, 0x03, 0x80, 0x03, 0x8d, 0x3f,
+  0x89, 0x1f, 0x00, 0x23, 0x90, 0x1f, 0x03, 0x82, 0xc0, 0x50, 0x17, 0x81, 0xa7, 0x03, 0x3d, 0xfb,
+  0x1d, 0xe8, 0x8d, 0x37, 0x00, 0xec, 0x90, 0x8f, 0x03, 0x72, 0xb8, 0xbc, 0x3a, 0x85, 0x4f, 0x00,
+  0x71, 0x80, 0x1f, 0x03, 0x4d, 0x03, 0xb2, 0xc4, 0x8c, 0x37, 0x00, 0xff, 0x85, 0x1f, 0x9d, 0x07,
+  0x00, 0x9b, 0x80, 0x03, 0x02, 0xf4, 0x3d, 0x03, 0x82, 0x0f, 0x02, 0x0c, 0xc2, 0xfc, 0x82, 0x37,
+  0x04, 0xdc, 0x05, 0x00, 0x00, 0x06, 0x80, 0x07, 0x01, 0x18, 0x38, 0x8f, 0x17, 0x00, 0x62, 0x80,
+  0x6f, 0x81, 0x07, 0x8c, 0x6f, 0x00, 0x3f, 0x81, 0x07, 0x03, 0x81, 0xe4, 0x27, 0x3e, 0x81, 0x07,
+  0x03, 0xc5, 0x18, 0xd7, 0x01, 0x81, 0x07, 0x03, 0xbb, 0x02, 0x01, 0x80, 0x81, 0x07, 0x03, 0x34,
+  0x9e, 0x3b, 0x7f, 0x81, 0x07, 0x02, 0x11, 0x5f, 0xc3, 0x82, 0x2f, 0x81, 0x17, 0x00, 0x02, 0x80,
+  0x07, 0x01, 0xb7, 0x0b, 0xdb, 0x47, 0x03, 0xdd, 0xde, 0xd9, 0x3d, 0x81, 0x07, 0x03, 0xfc, 0xc0,
+  0x24, 0x02, 0x81, 0x07, 0x01, 0x28, 0x60, 0x83, 0x47, 0x02, 0xbc, 0x00, 0x1b, 0x82, 0x47, 0x02,
+  0x1c, 0x9f, 0xe3, 0x82, 0x2f, 0x81, 0x17, 0xe1, 0x8f, 0xa9, 0x47, 0x00, 0x7f, 0x80, 0x07, 0x00,
+  0xff, 0x80, 0x00, 0x81, 0x0f, 0x04, 0x49, 0x43, 0x32, 0x04, 0xfc, 0x80, 0x0b, 0x03, 0xb7, 0xbc,
+  0xcd, 0xfb, 0x95, 0x0f, 0x00, 0xf9, 0x8c, 0x0f, 0x82, 0x87, 0x98, 0x1f, 0x00, 0xc3, 0x80, 0x0f,
+  0x03, 0xe7, 0xef, 0x00, 0x03, 0x81, 0x0f, 0x03, 0xd0, 0xcc, 0xcc, 0xf8, 0x81, 0x07, 0x03, 0x15,
+  0xae, 0x47, 0x81, 0x81, 0x07, 0x03, 0x8d, 0xa0, 0xf9, 0x86, 0x81, 0x07, 0x02, 0x68, 0xa2, 0x33,
+  0x82, 0xa7, 0x04, 0xf6, 0x0e, 0x8b, 0xf6, 0xf3, 0x80, 0x2f, 0x03, 0x30, 0x33, 0x33, 0x07, 0xa9,
+  0x2f, 0x02, 0x9c, 0x99, 0x99, 0x82, 0x5f, 0x03, 0x64, 0x66, 0x66, 0xfc, 0x9d, 0x2f, 0x00, 0xeb,
+  0x80, 0x2f, 0x02, 0x66, 0x66, 0x26, 0x82, 0x0f, 0x03, 0x9a, 0x99, 0xd9, 0xfe, 0x9d, 0x2f, 0x00,
+  0x03, 0x80, 0x07, 0xa9, 0x2f, 0x81, 0x5f, 0x02, 0x9a, 0x99, 0x99, 0x82, 0x0f, 0x02, 0x66, 0x66,
+  0x66, 0x8a, 0x2f, 0x02, 0x6e, 0x77, 0x88, 0x82, 0x07, 0x03, 0x87, 0xcb, 0xa4, 0x06, 0x85, 0x2f,
+  0x00, 0xf1, 0x80, 0x2f, 0x03, 0xb8, 0x0b, 0x00, 0x00, 0x81, 0x0f, 0x02, 0x41, 0x44, 0x91, 0x82,
+  0x07, 0x03, 0x07, 0xb0, 0x6e, 0x3f, 0x81, 0x07, 0x03, 0xe4, 0xed, 0xf0, 0x3c, 0x81, 0x07, 0x02,
+  0x6f, 0x43, 0x0c, 0x82, 0xdf, 0x03, 0xae, 0xce, 0x02, 0x80, 0x81, 0x07, 0x03, 0xeb, 0x5a, 0xb9,
+  0x7e, 0x81, 0x07, 0x02, 0x67, 0xd6, 0x43, 0x82, 0x67, 0x81, 0x17, 0x00, 0x8b, 0x80, 0x47, 0x02,
+  0x5b, 0xa9, 0x2b, 0x82, 0x3f, 0x03, 0x19, 0x80, 0xbe, 0x7f, 0x81, 0x07, 0x02, 0x43, 0xe2, 0x15,
+  0x82, 0x2f, 0x04, 0x48, 0xf4, 0xff, 0xff, 0x19, 0x80, 0x07, 0x81, 0x67, 0x03, 0xe3, 0xff, 0xff,
+  0x92, 0x80, 0x0f, 0x00, 0x07, 0x81, 0x17, 0x80, 0x00, 0x00, 0xf8, 0x84, 0x07, 0x82, 0x27, 0x81,
+  0x00, 0xc5, 0x07, 0x00, 0x02, 0x9c, 0x1f,
+};
+
+/* dts_initial.h: 1746 bytes packed from 5064 */
+static const uint8 code DTS_INITIAL_CFG_ULZ[] = 
+{
+  0xc8, 0x13, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x9b, 0x01, 0x80, 0x04, 0x81, 0x03, 0x00, 0xff,
+  0x80, 0x00, 0x81, 0x07, 0x00, 0x04, 0x84, 0x0f, 0x00, 0xfd, 0x84, 0x0f, 0x8d, 0x03, 0x00, 0x03,
+  0x8c, 0x0f, 0x00, 0xfe, 0x84, 0x27, 0x03, 0xfb, 0xff, 0xff, 0x07, 0x81, 0x07, 0x81, 0x00, 0xa4,
+  0x07, 0x00, 0xf8, 0x85, 0x43, 0x04, 0xf2, 0xff, 0xff, 0xe5, 0x06, 0x84, 0x0b, 0x00, 0xf9, 0x80,
+  0x4f, 0x00, 0x02, 0x88, 0x5f, 0x81, 0x00, 0x81, 0x0f, 0x01, 0x7f, 0xbb, 0x83, 0x07, 0x01, 0x87,
+  0x44, 0x83, 0x6f, 0x81, 0x27, 0x00, 0x07, 0x83, 0x12, 0x82, 0x27, 0x85, 0x33, 0x85, 0xc7, 0x85,
+  0x17, 0x85, 0x57, 0x85, 0x0f, 0x00, 0xfc, 0x8c, 0xd7, 0x00, 0x08, 0x8c, 0xcf, 0x80, 0xc7, 0x92,
+  0xf7, 0x91, 0xff, 0x03, 0xdf, 0xff, 0xff, 0x0d, 0x80, 0xbb, 0x00, 0xff, 0x80, 0x0a, 0x00, 0x4a,
+  0x80, 0x06, 0x00, 0x3f, 0x84, 0x67, 0x00, 0xc0, 0xa4, 0xff, 0x95, 0x07, 0x00, 0x40, 0xff, 0x47,
+  0xff, 0x47, 0xff, 0x47, 0xee, 0x47, 0xf6, 0x07, 0x00, 0x09, 0x80, 0x03, 0x03, 0x60, 0x13, 0x3d,
+  0x14, 0x81, 0x0f, 0x03, 0xe0, 0xf1, 0x11, 0xfa, 0x81, 0x07, 0x03, 0xc0, 0xfa, 0xb0, 0xf1, 0x81,
+  0x07, 0x03, 0x40, 0x05, 0x4f, 0x0e, 0x91, 0x37, 0x85, 0x1f, 0x8d, 0x17, 0x85, 0x2f, 0x03, 0x20,
+  0x0e, 0xee, 0x05, 0x89, 0x4f, 0x8d, 0x37, 0x85, 0x27, 0x95, 0x47, 0xed, 0x07, 0x85, 0x03, 0x00,
+  0xff, 0x80, 0x00, 0x03, 0x7f, 0xff, 0xff, 0x04, 0x90, 0x17, 0x00, 0x03, 0x84, 0x07, 0x00, 0x7b,
+  0x8c, 0x37, 0x00, 0x90, 0x84, 0x07, 0x00, 0xf0, 0x89, 0x17, 0x03, 0x7f, 0xc4, 0x20, 0x20, 0x81,
+  0x07, 0x03, 0xf8, 0x4f, 0x8d, 0xe7, 0x81, 0x07, 0x03, 0x89, 0xeb, 0x51, 0xf8, 0x82, 0x17, 0x02,
+  0x99, 0x99, 0x59, 0x81, 0x07, 0x03, 0x80, 0x99, 0x99, 0x19, 0x82, 0x2f, 0x0a, 0x9a, 0x99, 0xd9,
+  0xf3, 0xff, 0xff, 0xd2, 0x01, 0x33, 0x33, 0xb3, 0x85, 0x7f, 0x89, 0x47, 0x00, 0x09, 0x84, 0x07,
+  0x00, 0xf8, 0x84, 0x17, 0x00, 0x07, 0x84, 0x0f, 0x00, 0xf9, 0x84, 0x0f, 0x80, 0x06, 0x00, 0x1f,
+  0x84, 0x7f, 0x00, 0xe0, 0x81, 0x07, 0x00, 0x9f, 0x84, 0x57, 0x03, 0x60, 0x66, 0x66, 0xe6, 0x82,
+  0x67, 0x02, 0x66, 0x66, 0x26, 0x81, 0x07, 0x03, 0x81, 0x99, 0x99, 0xd9, 0x89, 0xcf, 0x03, 0xbe,
+  0xcc, 0xcc, 0x2c, 0x81, 0x07, 0x03, 0x41, 0x33, 0x33, 0xd3, 0x89, 0x17, 0x00, 0x7e, 0x84, 0x2f,
+  0x03, 0xc0, 0xcc, 0xcc, 0x0c, 0x81, 0x07, 0x03, 0xbf, 0xcc, 0xcc, 0x4c, 0x84, 0x1b, 0x00, 0xc0,
+  0x84, 0x97, 0x85, 0x07, 0x86, 0x33, 0x89, 0x0f, 0x9d, 0x07, 0x80, 0xaf, 0x00, 0x3f, 0x89, 0x07,
+  0x03, 0x01, 0xfa, 0x7e, 0xda, 0x82, 0x1f, 0x02, 0x06, 0x81, 0xa5, 0x85, 0x27, 0x00, 0x02, 0x84,
+  0x07, 0x02, 0xdd, 0xff, 0xff, 0x8e, 0x5f, 0x85, 0x03, 0x00, 0xfe, 0x84, 0x3f, 0x88, 0xdf, 0x00,
+  0x99, 0x84, 0x57, 0x00, 0x5f, 0x84, 0x23, 0x00, 0xa0, 0x81, 0x07, 0x0c, 0x3f, 0x33, 0x33, 0x33,
+  0xf8, 0xff, 0xff, 0x20, 0x5f, 0xcd, 0xcc, 0x4c, 0x04, 0x80, 0x0f, 0x03, 0x61, 0xff, 0xff, 0x7f,
+  0x84, 0x4f, 0x00, 0x80, 0x83, 0x07, 0x00, 0x80, 0x84, 0x0f, 0x00, 0x80, 0xc6, 0x0f, 0x00, 0x15,
+  0x80, 0x05, 0x02, 0x33, 0xd3, 0x85, 0x82, 0x0f, 0x03, 0xfd, 0x5f, 0x2d, 0x85, 0x81, 0x07, 0x03,
+  0x10, 0xae, 0x47, 0x0c, 0x81, 0x07, 0x03, 0xf3, 0xd1, 0x88, 0x6e, 0x81, 0x07, 0x03, 0xcd, 0x4c,
+  0xfc, 0x83, 0x81, 0x07, 0x03, 0xa0, 0x70, 0x3d, 0x10, 0x81, 0x07, 0x03, 0x60, 0xcf, 0x5e, 0x6c,
+  0x82, 0x3f, 0x02, 0xc0, 0x63, 0x87, 0x84, 0x9f, 0x00, 0xec, 0x82, 0x07, 0x02, 0xe0, 0xdd, 0x8c,
+  0x82, 0x07, 0x02, 0x20, 0x22, 0x8b, 0x84, 0x17, 0x00, 0xe4, 0x83, 0x07, 0x01, 0x46, 0x90, 0x83,
+  0x07, 0x00, 0xba, 0x82, 0x47, 0x80, 0x00, 0x00, 0xf0, 0x83, 0x2f, 0x01, 0x12, 0x8f, 0x83, 0x2f,
+  0x01, 0xed, 0x88, 0x84, 0x17, 0x00, 0xd4, 0x83, 0x07, 0x01, 0x71, 0xa2, 0x83, 0x07, 0x00, 0x8f,
+  0x82, 0x8f, 0x86, 0x5f, 0x01, 0x40, 0x1f, 0x83, 0x5f, 0x01, 0xc0, 0xe0, 0x85, 0x77, 0x00, 0x08,
+  0x83, 0x17, 0x01, 0x84, 0x74, 0x83, 0x17, 0x00, 0x7b, 0x85, 0x5f, 0x00, 0x04, 0x81, 0x07, 0x02,
+  0x66, 0xf6, 0x04, 0x82, 0x17, 0x03, 0x3a, 0xa3, 0x94, 0x95, 0x81, 0x07, 0x03, 0x64, 0xbc, 0xf4,
+  0xea, 0x81, 0x07, 0x03, 0xfc, 0x29, 0x27, 0x81, 0x82, 0x27, 0x02, 0x80, 0x4a, 0x8a, 0x84, 0x2f,
+  0x00, 0xfc, 0x83, 0x0f, 0x01, 0x11, 0x78, 0x83, 0x07, 0x00, 0xee, 0x85, 0xbf, 0x82, 0x47, 0x80,
+  0x77, 0x00, 0x70, 0x92, 0x77, 0x01, 0x00, 0x00, 0x83, 0x17, 0x80, 0x31, 0x84, 0x07, 0x00, 0x00,
+  0x8c, 0x0f, 0xa3, 0x17, 0x01, 0x80, 0xb5, 0x8d, 0x8f, 0x83, 0x17, 0x01, 0xe0, 0xdd, 0x83, 0xd7,
+  0x01, 0x20, 0x22, 0x85, 0x8f, 0x00, 0xdc, 0x83, 0x17, 0x01, 0x12, 0x9b, 0x83, 0x17, 0x01, 0xed,
+  0x88, 0x84, 0x17, 0x00, 0xd0, 0x82, 0x07, 0x02, 0x60, 0x27, 0xa4, 0x82, 0x07, 0x02, 0xa0, 0xd8,
+  0x8f, 0x84, 0x17, 0x00, 0xe4, 0x83, 0x07, 0x01, 0x1a, 0x90, 0x83, 0x07, 0x01, 0xe6, 0x7f, 0x84,
+  0x17, 0x00, 0xf0, 0x84, 0x07, 0x00, 0x8c, 0x91, 0x8f, 0x02, 0x33, 0xd3, 0x05, 0x82, 0x0f, 0x03,
+  0xfd, 0x5f, 0x2d, 0x85, 0x81, 0x07, 0x03, 0x10, 0xae, 0x47, 0x0c, 0x81, 0x07, 0x03, 0xf3, 0xd1,
+  0x88, 0x6e, 0x81, 0x07, 0x03, 0xcd, 0x4c, 0xfc, 0x83, 0x81, 0x07, 0x03, 0xa0, 0x70, 0x3d, 0x10,
+  0x81, 0x07, 0x03, 0x60, 0xcf, 0x5e, 0x6c, 0x82, 0x3f, 0x02, 0xc0, 0x63, 0x87, 0x84, 0x47, 0x00,
+  0xec, 0x84, 0xbf, 0x83, 0x5f, 0x87, 0xbf, 0x84, 0x8f, 0x00, 0x46, 0x84, 0x8f, 0x00, 0xba, 0x82,
+  0x47, 0x86, 0x8f, 0x01, 0xe0, 0x12, 0x83, 0xb7, 0x87, 0xd7, 0x00, 0xd4, 0x83, 0x07, 0x01, 0x71,
+  0xa2, 0x83, 0x07, 0x00, 0x8f, 0x82, 0x8f, 0x86, 0x5f, 0x01, 0x40, 0x1f, 0x83, 0x5f, 0x01, 0xc0,
+  0xe0, 0x85, 0x77, 0x00, 0x08, 0x83, 0x17, 0x01, 0x84, 0x74, 0x83, 0x17, 0x00, 0x7b, 0x85, 0x5f,
+  0x00, 0x04, 0x81, 0x07, 0x02, 0x66, 0xf6, 0x04, 0x82, 0x17, 0x03, 0x3a, 0xa3, 0x94, 0x95, 0x81,
+  0x07, 0x03, 0x64, 0xbc, 0xf4, 0xea, 0x81, 0x07, 0x03, 0xfc, 0x29, 0x27, 0x81, 0x82, 0x27, 0x02,
+  0x80, 0x4a, 0x8a, 0x84, 0x2f, 0x00, 0xfc, 0x84, 0x5f, 0x00, 0x78, 0x8c, 0x5f, 0x82, 0x47, 0x02,
+  0x00, 0x80, 0xc5, 0x83, 0x5f, 0x01, 0x80, 0x3a, 0x85, 0x17, 0x00, 0xe8, 0x82, 0x07, 0x01, 0xa0,
+  0x37, 0x83, 0xd7, 0x01, 0x60, 0xc8, 0x85, 0x17, 0x00, 0x00, 0x84, 0x07, 0x83, 0x47, 0x80, 0x31,
+  0x8a, 0x17, 0x01, 0xe0, 0x12, 0x83, 0x9f, 0x87, 0xef, 0x00, 0xcc, 0x83, 0x3f, 0x01, 0x09, 0xa8,
+  0x83, 0x4f, 0x00, 0xf6, 0x85, 0x47, 0x00, 0x0c, 0x83, 0x07, 0x01, 0x05, 0x6c, 0x83, 0x07, 0x00,
+  0xfb, 0x85, 0xd7, 0x83, 0xef, 0x01, 0x00, 0x00, 0x83, 0x8f, 0x8d, 0x5f, 0x87, 0x0f, 0xbb, 0x17,
+  0x01, 0x40, 0x1f, 0x83, 0x0f, 0x01, 0xc0, 0xe0, 0x85, 0x8f, 0x00, 0x04, 0x83, 0xff, 0x00, 0xc5,
+  0x83, 0x77, 0x01, 0x80, 0x3a, 0x85, 0x17, 0x00, 0xe8, 0x83, 0xb7, 0x01, 0x37, 0x90, 0x83, 0xc7,
+  0x00, 0xc8, 0x85, 0x17, 0x85, 0x5f, 0x00, 0x78, 0x92, 0x5f, 0x01, 0xe0, 0x12, 0x83, 0xcf, 0x02,
+  0x20, 0xed, 0x88, 0x84, 0x17, 0x00, 0xcc, 0x83, 0x3f, 0x01, 0x09, 0xa8, 0x83, 0x4f, 0x00, 0xf6,
+  0x85, 0x47, 0x00, 0x0c, 0x83, 0x07, 0x01, 0x05, 0x6c, 0x83, 0x07, 0x00, 0xfb, 0x83, 0x37, 0x02,
+  0x00, 0x00, 0x08, 0x84, 0x07, 0x83, 0x8f, 0xbd, 0xef, 0x94, 0x17, 0x02, 0x66, 0xd6, 0x01, 0x82,
+  0x0f, 0x02, 0x9a, 0x29, 0xfe, 0x82, 0x77, 0x03, 0xc0, 0xf5, 0x28, 0x11, 0x81, 0x07, 0x03, 0x40,
+  0x1a, 0xde, 0x6a, 0x82, 0x27, 0x01, 0xf0, 0xf8, 0x82, 0x17, 0x03, 0x60, 0x8f, 0xc2, 0x10, 0x81,
+  0x07, 0x03, 0xa0, 0x60, 0x43, 0x6b, 0x82, 0x17, 0x02, 0x10, 0xfa, 0x97, 0x84, 0x47, 0x00, 0xe8,
+  0x81, 0x07, 0x02, 0xcc, 0xa4, 0x03, 0x82, 0x47, 0x02, 0x64, 0xb7, 0x8b, 0x82, 0xef, 0x03, 0x40,
+  0xe1, 0xfa, 0xfa, 0x81, 0x07, 0x03, 0x90, 0xc2, 0x75, 0x7c, 0xd9, 0xbf, 0xc1, 0x17, 0x04, 0x16,
+  0xff, 0xff, 0xfe, 0x3f, 0x84, 0x1f, 0x03, 0xc1, 0xff, 0xff, 0xff, 0x8c, 0x2f, 0xda, 0x07, 0x80,
+  0x6e, 0x00, 0x7f, 0xa1, 0x27, 0x80, 0x03, 0x86, 0xaf, 0x04, 0xeb, 0xff, 0xff, 0x04, 0x01, 0x80,
+  0x0c, 0x00, 0x02, 0x80, 0x0b, 0x02, 0x32, 0x32, 0x33, 0x82, 0x1f, 0x01, 0x66, 0x66, 0x83, 0x27,
+  0x01, 0x9a, 0x99, 0x83, 0xbf, 0x02, 0x33, 0x33, 0xe1, 0x8a, 0xc7, 0x02, 0x9a, 0x99, 0xeb, 0x8e,
+  0xd7, 0x05, 0xbf, 0x00, 0x00, 0x17, 0xb8, 0x0b, 0x83, 0x0f, 0x02, 0x41, 0x44, 0x91, 0x82, 0x07,
+  0x04, 0xe3, 0x4c, 0x39, 0x7e, 0xf6, 0x80, 0x94, 0x03, 0xdc, 0x6e, 0x35, 0x81, 0x89, 0x17, 0x03,
+  0x99, 0x94, 0x68, 0x08, 0x81, 0x6f, 0x03, 0x26, 0x27, 0x06, 0xf7, 0x89, 0x17, 0x04, 0x07, 0xb0,
+  0x6e, 0x07, 0xee, 0x80, 0x2f, 0x80, 0x47, 0x00, 0xf8, 0x89, 0x17, 0x03, 0x71, 0x36, 0x83, 0x5e,
+  0x85, 0x67, 0x00, 0xf1, 0x80, 0x1f, 0x03, 0x4e, 0x85, 0xeb, 0xa0, 0x8d, 0x37, 0x85, 0x1f, 0x00,
+  0x03, 0x80, 0x03, 0x8d, 0x3f, 0x89, 0x1f, 0x00, 0x23, 0x90, 0x1f, 0x03, 0x82, 0xc0, 0x50, 0x17,
+  0x81, 0xa7, 0x03, 0x3d, 0xfb, 0x1d, 0xe8, 0x8d, 0x37, 0x00, 0xec, 0x90, 0x8f, 0x03, 0x72, 0xb8,
+  0xbc, 0x3a, 0x85, 0x4f, 0x00, 0x71, 0x80, 0x1f, 0x03, 0x4d, 0x03, 0xb2, 0xc4, 0x8c, 0x37, 0x00,
+  0xff, 0x85, 0x1f, 0x9d, 0x07, 0x00, 0x9b, 0x80, 0x03, 0x02, 0xf4, 0x3d, 0x03, 0x82, 0x0f, 0x02,
+  0x0c, 0xc2, 0xfc, 0x82, 0x37, 0x04, 0xdc, 0x05, 0x00, 0x00, 0x06, 0x80, 0x07, 0x01, 0x18, 0x38,
+  0x8f, 0x17, 0x00, 0x62, 0x80, 0x6f, 0x81, 0x07, 0x8c, 0x6f, 0x00, 0x3f, 0x81, 0x07, 0x03, 0x88,
+  0x0d, 0x96, 0x3e, 0x81, 0x07, 0x03, 0xbe, 0xef, 0x68, 0x01, 0x81, 0x07, 0x03, 0xbb, 0x02, 0x01,
+  0x80, 0x81, 0x07, 0x80, 0x32, 0x82, 0x3f, 0x03, 0x46, 0xfd, 0xfe, 0x7f, 0x81, 0x07, 0x00, 0xb9,
+  0x80, 0x17, 0x00, 0x02, 0x81, 0x07, 0x00, 0x0b, 0xdb, 0x47, 0x02, 0x44, 0x1e, 0x5a, 0x82, 0x47,
+  0x02, 0x95, 0x81, 0xa4, 0x82, 0x47, 0x01, 0x28, 0x60, 0x8b, 0x47, 0x01, 0xd9, 0x9f, 0x83, 0x47,
+  0x00, 0x26, 0x80, 0x17, 0xe1, 0x8f, 0xa9, 0x47, 0x00, 0x7f, 0x80, 0x07, 0x81, 0x0b, 0x81, 0x03,
+  0x04, 0x49, 0x43, 0x32, 0x04, 0xfc, 0x80, 0x23, 0x03, 0xb7, 0xbc, 0xcd, 0xfb, 0x95, 0x0f, 0x00,
+  0xf9, 0x8c, 0x0f, 0x81, 0x87, 0x99, 0x1f, 0x00, 0xc3, 0x80, 0x0f, 0x03, 0xe7, 0xef, 0x00, 0x03,
+  0x81, 0x0f, 0x03, 0xd0, 0xcc, 0xcc, 0xf8, 0x81, 0x07, 0x03, 0x15, 0xae, 0x47, 0x81, 0x81, 0x07,
+  0x03, 0x8d, 0xa0, 0xf9, 0x86, 0x81, 0x07, 0x02, 0x68, 0xa2, 0x33, 0x82, 0xa7, 0x04, 0xf6, 0x0e,
+  0x8b, 0xf6, 0xf3, 0x80, 0x2f, 0x03, 0x30, 0x33, 0x33, 0x07, 0xa9, 0x2f, 0x02, 0x98, 0x99, 0x99,
+  0x82, 0x5f, 0x03, 0x68, 0x66, 0x66, 0xfc, 0x9d, 0x2f, 0x00, 0xeb, 0x80, 0x2f, 0x02, 0x66, 0x66,
+  0x26, 0x82, 0x0f, 0x03, 0x9a, 0x99, 0xd9, 0xfe, 0x9d, 0x2f, 0x00, 0x03, 0x80, 0x07, 0xa9, 0x2f,
+  0x81, 0x5f, 0x02, 0x9a, 0x99, 0x99, 0x82, 0x0f, 0x02, 0x66, 0x66, 0x66, 0x8a, 0x2f, 0x02, 0x6e,
+  0x77, 0x88, 0x82, 0x07, 0x03, 0x87, 0xcb, 0xa4, 0x06, 0x85, 0x2f, 0x00, 0xf1, 0x80, 0x2f, 0x03,
+  0xb8, 0x0b, 0x00, 0x00, 0x81, 0x0f, 0x02, 0x41, 0x44, 0x91, 0x82, 0x07, 0x03, 0x07, 0xb0, 0x6e,
+  0x3f, 0x81, 0x07, 0x03, 0x25, 0x91, 0x56, 0x3c, 0x81, 0x07, 0x02, 0xf9, 0x63, 0xa5, 0x82, 0xdf,
+  0x03, 0xe3, 0x0a, 0x04, 0x80, 0x81, 0x07, 0x03, 0xe2, 0x6b, 0x78, 0x7e, 0x81, 0x07, 0x02, 0x3b,
+  0x89, 0x83, 0x82, 0x67, 0x81, 0x17, 0x00, 0x8b, 0x80, 0x47, 0x02, 0x5b, 0xa9, 0x2b, 0x82, 0x3f,
+  0x03, 0x19, 0x80, 0xbe, 0x7f, 0x81, 0x07, 0x02, 0x43, 0xe2, 0x15, 0x82, 0x2f, 0x04, 0x48, 0xf4,
+  0xff, 0xff, 0x19, 0x80, 0x07, 0x81, 0x67, 0x03, 0xe3, 0xff, 0xff, 0x92, 0x80, 0x0f, 0x00, 0x07,
+  0x81, 0x17, 0x80, 0x00, 0x00, 0xf8, 0x84, 0x07, 0x82, 0x27, 0x81, 0x00, 0xc5, 0x07, 0x00, 0x02,
+  0x9c, 0x1f,
+};
+
+/* pcm_initial.h: 1702 bytes packed from 4112 */
+static const uint8 code PCM_INITIAL_ULZ[] = 
+{
+  0x10, 0x10, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x9b, 0x01, 0x80, 0x04, 0x81, 0x03, 0x00, 0xff,
+  0x80, 0x00, 0x81, 0x07, 0x00, 0x04, 0x84, 0x0f, 0x00, 0xfd, 0x84, 0x0f, 0x8d, 0x03, 0x00, 0x03,
+  0x8c, 0x0f, 0x00, 0xfe, 0x84, 0x27, 0x03, 0xfb, 0xff, 0xff, 0x07, 0x81, 0x07, 0x81, 0x00, 0xa4,
+  0x07, 0x00, 0xf8, 0x85, 0x43, 0x04, 0xf2, 0xff, 0xff, 0xe5, 0x06, 0x84, 0x0b, 0x00, 0xf9, 0x80,
+  0x4f, 0x00, 0x02, 0x88, 0x5f, 0x81, 0x00, 0x81, 0x0f, 0x01, 0x7f, 0xbb, 0x83, 0x07, 0x01, 0x87,
+  0x44, 0x83, 0x6f, 0x81, 0x27, 0x00, 0x07, 0x83, 0x12, 0x82, 0x27, 0x85, 0x33, 0x85, 0xc7, 0x85,
+  0x17, 0x85, 0x57, 0x85, 0x0f, 0x00, 0xfc, 0x8c, 0xd7, 0x00, 0x08, 0x8c, 0xcf, 0x80, 0xc7, 0x92,
+  0xf7, 0x91, 0xff, 0x04, 0xdf, 0xff, 0xff, 0x5c, 0xf1, 0x8c, 0x2f, 0x80, 0x0e, 0x00, 0x03, 0x84,
+  0x6f, 0x00, 0xfd, 0x84, 0x0f, 0x00, 0x7e, 0x84, 0x9b, 0x04, 0x80, 0xfa, 0xff, 0xff, 0xd6, 0x8d,
+  0x4f, 0x00, 0xfe, 0x8c, 0xaf, 0x95, 0x07, 0x80, 0x26, 0x00, 0x7f, 0x84, 0xe7, 0x00, 0x80, 0x81,
+  0x4f, 0x80, 0x37, 0x82, 0x0f, 0x03, 0xa1, 0x99, 0x99, 0x99, 0x81, 0x07, 0x07, 0x61, 0x66, 0x66,
+  0xe6, 0xf4, 0xff, 0xff, 0xfb, 0x88, 0x2f, 0x8a, 0x57, 0x00, 0x06, 0x8c, 0xdf, 0x00, 0x07, 0x84,
+  0x0f, 0x00, 0xf9, 0x84, 0x0f, 0x80, 0x06, 0x00, 0x1f, 0x84, 0x93, 0x00, 0xe0, 0x81, 0x07, 0x03,
+  0x9f, 0x99, 0x99, 0x19, 0x81, 0x07, 0x00, 0x60, 0x80, 0x57, 0x81, 0x07, 0x03, 0x80, 0x66, 0x66,
+  0x26, 0x81, 0x07, 0x03, 0x81, 0x99, 0x99, 0xd9, 0x89, 0xbf, 0x03, 0xbe, 0xcc, 0xcc, 0x2c, 0x81,
+  0x07, 0x03, 0x41, 0x33, 0x33, 0xd3, 0x89, 0x17, 0x00, 0x7e, 0x84, 0x2f, 0x03, 0xc0, 0xcc, 0xcc,
+  0x0c, 0x81, 0x07, 0x03, 0xbf, 0xcc, 0xcc, 0x4c, 0x84, 0x1b, 0x00, 0xc0, 0x84, 0x97, 0x85, 0x07,
+  0x86, 0x33, 0x99, 0xff, 0x8d, 0x07, 0x80, 0xaf, 0x00, 0x3f, 0x89, 0x07, 0x03, 0x01, 0xfa, 0x7e,
+  0xda, 0x82, 0x1f, 0x02, 0x06, 0x81, 0xa5, 0x85, 0x27, 0x00, 0x02, 0x84, 0x07, 0x02, 0xdd, 0xff,
+  0xff, 0x8e, 0x5f, 0x85, 0x03, 0x00, 0xfe, 0x84, 0x3f, 0x88, 0xdf, 0x00, 0x99, 0x84, 0x57, 0x00,
+  0x5f, 0x84, 0x23, 0x00, 0xa0, 0x81, 0x07, 0x0c, 0x3f, 0x33, 0x33, 0x33, 0xf8, 0xff, 0xff, 0x20,
+  0x5f, 0xcd, 0xcc, 0x4c, 0x04, 0x80, 0x0f, 0x03, 0x61, 0xff, 0xff, 0x7f, 0x84, 0x4f, 0x00, 0x80,
+  0x83, 0x07, 0x00, 0x80, 0x84, 0x0f, 0x00, 0x80, 0xc6, 0x0f, 0x00, 0x15, 0x81, 0x06, 0x01, 0xf0,
+  0x85, 0x82, 0x0f, 0x03, 0xd0, 0xdc, 0xc6, 0x84, 0x81, 0x07, 0x03, 0x10, 0xae, 0x47, 0x0c, 0x81,
+  0x07, 0x03, 0xec, 0xe1, 0xed, 0x6e, 0x81, 0x07, 0x03, 0x34, 0xa3, 0xfd, 0x83, 0x81, 0x07, 0x03,
+  0xa0, 0x47, 0xe1, 0x11, 0x81, 0x07, 0x03, 0x60, 0xf8, 0x67, 0x6a, 0x82, 0x3f, 0x02, 0xc0, 0xb6,
+  0x87, 0x84, 0x9f, 0x00, 0xec, 0x82, 0x07, 0x02, 0x90, 0xdc, 0x8c, 0x82, 0x07, 0x02, 0x70, 0x23,
+  0x8d, 0x84, 0x17, 0x00, 0xd6, 0x82, 0x07, 0x02, 0xb0, 0x9b, 0x9c, 0x82, 0x07, 0x02, 0x50, 0x64,
+  0x91, 0x84, 0x17, 0x00, 0xe2, 0x81, 0x07, 0x03, 0x68, 0xce, 0xff, 0x8e, 0x81, 0x07, 0x02, 0x98,
+  0x31, 0x00, 0x82, 0x2f, 0x03, 0xc0, 0xe8, 0xc8, 0xce, 0x82, 0x5f, 0x02, 0xd4, 0x71, 0xa3, 0x81,
+  0x07, 0x03, 0xb0, 0x0f, 0x92, 0x88, 0x81, 0x07, 0x03, 0x30, 0x33, 0x33, 0xd9, 0x84, 0x37, 0x83,
+  0x47, 0x80, 0xb8, 0x84, 0x07, 0x00, 0x00, 0x83, 0x07, 0x00, 0xe2, 0x82, 0xb7, 0x02, 0x00, 0x00,
+  0x1e, 0x82, 0xa7, 0x80, 0x00, 0x00, 0x04, 0x81, 0x07, 0x03, 0x66, 0xf6, 0x04, 0x74, 0x81, 0x07,
+  0x03, 0x3a, 0xa3, 0x94, 0x95, 0x81, 0x07, 0x03, 0x64, 0xbc, 0xf4, 0xea, 0x81, 0x07, 0x03, 0xfc,
+  0xa9, 0x71, 0x7f, 0x91, 0x47, 0x02, 0x35, 0x3e, 0x0e, 0x82, 0x0f, 0x02, 0x33, 0x28, 0x58, 0x82,
+  0x4f, 0x03, 0x98, 0xfd, 0x68, 0x0c, 0x82, 0x17, 0x02, 0x7a, 0x4f, 0x6f, 0x81, 0x07, 0x02, 0xcb,
+  0x21, 0xe1, 0x85, 0xef, 0x00, 0x08, 0x84, 0x07, 0x00, 0x70, 0x93, 0x8f, 0x86, 0x0f, 0x8a, 0x17,
+  0x02, 0x37, 0x67, 0x09, 0x82, 0x0f, 0x03, 0xf9, 0xcb, 0x29, 0x89, 0x82, 0x17, 0x02, 0x73, 0x74,
+  0xff, 0x81, 0x07, 0x03, 0xd0, 0x59, 0x58, 0x77, 0x91, 0x2f, 0x03, 0x3e, 0x02, 0x19, 0x81, 0x81,
+  0x07, 0x03, 0xc2, 0xfd, 0xe6, 0x86, 0x81, 0x07, 0x02, 0x20, 0x94, 0xf0, 0x82, 0xbf, 0x03, 0x08,
+  0x88, 0x32, 0x8f, 0x81, 0x07, 0x02, 0xd8, 0xe3, 0xdc, 0x82, 0x47, 0x03, 0x80, 0x20, 0x2a, 0xcd,
+  0x82, 0x07, 0x02, 0xdf, 0xd5, 0xa6, 0x92, 0x8f, 0x01, 0xe8, 0x8b, 0x83, 0xcf, 0x01, 0xb1, 0x0d,
+  0x82, 0x4f, 0x03, 0x28, 0xb5, 0x0c, 0xe3, 0x81, 0x07, 0x03, 0x40, 0xb1, 0x59, 0x97, 0x92, 0x2f,
+  0x01, 0xf0, 0x05, 0x82, 0x0f, 0x02, 0xd0, 0xdc, 0xc6, 0x82, 0x37, 0x03, 0x10, 0xae, 0x47, 0x0c,
+  0x81, 0x07, 0x03, 0xec, 0xe1, 0xed, 0x6e, 0x81, 0x07, 0x03, 0x34, 0xa3, 0xfd, 0x83, 0x81, 0x07,
+  0x03, 0xa0, 0x47, 0xe1, 0x11, 0x81, 0x07, 0x03, 0x60, 0xf8, 0x67, 0x6a, 0x82, 0x37, 0x02, 0xc0,
+  0xb6, 0x87, 0x84, 0x47, 0x00, 0xec, 0x82, 0x07, 0x02, 0x90, 0xdc, 0x8c, 0x82, 0x07, 0x02, 0x70,
+  0x23, 0x8d, 0x84, 0x17, 0x00, 0xd6, 0x82, 0x07, 0x02, 0xb0, 0x9b, 0x9c, 0x82, 0x07, 0x02, 0x50,
+  0x64, 0x91, 0x84, 0x17, 0x00, 0xe2, 0x82, 0x07, 0x02, 0xd0, 0xff, 0x8e, 0x82, 0x07, 0x01, 0x30,
+  0x00, 0x82, 0x2f, 0x03, 0xc0, 0xcc, 0xcc, 0xce, 0x82, 0xa7, 0x02, 0xf3, 0x6d, 0xa3, 0x82, 0x8f,
+  0x02, 0x0c, 0x92, 0x88, 0x81, 0x07, 0x03, 0x30, 0x33, 0x33, 0xd9, 0x84, 0x37, 0x83, 0x47, 0x8d,
+  0xbf, 0x01, 0x00, 0xe2, 0x82, 0xb7, 0x02, 0x00, 0x00, 0x1e, 0x82, 0xa7, 0x80, 0x00, 0x00, 0x04,
+  0x81, 0x07, 0x03, 0x66, 0xf6, 0x04, 0x74, 0x81, 0x07, 0x03, 0x3a, 0xa3, 0x94, 0x95, 0x81, 0x07,
+  0x03, 0x64, 0xbc, 0xf4, 0xea, 0x81, 0x07, 0x03, 0xfc, 0xa9, 0x71, 0x7f, 0x92, 0x47, 0x01, 0x40,
+  0x1f, 0x83, 0x0f, 0x01, 0xc0, 0xe0, 0x85, 0xd7, 0x82, 0x47, 0x02, 0x00, 0x80, 0xc5, 0x82, 0x47,
+  0x02, 0x00, 0x80, 0x3a, 0x85, 0x17, 0x00, 0xe8, 0x82, 0x07, 0x02, 0xa0, 0x37, 0x90, 0x82, 0x07,
+  0x01, 0x60, 0xc8, 0x85, 0x17, 0x84, 0x8f, 0x01, 0x00, 0x78, 0x92, 0x5f, 0x01, 0xe0, 0x12, 0x83,
+  0x9f, 0x01, 0x20, 0xed, 0x82, 0xd7, 0x80, 0x00, 0x00, 0xcc, 0x83, 0x3f, 0x01, 0x09, 0xa8, 0x83,
+  0x4f, 0x00, 0xf6, 0x85, 0x47, 0x00, 0x0c, 0x83, 0x07, 0x01, 0x05, 0x6c, 0x83, 0x07, 0x00, 0xfb,
+  0x85, 0xd7, 0x00, 0x08, 0x84, 0x07, 0x83, 0x8f, 0x8d, 0x5f, 0x87, 0x0f, 0xbb, 0x17, 0x01, 0x40,
+  0x1f, 0x83, 0x0f, 0x01, 0xc0, 0xe0, 0x85, 0x8f, 0x00, 0x04, 0x83, 0xff, 0x00, 0xc5, 0x83, 0x77,
+  0x01, 0x80, 0x3a, 0x85, 0x17, 0x00, 0xe8, 0x83, 0xb7, 0x01, 0x37, 0x90, 0x83, 0xc7, 0x00, 0xc8,
+  0x85, 0x17, 0x85, 0x5f, 0x00, 0x78, 0x92, 0x5f, 0x01, 0xe0, 0x12, 0x83, 0xcf, 0x02, 0x20, 0xed,
+  0x88, 0x84, 0x17, 0x00, 0xcc, 0x83, 0x3f, 0x01, 0x09, 0xa8, 0x83, 0x4f, 0x00, 0xf6, 0x85, 0x47,
+  0x00, 0x0c, 0x83, 0x07, 0x01, 0x05, 0x6c, 0x83, 0x07, 0x00, 0xfb, 0x83, 0x37, 0x02, 0x00, 0x00,
+  0x08, 0x84, 0x07, 0x83, 0x8f, 0xbd, 0xef, 0x94, 0x17, 0x02, 0x66, 0xd6, 0x01, 0x82, 0x0f, 0x02,
+  0x9a, 0x29, 0xfe, 0x82, 0x77, 0x03, 0xc0, 0xf5, 0x28, 0x11, 0x81, 0x07, 0x03, 0x40, 0x1a, 0xde,
+  0x6a, 0x82, 0x27, 0x01, 0xf0, 0xf8, 0x82, 0x17, 0x03, 0x60, 0x8f, 0xc2, 0x10, 0x81, 0x07, 0x03,
+  0xa0, 0x60, 0x43, 0x6b, 0x82, 0x17, 0x02, 0x10, 0xfa, 0x97, 0x84, 0x47, 0x00, 0xe8, 0x81, 0x07,
+  0x02, 0xcc, 0xa4, 0x03, 0x82, 0x47, 0x02, 0x64, 0xb7, 0x8b, 0x82, 0xef, 0x03, 0x40, 0xe1, 0xfa,
+  0xfa, 0x81, 0x07, 0x03, 0x90, 0xc2, 0x75, 0x7c, 0xd9, 0xbf, 0xc1, 0x17, 0x04, 0x16, 0xff, 0xff,
+  0xfe, 0x3f, 0x84, 0x1f, 0x03, 0xc1, 0xff, 0xff, 0xff, 0x8c, 0x2f, 0xda, 0x07, 0x80, 0x6e, 0x00,
+  0x7f, 0xa1, 0x27, 0x80, 0x03, 0x86, 0xaf, 0x04, 0xeb, 0xff, 0xff, 0x04, 0x01, 0x80, 0x0c, 0x00,
+  0x02, 0x80, 0x0b, 0x02, 0x32, 0x32, 0x33, 0x92, 0x2f, 0x02, 0x33, 0x33, 0xe1, 0x8a, 0xc7, 0x02,
+  0x9a, 0x99, 0xeb, 0x8e, 0xd7, 0x05, 0xbf, 0x00, 0x00, 0x17, 0xb8, 0x0b, 0x83, 0x0f, 0x02, 0x41,
+  0x44, 0x91, 0x82, 0x07, 0x04, 0xe3, 0x4c, 0x39, 0x7e, 0xf6, 0x80, 0x94, 0x03, 0xdc, 0x6e, 0x35,
+  0x81, 0x89, 0x17, 0x03, 0x1b, 0x44, 0xd1, 0x1b, 0x81, 0x6f, 0x03, 0xa4, 0x77, 0x9d, 0xe3, 0x89,
+  0x17, 0x04, 0x07, 0xb0, 0x6e, 0x07, 0xee, 0x80, 0x2f, 0x80, 0x47, 0x00, 0xf8, 0x8d, 0x47, 0x85,
+  0x67, 0x00, 0xf1, 0x90, 0x4f, 0x03, 0xc0, 0x90, 0xbb, 0x0a, 0x85, 0x1f, 0x00, 0x03, 0x80, 0x03,
+  0x03, 0xff, 0x2a, 0xb3, 0xf4, 0x8d, 0x57, 0x85, 0x1f, 0x00, 0x23, 0x80, 0x03, 0x8d, 0x5f, 0x03,
+  0x68, 0x8c, 0x1c, 0x0c, 0x81, 0xa7, 0x03, 0x57, 0x2f, 0x52, 0xf3, 0x8d, 0x37, 0x00, 0xec, 0x90,
+  0x8f, 0x03, 0x3a, 0x33, 0xe7, 0x29, 0x85, 0x4f, 0x00, 0x71, 0x80, 0x1f, 0x03, 0x85, 0x88, 0x87,
+  0xd5, 0x8c, 0x37, 0x00, 0xff, 0x85, 0x1f, 0x9d, 0x07, 0x00, 0x9b, 0x80, 0x03, 0x02, 0x22, 0x23,
+  0x09, 0x82, 0x0f, 0x02, 0xde, 0xdc, 0xf6, 0x82, 0x37, 0x04, 0xdc, 0x05, 0x00, 0x00, 0x06, 0x80,
+  0x07, 0x01, 0x46, 0x1d, 0x8f, 0x17, 0x00, 0x62, 0x81, 0xff, 0x80, 0x07, 0x8c, 0x6f, 0x00, 0x3f,
+  0x81, 0x07, 0x03, 0x88, 0x0d, 0x96, 0x3e, 0x81, 0x07, 0x03, 0xbe, 0xef, 0x68, 0x01, 0x81, 0x07,
+  0x03, 0xbb, 0x02, 0x01, 0x80, 0x81, 0x07, 0x80, 0x32, 0x82, 0x3f, 0x03, 0x46, 0xfd, 0xfe, 0x7f,
+  0x81, 0x07, 0x00, 0xb9, 0x80, 0x17, 0x00, 0x02, 0x81, 0x07, 0x00, 0x0b, 0xdb, 0x47, 0x02, 0x44,
+  0x1e, 0x5a, 0x82, 0x47, 0x02, 0x95, 0x81, 0xa4, 0x82, 0x47, 0x01, 0x28, 0x60, 0x8b, 0x47, 0x01,
+  0xd9, 0x9f, 0x83, 0x47, 0x00, 0x26, 0x80, 0x17, 0xe1, 0x8f, 0xa9, 0x47, 0x00, 0x7f, 0x80, 0x07,
+  0x81, 0x0b, 0x81, 0x03, 0x04, 0x49, 0x43, 0x32, 0x04, 0xfc, 0x80, 0x23, 0x03, 0xb7, 0xbc, 0xcd,
+  0xfb, 0x95, 0x0f, 0x00, 0xf9, 0x8c, 0x0f, 0x81, 0x87, 0x99, 0x1f, 0x00, 0xc3, 0x80, 0x0f, 0x03,
+  0xe7, 0xef, 0x00, 0x03, 0x81, 0x0f, 0x03, 0xd0, 0xcc, 0xcc, 0xf8, 0x81, 0x07, 0x03, 0x15, 0xae,
+  0x47, 0x81, 0x81, 0x07, 0x03, 0x8d, 0xa0, 0xf9, 0x86, 0x81, 0x07, 0x02, 0x68, 0xa2, 0x33, 0x82,
+  0xa7, 0x04, 0xf6, 0x0e, 0x8b, 0xf6, 0xf3, 0x80, 0x2f, 0x03, 0x30, 0x33, 0x33, 0x07, 0xa9, 0x2f,
+  0x02, 0x98, 0x99, 0x99, 0x82, 0x5f, 0x03, 0x68, 0x66, 0x66, 0xfc, 0x9d, 0x2f, 0x00, 0xeb, 0x80,
+  0x2f, 0x02, 0x66, 0x66, 0x26, 0x82, 0x0f, 0x03, 0x9a, 0x99, 0xd9, 0xfe, 0x9d, 0x2f, 0x00, 0x03,
+  0x80, 0x07, 0xa9, 0x2f, 0x81, 0x5f, 0x02, 0x80, 0x99, 0x99, 0x82, 0x0f, 0x02, 0x80, 0x66, 0x66,
+  0x8a, 0x2f, 0x02, 0x6e, 0x77, 0x88, 0x82, 0x07, 0x03, 0x87, 0xcb, 0xa4, 0x06, 0x85, 0x2f, 0x00,
+  0xf1, 0x80, 0x2f, 0x03, 0xb8, 0x0b, 0x00, 0x00, 0x81, 0x0f, 0x02, 0x41, 0x44, 0x91, 0x82, 0x07,
+  0x03, 0x07, 0xb0, 0x6e, 0x3f, 0x81, 0x07, 0x03, 0x25, 0x91, 0x56, 0x3c, 0x81, 0x07, 0x02, 0xf9,
+  0x63, 0xa5, 0x82, 0xdf, 0x03, 0xe3, 0x0a, 0x04, 0x80, 0x81, 0x07, 0x03, 0xe2, 0x6b, 0x78, 0x7e,
+  0x81, 0x07, 0x02, 0x3b, 0x89, 0x83, 0x82, 0x67, 0x81, 0x17, 0x00, 0x8b, 0x80, 0x47, 0x02, 0x5b,
+  0xa9, 0x2b, 0x82, 0x3f, 0x03, 0x19, 0x80, 0xbe, 0x7f, 0x81, 0x07, 0x02, 0x43, 0xe2, 0x15, 0x82,
+  0x2f, 0x04, 0x48, 0xf4, 0xff, 0xff, 0x19, 0x80, 0x07, 0x81, 0x67, 0x03, 0xe3, 0xff, 0xff, 0x92,
+  0x80, 0x0f, 0x00, 0x07, 0x81, 0x17, 0x80, 0x00, 0x00, 0xf8, 0x84, 0x07, 0x82, 0x27, 0x81, 0x00,
+  0xc5, 0x07, 0x00, 0x02, 0x9c, 0x1f,
+};
+
+#endif /*__CFG_ULZ_H__*/
@@ -56,6 +56,10 @@ typedef struct AUDIO_MANAGER_PARAMETERS
     xTaskHandle VolTaskHandle;
     xTaskHandle signal_detector_handle;
     xTaskHandle Digital_detector_handle; 
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+    xTaskHandle src_detector_handle;
+    xSemaphoreHandle src_detector_sema;
+#endif
     xTaskHandle Audio_Exception_handle;
     xTaskHandle BackCtrlTaskHandle;
     xSemaphoreParameters ADM_I2C2_sema;
@@ -108,6 +112,10 @@ static uint8 SignalAvailable = 0;
 static uint8 ramp_delay = 0;
 static uint16 vre_ramp_count = 0;
 static bool format_indicator = 0;
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+static bool mSignalDetectorEnable = FALSE;
+static bool mDigitalDetectorEnable = FALSE;
+#endif
 static CS49844LoadAudioStreamType CurrentAudioStream;
 static uint8 volume_inc = 0;
 static uint8 target_volume = 0;
@@ -180,6 +188,10 @@ static void AudioDeviceManager_SignalDetector_TaskCtrl( bool val );
 
 static uint8 AudioDeviceManager_getSignalAvailable( void );
 
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+static void AuidoDeviceManager_SrcDetector_CreateTask( void );
+#endif
+
 //______________________________________________________________________________
 /*LOW LEVEL*/
 static void AudioDeviceManager_lowlevel_setMute( bool idx );
@@ -299,8 +311,12 @@ static void AudioDeviceManager_CreateTask( void )
     pADM_ObjCtrl->CreateVolTask();
     pAudLowLevel_ObjCtrl->CreateBackCtrlTask();
     pAudLowLevel_ObjCtrl->CreateExceptionTask();
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+    AuidoDeviceManager_SrcDetector_CreateTask();
+#else
     //AuidoDeviceManager_SignalDetector_CreateTask();
     //AuidoDeviceManager_DigitalDetector_CreateTask();
+#endif
 
     xOS_ADM_Parms.ADM_I2C2_sema.xSemaphore = xSemaphoreCreateMutex(); 
     xOS_ADM_Parms.ADM_I2C2_sema.xBlockTime = portMAX_DELAY;
@@ -1590,6 +1606,21 @@ static uint8 AuidoDeviceManager_VolController_TargetVol(void)
  ******************************************************************************/
 static void AudioDeviceManager_DigitalDetector_TaskCtrl( bool val )
 {   
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+    if ( val == BTASK_SUSPENDED )
+    {
+        mDigitalDetectorEnable = FALSE;
+    }
+    else
+    {
+        if ( mDigitalDetectorEnable == FALSE )
+        {
+            vTaskDelay( TASK_MSEC2TICKS(50) ); /*wait to right uld for format led*/
+            mDigitalDetectorEnable = TRUE;
+        }
+        AudioDeviceManager_SrcDetector_wakeup( );
+    }
+#else
     if ( val == BTASK_SUSPENDED )
     {
         if ( xTaskIsTaskSuspended( xOS_ADM_Parms.Digital_detector_handle ) != pdPASS ) /*task is working*/
@@ -1608,171 +1639,182 @@ static void AudioDeviceManager_DigitalDetector_TaskCtrl( bool val )
             //TRACE_DEBUG((0, "RESUME: DigitalDetector"));
         }
     }
+#endif
 }
 
-void AudioDeviceManager_DigitalDetectorTask( void *pvParameters )
+static void AudioDeviceManager_DigitalDetector_update( void )
 {
     bool ret;
-#if ( configSII_DEV_953x_PORTING == 1 )    
-    static xHDMIAudiotype CurrentHDMIAudiotype = HDMI_NON_PCM;
-    static xHDMIAudiotype LastHDMIAudiotype = HDMI_NON_PCM;
-    CS49844_QUEUE_TYPE QUEUE_TYPE;
-#endif
-    
-    for( ;; )
+
+    switch( pAudioDevParms->input_src )
     {
-        switch( pAudioDevParms->input_src )
-        {
-            case AUDIO_SOURCE_OPTICAL:
-            case AUDIO_SOURCE_COAXIAL:
+        case AUDIO_SOURCE_OPTICAL:
+        case AUDIO_SOURCE_COAXIAL:
 #if ( configSII_DEV_953x_PORTING == 1 )
-            case AUDIO_SOURCE_HDMI_IN:
-            case AUDIO_SOURCE_HDMI_ARC:	
+        case AUDIO_SOURCE_HDMI_IN:
+        case AUDIO_SOURCE_HDMI_ARC:	
 #endif
+        { 
+        /* Smith commanded 2013/4/05
+        1. Confirm AES3 PCM 96Khz 
+        2. Fix VIZIO TV short noise between DIGITAL AUDIO OUTPUT between PCM and bitstream.
+        */
+            if (ADM_I2C2_sema_mutex_take() == TRUE )
             { 
-            /* Smith commanded 2013/4/05
-            1. Confirm AES3 PCM 96Khz 
-            2. Fix VIZIO TV short noise between DIGITAL AUDIO OUTPUT between PCM and bitstream.
-            */
-                if (ADM_I2C2_sema_mutex_take() == TRUE )
-                { 
-                    if ( AudioStream_get_PCM96Khz() )
-                    {
-                        ret = AudioSystem_isPCM_96Khz(FALSE);
-                        AudioStream_set_PCM96Khz( ret );
-                    }
-                    else
-                    {
-                        ret = AudioSystem_isPCM_96Khz(TRUE);
-                        AudioStream_set_PCM96Khz( ret );
-                    }
-                    AudioSystem_Cover_PCM96Khz();
-                    ADM_I2C2_sema_mutex_give();
+                if ( AudioStream_get_PCM96Khz() )
+                {
+                    ret = AudioSystem_isPCM_96Khz(FALSE);
+                    AudioStream_set_PCM96Khz( ret );
                 }
-                 /* for format LED*/
-                    /* Tony need to change to Q*/
-                if (AudioDeviceManager_getSignalAvailable() == 1)
-                { 
-                    if (format_indicator== TRUE)
+                else
+                {
+                    ret = AudioSystem_isPCM_96Khz(TRUE);
+                    AudioStream_set_PCM96Khz( ret );
+                }
+                AudioSystem_Cover_PCM96Khz();
+                ADM_I2C2_sema_mutex_give();
+            }
+             /* for format LED*/
+                /* Tony need to change to Q*/
+            if (AudioDeviceManager_getSignalAvailable() == 1)
+            { 
+                if (format_indicator== TRUE)
+                {
+                    format_indicator = FALSE;
+                    switch(pDSP_ObjCtrl->GetAudioStreamType())
                     {
-                        format_indicator = FALSE;
-                        switch(pDSP_ObjCtrl->GetAudioStreamType())
+                        case CS49844_LOAD_AC3:
                         {
-                            case CS49844_LOAD_AC3:
+                            if (pAudioDevParms->op_mode==MODE_FACTORY)
+                            {
+                                pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_FAC_DOLBY);
+                            }
+                            else
                             {
-                                if (pAudioDevParms->op_mode==MODE_FACTORY)
-                                {
-                                    pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_FAC_DOLBY);
-                                }
-                                else
-                                {
-                                    pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_DOLBY);
-                                }
+                                pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_DOLBY);
                             }
-                                break;
+                        }
+                            break;
 
-                            case CS49844_LOAD_DTS:
+                        case CS49844_LOAD_DTS:
+                        {
+                            if (pAudioDevParms->op_mode==MODE_FACTORY)
                             {
-                                if (pAudioDevParms->op_mode==MODE_FACTORY)
-                                {
-                                    pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_FAC_DTS);
-                                }
-                                else
-                                {
-                                    pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_DTS);
-                                }
+                                pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_FAC_DTS);
                             }
-                                break;
-                                
-                            case CS49844_LOAD_PCM:
+                            else
                             {
-                                 pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_PCM);
+                                pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_DTS);
                             }
-                                break;
-                        }       
-                    }
-                }
-                else
-                {
-                    format_indicator = TRUE;
+                        }
+                            break;
+                            
+                        case CS49844_LOAD_PCM:
+                        {
+                             pUDM_ObjCtrl->ExceptionSendEvent(UI_EVENT_PCM);
+                        }
+                            break;
+                    }       
                 }
             }
-                break;
+            else
+            {
+                format_indicator = TRUE;
+            }
         }
-                
-#if ( configSII_DEV_953x_PORTING == 1 )        
-		/* MultiChannel PCM in HDMI*/
-		switch( pAudioDevParms->input_src )
+            break;
+    }
+}
+
+#if ( configSII_DEV_953x_PORTING == 1 )
+static void AudioDeviceManager_DigitalDetector_HdmiUpdate( void )
+{
+    static xHDMIAudiotype CurrentHDMIAudiotype = HDMI_NON_PCM;
+    static xHDMIAudiotype LastHDMIAudiotype = HDMI_NON_PCM;
+    CS49844_QUEUE_TYPE QUEUE_TYPE;
+
+	/* MultiChannel PCM in HDMI*/
+	switch( pAudioDevParms->input_src )
+	{
+		case AUDIO_SOURCE_HDMI_IN:
+		case AUDIO_SOURCE_HDMI_ARC: 
 		{
-			case AUDIO_SOURCE_HDMI_IN:
-			case AUDIO_SOURCE_HDMI_ARC: 
+			if (AudioStream_get_PCM()==TRUE)
 			{
-				if (AudioStream_get_PCM()==TRUE)
+				if (pHDMI_DM_ObjCtrl->GetMultiChannel()==TRUE)
 				{
-					if (pHDMI_DM_ObjCtrl->GetMultiChannel()==TRUE)
+					if (AudioStream_get_PCM96Khz()==TRUE)
 					{
-						if (AudioStream_get_PCM96Khz()==TRUE)
-						{
-							CurrentHDMIAudiotype = HDMI_PCM_MULTI_96K;
-						}
-						else
-						{
-							CurrentHDMIAudiotype = HDMI_PCM_MULTI_48K;
-						}
+						CurrentHDMIAudiotype = HDMI_PCM_MULTI_96K;
 					}
 					else
 					{
-						CurrentHDMIAudiotype = HDMI_PCM_STEREO;
+						CurrentHDMIAudiotype = HDMI_PCM_MULTI_48K;
 					}
 				}
 				else
 				{
-					CurrentHDMIAudiotype = HDMI_NON_PCM;
+					CurrentHDMIAudiotype = HDMI_PCM_STEREO;
 				}
+			}
+			else
+			{
+				CurrentHDMIAudiotype = HDMI_NON_PCM;
+			}
 
-				if (LastHDMIAudiotype!=CurrentHDMIAudiotype)
-				{				 
-					switch(CurrentHDMIAudiotype)
+			if (LastHDMIAudiotype!=CurrentHDMIAudiotype)
+			{				 
+				switch(CurrentHDMIAudiotype)
+				{
+					case HDMI_NON_PCM:
+					case HDMI_PCM_STEREO:
 					{
-						case HDMI_NON_PCM:
-						case HDMI_PCM_STEREO:
-						{
-							QUEUE_TYPE.sample_96k = FALSE;
-							QUEUE_TYPE.multi_channel = FALSE;
-            }
-                break;
+						QUEUE_TYPE.sample_96k = FALSE;
+						QUEUE_TYPE.multi_channel = FALSE;
+        }
+            break;
 
-						case HDMI_PCM_MULTI_48K:
-						{
-							QUEUE_TYPE.sample_96k = FALSE;
-							QUEUE_TYPE.multi_channel = TRUE;
-						}
-							break;
-
-						case HDMI_PCM_MULTI_96K:
-						{
-							QUEUE_TYPE.sample_96k = TRUE;
-							QUEUE_TYPE.multi_channel = TRUE;
-						}
-							break;
-
-						default:
-							break;
+					case HDMI_PCM_MULTI_48K:
+					{
+						QUEUE_TYPE.sample_96k = FALSE;
+						QUEUE_TYPE.multi_channel = TRUE;
 					}
-					QUEUE_TYPE.audio_type = CS49844_LOAD_HDMI_CTRL;
-					QUEUE_TYPE.source_ctrl = CS49844_SOURCE_HDMI;
-					
-					if (pDSP_ObjCtrl->loader_load_fmt_mutex_take())
+						break;
+
+					case HDMI_PCM_MULTI_96K:
 					{
-						pDSP_ObjCtrl->loader_load_fmt_uld( &QUEUE_TYPE );	  
+						QUEUE_TYPE.sample_96k = TRUE;
+						QUEUE_TYPE.multi_channel = TRUE;
 					}
-					
-					LastHDMIAudiotype = CurrentHDMIAudiotype;
+						break;
+
+					default:
+						break;
 				}
+				QUEUE_TYPE.audio_type = CS49844_LOAD_HDMI_CTRL;
+				QUEUE_TYPE.source_ctrl = CS49844_SOURCE_HDMI;
+				
+				if (pDSP_ObjCtrl->loader_load_fmt_mutex_take())
+				{
+					pDSP_ObjCtrl->loader_load_fmt_uld( &QUEUE_TYPE );	  
+				}
+				
+				LastHDMIAudiotype = CurrentHDMIAudiotype;
 			}
-				break;
-        }
-#endif        
+		}
+			break;
+    }
+}
+#endif
+
+void AudioDeviceManager_DigitalDetectorTask( void *pvParameters )
+{
+    for( ;; )
+    {
+        AudioDeviceManager_DigitalDetector_update( );
+#if ( configSII_DEV_953x_PORTING == 1 )
+        AudioDeviceManager_DigitalDetector_HdmiUpdate( );
+#endif
         vTaskDelay( ADM_DIGITAL_DETECTOR_TIME_TICK );
     }
 }
@@ -1892,13 +1934,29 @@ void AudioSystem_Cover_PCM96Khz( void )
  ******************************************************************************/
 static uint8 AudioDeviceManager_getSignalAvailable( void )
 {
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+    return SignalAvailable;
+#else
     return TRUE;
     
     //return SignalAvailable;   //Angus just for temporal
+#endif
 }
 
 static void AudioDeviceManager_SignalDetector_TaskCtrl( bool val )
 {
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+    if ( val == BTASK_SUSPENDED )
+    {
+        SignalAvailable = 0;/* When task suspened, it means DSP is in format change or not ready*/
+        mSignalDetectorEnable = FALSE;
+    }
+    else
+    {
+        mSignalDetectorEnable = TRUE;
+        AudioDeviceManager_SrcDetector_wakeup( );
+    }
+#else
     if ( val == BTASK_SUSPENDED )
     {
         if ( xTaskIsTaskSuspended( xOS_ADM_Parms.signal_detector_handle ) != pdPASS ) /*task is working*/
@@ -1917,74 +1975,80 @@ static void AudioDeviceManager_SignalDetector_TaskCtrl( bool val )
             //TRACE_DEBUG((0, "RESUME: SignalDetector"));
         }
     }
+#endif
 }
 
-void AudioDeviceManager_SignalDetectorTask( void *pvParameters )
+static void AudioDeviceManager_SignalDetector_update( void )
 {
-    for( ;; )
+    switch( pAudioDevParms->input_src )
     {
-        switch( pAudioDevParms->input_src )
+        case AUDIO_SOURCE_AUX1:
+        case AUDIO_SOURCE_AUX2:
+        case AUDIO_SOURCE_BLUETOOTH:
+        case AUDIO_SOURCE_USB_PLAYBACK:
         {
-            case AUDIO_SOURCE_AUX1:
-            case AUDIO_SOURCE_AUX2:
-            case AUDIO_SOURCE_BLUETOOTH:
-            case AUDIO_SOURCE_USB_PLAYBACK:
+            if (pDSP_ObjCtrl->GetLoadrState()==0)
             {
-                if (pDSP_ObjCtrl->GetLoadrState()==0)
+                if (pDSP_ObjCtrl->GetSignalLevel() == 1 )
                 {
-                    if (pDSP_ObjCtrl->GetSignalLevel() == 1 )
-                    {
-                        SignalAvailable = 1;
-                    }
-                    else
-                    {
-                        SignalAvailable = 0;
-                    }
+                    SignalAvailable = 1;
                 }
                 else
                 {
                     SignalAvailable = 0;
                 }
             }
-                break;
+            else
+            {
+                SignalAvailable = 0;
+            }
+        }
+            break;
 
-            case AUDIO_SOURCE_OPTICAL:
-            case AUDIO_SOURCE_COAXIAL:
+        case AUDIO_SOURCE_OPTICAL:
+        case AUDIO_SOURCE_COAXIAL:
 #if ( configSII_DEV_953x_PORTING == 1 )
-            case AUDIO_SOURCE_HDMI_IN:
-            case AUDIO_SOURCE_HDMI_ARC:	
+        case AUDIO_SOURCE_HDMI_IN:
+        case AUDIO_SOURCE_HDMI_ARC:	
 #endif
-            {
-                if (ADM_I2C2_sema_mutex_take() == TRUE )
-                { 
-                    int idx =0;
+        {
+            if (ADM_I2C2_sema_mutex_take() == TRUE )
+            { 
+                int idx =0;
 
-                    for (idx = 0 ; idx < 2 ; idx++)
-                    {
-                        //TRACE_DEBUG((0,"PLL Lock status %d -----> %d",idx, pSRC_ObjCtrl->IsLockPLL()));    
+                for (idx = 0 ; idx < 2 ; idx++)
+                {
+                    //TRACE_DEBUG((0,"PLL Lock status %d -----> %d",idx, pSRC_ObjCtrl->IsLockPLL()));    
 
-                        if (pSRC_ObjCtrl->IsLockPLL() == TRUE )
-                        {                        
-                            SignalAvailable = 1;
-                            break;
-                        }
-                        else
+                    if (pSRC_ObjCtrl->IsLockPLL() == TRUE )
+                    {                        
+                        SignalAvailable = 1;
+                        break;
+                    }
+                    else
+                    {
+                        if (idx == 0)
                         {
-                            if (idx == 0)
-                            {
-                                vTaskDelay(10);
-                                continue;
-                            }
-                            
-                            SignalAvailable = 0;
+                            vTaskDelay(10);
+                            continue;
                         }
+                        
+                        SignalAvailable = 0;
                     }
-                    
-                    ADM_I2C2_sema_mutex_give();
                 }
+                
+                ADM_I2C2_sema_mutex_give();
             }
-                break;
         }
+            break;
+    }
+}
+
+void AudioDeviceManager_SignalDetectorTask( void *pvParameters )
+{
+    for( ;; )
+    {
+        AudioDeviceManager_SignalDetector_update( );
         vTaskDelay( ADM_SIGNAL_DETECTOR_TIME_TICK );
     }
 }
@@ -2003,6 +2067,102 @@ static void AuidoDeviceManager_SignalDetector_CreateTask( void )
     }
 }
 
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+/*******************************************************************************
+ * SRC Event Detector
+ * One task runs the signal and digital detectors when the CS8422 INT or a
+ * source/format change wakes it. Optical/coaxial inputs read the SRC only then;
+ * the timed wakeups are left for the DSP signal level of the analog inputs and
+ * the HDMI multichannel state, and neither touches the CS8422.
+ ******************************************************************************/
+void AudioDeviceManager_SrcDetector_wakeup( void )
+{
+    if ( xOS_ADM_Parms.src_detector_sema != NULL )
+    {
+        xSemaphoreGive( xOS_ADM_Parms.src_detector_sema );
+    }
+}
+
+static bool AudioDeviceManager_SrcDetector_isDigitalInput( void )
+{
+    switch( pAudioDevParms->input_src )
+    {
+        case AUDIO_SOURCE_OPTICAL:
+        case AUDIO_SOURCE_COAXIAL:
+#if ( configSII_DEV_953x_PORTING == 1 )
+        case AUDIO_SOURCE_HDMI_IN:
+        case AUDIO_SOURCE_HDMI_ARC:	
+#endif
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static portTickType AudioDeviceManager_SrcDetector_BlockTime( void )
+{
+    switch( pAudioDevParms->input_src )
+    {
+        case AUDIO_SOURCE_OPTICAL:
+        case AUDIO_SOURCE_COAXIAL:
+            return portMAX_DELAY;
+
+#if ( configSII_DEV_953x_PORTING == 1 )
+        case AUDIO_SOURCE_HDMI_IN:
+        case AUDIO_SOURCE_HDMI_ARC:	
+            return ADM_DIGITAL_DETECTOR_TIME_TICK;
+#endif
+    }
+
+    return ADM_SIGNAL_DETECTOR_TIME_TICK;
+}
+
+void AudioDeviceManager_SrcDetectorTask( void *pvParameters )
+{
+    bool bWakeup;
+
+    for( ;; )
+    {
+        bWakeup = ( xSemaphoreTake( xOS_ADM_Parms.src_detector_sema, AudioDeviceManager_SrcDetector_BlockTime() ) == pdTRUE );
+
+        if ( ( mSignalDetectorEnable == TRUE ) 
+            && ( ( bWakeup == TRUE ) || ( AudioDeviceManager_SrcDetector_isDigitalInput() == FALSE ) ) )
+        {
+            AudioDeviceManager_SignalDetector_update( );
+        }
+
+        if ( mDigitalDetectorEnable == TRUE )
+        {
+            if ( bWakeup == TRUE )
+            {
+                AudioDeviceManager_DigitalDetector_update( );
+            }
+#if ( configSII_DEV_953x_PORTING == 1 )
+            AudioDeviceManager_DigitalDetector_HdmiUpdate( );
+#endif
+        }
+    }
+}
+
+static void AuidoDeviceManager_SrcDetector_CreateTask( void )
+{
+    vSemaphoreCreateBinary( xOS_ADM_Parms.src_detector_sema );
+    if ( xOS_ADM_Parms.src_detector_sema == NULL )
+    {
+        TRACE_ERROR((0, "ADM src detector semaphore creates failure " ));
+        return;
+    }
+    xSemaphoreTake( xOS_ADM_Parms.src_detector_sema, 0 );
+
+    if ( xTaskCreate( AudioDeviceManager_SrcDetectorTask, 
+            ( portCHAR * ) "ADM_SRC", 
+            (STACK_SIZE), NULL, tskADM_SRC_DETECTOR_PRIORITY,&xOS_ADM_Parms.src_detector_handle) != pdPASS )
+    {
+        TRACE_ERROR((0, "ADM src detector task create failure " ));
+    }
+}
+#endif
+
 
 /*******************************************************************************
  * Mutex
@@ -54,4 +54,9 @@ typedef struct _AUDIO_DEVICE_LOWLEVEL_CTRL
 
 }AUDIO_LOWLEVEL_DRIVER_OBJECT;
 
+#if ( configCS8422_EVENT_DETECTOR == 1 )
+/*CS8422 INT or source/format change: run the signal and digital detectors once*/
+void AudioDeviceManager_SrcDetector_wakeup( void );
+#endif
+
 #endif 
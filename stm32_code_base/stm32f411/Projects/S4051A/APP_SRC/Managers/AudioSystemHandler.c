@@ -46,7 +46,7 @@ static void AudioSystemHandler_CreateTask( void );
 
 static uint8 AudioSystemHandler_GetQueueNumber( void );
 
-static void AudioSystemHandler_HardwareRst( void );
+static bool AudioSystemHandler_HardwareRst( void );
 
 static void AudioSystemHandler_ClrRst( void );
 
@@ -148,6 +148,19 @@ static bool AudioSystemHandler_InstrSender( const void *params )
         TRACE_ERROR((0, "AudioSystemHandler_InstrSender xqueue is null !! "));
         return FALSE;
     }
+
+#if ( configDEBUG_LATENCY == 1 )
+    /*queue wait included; the input switch ends at the audio device manager call,
+      the volume step at the master gain write to the DSP*/
+    if ( pInstr->sys_event == SYS_EVENT_SEL_SRC )
+    {
+        DEBUG_LATENCY_BEGIN( DEBUG_LATENCY_INPUT_SWITCH );
+    }
+    else if ( pInstr->sys_event == SYS_EVENT_VOLUME_SET )
+    {
+        DEBUG_LATENCY_BEGIN( DEBUG_LATENCY_VOLUME_STEP );
+    }
+#endif
     
     if ( xQueueSend( AudioSysParams.QParams.xQueue, pInstr, AudioSysParams.QParams.xBlockTime ) != pdPASS )
     {
@@ -210,12 +223,25 @@ static void AudioSystemHandler_RstCtrl( xAudSysRstCtrl RstCtrl )
     }
 }
 
-static void AudioSystemHandler_HardwareRst( void )
+/*FALSE if the rails were never reported, the devices are then left in reset*/
+static bool AudioSystemHandler_HardwareRst( void )
 {
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+    /*rails settle and reset hold times come from the power handler's boot stages*/
+    if ( pPowerHandle_ObjCtrl->boot_wait( POWER_BOOT_AUDIO_RESET ) == FALSE )
+        return FALSE;
+
+    AudioSystemHandler_RstCtrl( AUD_SYSTEM_SET_RESET );
+    pPowerHandle_ObjCtrl->boot_done( POWER_BOOT_AUDIO_RESET );
+
+    return pPowerHandle_ObjCtrl->boot_wait( POWER_BOOT_AUDIO_DEVICES );
+#else
     vTaskDelay(TASK_MSEC2TICKS(200)); /*Smith modify: Working with HW Austin  to modify reset sequence.*/
         
     AudioSystemHandler_RstCtrl( AUD_SYSTEM_SET_RESET );
     vTaskDelay(TASK_MSEC2TICKS(100));
+    return TRUE;
+#endif
 }
 
 static void AudioSystemHandler_ClrRst( void )
@@ -310,6 +336,26 @@ static void AudioSystemHandler_handleCommand( void *params  )
         {
             xAudDeviceParms Dest; 
             
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+            /*The HDMI task waits for POWER_BOOT_HDMI itself, so the SiI953x
+              comes up while the audio devices are reset and initialized*/
+            if( pSystemParms->sys_event != SYS_EVENT_CEC_SYSTEM_UP )
+            {
+                pHDMI_DM_ObjCtrl->SendEvent( pSystemParms );
+            }
+
+            /*A power down came in before the rails were switched on; its SYSTEM_DOWN follows*/
+            if ( AudioSystemHandler_HardwareRst( ) == FALSE )
+            {
+                TRACE_ERROR((0, "power up skipped, the rails were not switched on"));
+                pPowerHandle_ObjCtrl->turn_on_done( AudioSysParams.power_handle );
+                break;
+            }
+
+            Dest = AudioSystemHandler_AudioParmsAdapter( pSystemParms );
+            pADM_ObjCtrl->initialize( &Dest );
+            pPowerHandle_ObjCtrl->boot_done( POWER_BOOT_AUDIO_DEVICES );
+#else
             AudioSystemHandler_HardwareRst( );
 
             Dest = AudioSystemHandler_AudioParmsAdapter( pSystemParms );
@@ -318,6 +364,7 @@ static void AudioSystemHandler_handleCommand( void *params  )
             {
                 pHDMI_DM_ObjCtrl->SendEvent( pSystemParms );
             }
+#endif
             AudioSystemHandler_SystemInformation( );
 #if ( configSTM32F411_PORTING == 1 )             
 
@@ -359,6 +406,7 @@ static void AudioSystemHandler_handleCommand( void *params  )
         case SYS_EVENT_SEL_SRC:
         {
             pADM_ObjCtrl->SetInputPath( pSystemParms->input_src );
+            DEBUG_LATENCY_END( DEBUG_LATENCY_INPUT_SWITCH );
 #if ( configSTM32F411_PORTING == 1 )             
             pHDMI_DM_ObjCtrl->SendEvent( pSystemParms );
 #endif
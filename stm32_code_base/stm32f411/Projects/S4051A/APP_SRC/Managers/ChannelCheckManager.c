@@ -18,17 +18,19 @@
 
 #define CCK_MANAGER_QUEUE_LENGTH 3
 
-#define BYTE_OF_ChunkID         4
-#define BYTE_OF_ChunkSize      4
+#if ( configUSB_WAV_CIRCULAR_DMA == 0 )
+#error "channel check renders its noise into the circular I2S DMA halves"
+#endif
 
-#define TotalCheckFile  6
-#define WaveHeaderSize 50
-#define Index_L_StartAddr     0
-#define Index_R_StartAddr     1
-#define Index_C_StartAddr     2       
-#define Index_Ls_StartAddr    3    
-#define Index_Rs_StartAddr    4
-#define Index_W_StartAddr     5
+#define CCK_NOISE_SAMPLE_RATE   SAMPLE_RATE_48000
+#define CCK_NOISE_PLAY_MSEC     2500    /* one play, CCK_PLAY_NOISE repeats it 3 times per channel */
+#define CCK_NOISE_ROWS          12      /* Voss-McCartney rows, the slowest one changes every 8192 samples */
+#define CCK_NOISE_SEED          0x2545F491
+
+/* Q15 one-pole coefficient, 1-exp(-2*pi*fc/fs) is taken as 2*pi*fc/fs for fc << fs; 0 leaves the filter out */
+#define CCK_NOISE_ALPHA(fc)     ((uint16)(32768.0 * 6.2831853 * (fc) / CCK_NOISE_SAMPLE_RATE))
+#define CCK_NOISE_BYPASS        0
+#define CCK_NOISE_GAIN(g)       ((uint16)(32767.0 * (g)))
 
 
 //____________________________________________________________________________________________________________
@@ -44,9 +46,9 @@ extern DSP_CTRL_OBJECT *pDSP_ObjCtrl;
 //static api header
 static void CCKManager_CreateTask(void);
 static void CCKManager_GetNoiseVersionNum(uint8 * vNum);
-static void CCKManager_GetNoiseMemAddr(void);
+static void CCKManager_InitNoiseFormat(void);
+static void CCKManager_RenderNoise(int16 *pDest, uint16 frames);
 static void CCKManager_ServiceManage( void *pvParameters );
-static uint32 CCKManager_GetNoiseFileStartAddr(void);
 static void CCKManager_Start(const void * params);
 static void CCKManager_Stop(const void * params);
 
@@ -60,9 +62,9 @@ const CCK_MANAGE_OBJECT   CCKManage =
 {
     CCKManager_CreateTask,
     CCKManager_GetNoiseVersionNum,
-    CCKManager_GetNoiseFileStartAddr,
     CCKManager_Start,
-    CCKManager_Stop
+    CCKManager_Stop,
+    CCKManager_RenderNoise
 };
 const CCK_MANAGE_OBJECT *pCCKManage_ObjCtrl = &CCKManage;
 
@@ -95,40 +97,47 @@ typedef enum{
     CCK_OUTPUT_SUBWOOFER_CHANNEL
 }xCCKOutputChannel;
 
-typedef enum{
-    CCK_INDEX_L = 0,
-    CCK_INDEX_R,
-    CCK_INDEX_C,
-    CCK_INDEX_Ls,
-    CCK_INDEX_Rs,
-    CCK_INDEX_W
-}xCCKIndexNoiseStartAddr;
+static void CCKManager_SetNoiseChannel(xCCKOutputChannel ch);
 
+typedef struct{
+    uint16 gain;        /* Q15 */
+    uint16 hpAlpha;     /* Q15 one-pole highpass */
+    uint16 lpAlpha;     /* Q15 one-pole lowpass */
+}xCCKNoiseShape;
+
+typedef struct{
+    uint32 rand;        /* xorshift32 state */
+    uint32 count;       /* trailing zeros pick the row to renew */
+    int32 rows[CCK_NOISE_ROWS];
+    int32 sum;
+    int32 hpState;      /* filter states are kept << 8 */
+    int32 lpState;
+    const xCCKNoiseShape *pShape;
+}xCCKPinkNoise;
 
 typedef struct{
     xCCKOutputChannel outputCH;
-    xCCKIndexNoiseStartAddr indexAddr;
-    CS4953xAudioRoute route;
+    CS49844AudioRoute route;
+    xCCKNoiseShape shape;
 }xCCKNoiseIndexMap;
 //____________________________________________________________________________________________________________
 /*static variable*/
 static xCCKManagerParams mCCKManagerParams;
 static xCCKManagerParams mCCKMediaParams;
 static FSE_WaveFormat mNoiseWaveFormat;
-static uint8 WaveHeaderBuf[WaveHeaderSize] ={ 0x00 };
-static uint32 mNoiseInFlashStartAddr = 0;
-static uint32 mNoiseInFlashMemAddr[6]={0,0,0,0,0,0};
+static xCCKPinkNoise mCCKPinkNoise;
 static xCCKManagerState mCCKManagerState = CCK_EVENT_IDLE;
 static xCCKOutputChannel mCCKOutputChannel = CCK_OUTPUT_NULL;
 static xHMISystemParams* pCCK_HMIParams;
 
 static const xCCKNoiseIndexMap mCCKNoiseIndexMap[] = {
-    {CCK_OUTPUT_LEFT_CHANNEL,CCK_INDEX_L,ROUTE_FL},
-    {CCK_OUTPUT_CENTER_CHANNEL,CCK_INDEX_C,ROUTE_CENTER},
-    {CCK_OUTPUT_RIGHT_CHANNEL,CCK_INDEX_R,ROUTE_FR},
-    {CCK_OUTPUT_RIGHT_REAR_CHANNEL,CCK_INDEX_Rs,ROUTE_RR},
-    {CCK_OUTPUT_LEFT_REAR_CHANNEL,CCK_INDEX_Ls,ROUTE_RL},
-    {CCK_OUTPUT_SUBWOOFER_CHANNEL,CCK_INDEX_W,ROUTE_LFE0}
+    /* The satellites get no rumble below 80Hz, the woofer is kept to 25~120Hz */
+    {CCK_OUTPUT_LEFT_CHANNEL,ROUTE_FL,{CCK_NOISE_GAIN(0.75),CCK_NOISE_ALPHA(80),CCK_NOISE_BYPASS}},
+    {CCK_OUTPUT_CENTER_CHANNEL,ROUTE_CENTER,{CCK_NOISE_GAIN(0.75),CCK_NOISE_ALPHA(80),CCK_NOISE_BYPASS}},
+    {CCK_OUTPUT_RIGHT_CHANNEL,ROUTE_FR,{CCK_NOISE_GAIN(0.75),CCK_NOISE_ALPHA(80),CCK_NOISE_BYPASS}},
+    {CCK_OUTPUT_RIGHT_REAR_CHANNEL,ROUTE_RR,{CCK_NOISE_GAIN(0.75),CCK_NOISE_ALPHA(80),CCK_NOISE_BYPASS}},
+    {CCK_OUTPUT_LEFT_REAR_CHANNEL,ROUTE_RL,{CCK_NOISE_GAIN(0.75),CCK_NOISE_ALPHA(80),CCK_NOISE_BYPASS}},
+    {CCK_OUTPUT_SUBWOOFER_CHANNEL,ROUTE_LFE0,{CCK_NOISE_GAIN(1.0),CCK_NOISE_ALPHA(25),CCK_NOISE_ALPHA(120)}}
 };
 static const uint8 mCCKNoiseIndexMapSize = sizeof(mCCKNoiseIndexMap)/sizeof(mCCKNoiseIndexMap[0]);
 
@@ -159,7 +168,7 @@ static void CCKManager_CreateTask(void)
         vTaskSuspend( mCCKManagerParams.TaskHandle );
      }
      
-    CCKManager_GetNoiseMemAddr();
+    CCKManager_InitNoiseFormat();
     pUSBMedia_ObjCtrl->assign_cck_waveFormat(&mNoiseWaveFormat);
 
     CCKMedia_CreateTask();
@@ -221,6 +230,12 @@ static void CCKManager_Stop(const void * params)
 {
     pCCK_HMIParams = ( xHMISystemParams *)params;
 
+    /* HMI stops the channel check on every setting change, the tasks may never have been created */
+    if ( mCCKMediaParams.TaskHandle == NULL )
+    {
+        return;
+    }
+
     if ( xTaskIsTaskSuspended( mCCKMediaParams.TaskHandle ) != pdPASS ) /*task is working*/
     {
         pUSBMedia_ObjCtrl->media_stop();
@@ -243,54 +258,126 @@ static void CCKManager_GetNoiseVersionNum(uint8 * vNum)
     sFLASH_ReadBuffer(vNum, addr, BYTE_OF_VERSION);
 }
 
-static uint32 CCKManager_GetNoiseFileStartAddr(void)
+/* The media manager plays the noise like a mono 16 bit wave of CCK_NOISE_PLAY_MSEC */
+static void CCKManager_InitNoiseFormat(void)
 {
-    return mNoiseInFlashStartAddr;
+    MEMSET(&mNoiseWaveFormat, 0, sizeof(mNoiseWaveFormat));
+    mNoiseWaveFormat.FormatTag = 1;     /* PCM */
+    mNoiseWaveFormat.NumChannels = CHANNEL_MONO;
+    mNoiseWaveFormat.SampleRate = CCK_NOISE_SAMPLE_RATE;
+    mNoiseWaveFormat.BitsPerSample = 16;
+    mNoiseWaveFormat.BlockAlign = 2;
+    mNoiseWaveFormat.ByteRate = CCK_NOISE_SAMPLE_RATE*2;
+    mNoiseWaveFormat.DataSize = (CCK_NOISE_SAMPLE_RATE/1000)*2*CCK_NOISE_PLAY_MSEC;
+    mNoiseWaveFormat.RIFFchunksize = mNoiseWaveFormat.DataSize + 36;
 }
 
-static void CCKManager_GetNoiseMemAddr(void)
+static uint32 CCKManager_NoiseRand(void)
 {
-    uint8 i;   uint32 addr = 0;
-    FSE_FormatCheck check; 
+    uint32 x = mCCKPinkNoise.rand;
 
-    addr += BYTE_OF_VERSION;    /* version information is stored at first and second byte in Noise Check bin file (Angus 2014/2/12) */
-    mNoiseInFlashMemAddr[0] = addr;
-    for(i=1;i<TotalCheckFile;i++)
-    {
-        MEMSET(WaveHeaderBuf,0xff,sizeof(WaveHeaderBuf));
-        sFLASH_ReadBuffer(WaveHeaderBuf, addr, WaveHeaderSize);
-        check = pUSBFSE_Object->formatCheck(NULL, &(mNoiseWaveFormat),WaveHeaderBuf,1);
-        
-        if(check == FSE_Valid_WAVE_File)
-        {
-            addr += mNoiseWaveFormat.RIFFchunksize + BYTE_OF_ChunkID + BYTE_OF_ChunkSize;
-            mNoiseInFlashMemAddr[i] = addr;
-        }
-    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    mCCKPinkNoise.rand = x;
+
+    return x;
 }
 
-static uint32 CCKManager_GetNoiseStartAddr(xCCKOutputChannel ch)
+/* white sample in -2048..2047 */
+#define CCK_NOISE_WHITE()   ((int32)CCKManager_NoiseRand() >> 20)
+
+/* Route the channel and restart the generator from its own seed, every run sounds the same */
+static void CCKManager_SetNoiseChannel(xCCKOutputChannel ch)
 {
-    uint32 startAddr = 0;;
-    uint8 i;
+    uint8 i, j;
 
     for(i=0;i<mCCKNoiseIndexMapSize;i++)
     {
         if(mCCKNoiseIndexMap[i].outputCH == ch)
         {
-            startAddr = mNoiseInFlashMemAddr[mCCKNoiseIndexMap[i].indexAddr];
             pDSP_ObjCtrl->setAudioRoute(mCCKNoiseIndexMap[i].route);
+
+            MEMSET(&mCCKPinkNoise, 0, sizeof(mCCKPinkNoise));
+            mCCKPinkNoise.rand = CCK_NOISE_SEED + (uint32)ch*0x9E3779B9;
+            for(j=0;j<CCK_NOISE_ROWS;j++)
+            {
+                mCCKPinkNoise.rows[j] = CCK_NOISE_WHITE();
+                mCCKPinkNoise.sum += mCCKPinkNoise.rows[j];
+            }
+            mCCKPinkNoise.pShape = &mCCKNoiseIndexMap[i].shape;
             break;
         }
     }
-    return startAddr;
+}
+
+/* Voss-McCartney pink noise: row k is renewed when the sample count has k trailing zeros,
+   so each row holds twice as long as the one before; the sum plus one white term falls
+   at -3dB/octave. Peak is 13*2048 before the band limit and gain. */
+static void CCKManager_RenderNoise(int16 *pDest, uint16 frames)
+{
+    xCCKPinkNoise *pNoise = &mCCKPinkNoise;
+    const xCCKNoiseShape *pShape = pNoise->pShape;
+    uint32 count, row;
+    int32 white, x;
+
+    if(pShape == NULL)
+    {
+        MEMSET(pDest, 0, (frames*4));
+        return;
+    }
+
+    while(frames--)
+    {
+        count = ++pNoise->count;
+        row = 0;
+        while(((count & 1) == 0) && (row < CCK_NOISE_ROWS))
+        {
+            count >>= 1;
+            row++;
+        }
+
+        if(row < CCK_NOISE_ROWS)
+        {
+            white = CCK_NOISE_WHITE();
+            pNoise->sum += white - pNoise->rows[row];
+            pNoise->rows[row] = white;
+        }
+
+        x = (pNoise->sum + CCK_NOISE_WHITE()) << 8;
+
+        if(pShape->hpAlpha != CCK_NOISE_BYPASS)
+        {
+            pNoise->hpState += (int32)(((int64_t)(x - pNoise->hpState) * pShape->hpAlpha) >> 15);
+            x -= pNoise->hpState;
+        }
+
+        if(pShape->lpAlpha != CCK_NOISE_BYPASS)
+        {
+            pNoise->lpState += (int32)(((int64_t)(x - pNoise->lpState) * pShape->lpAlpha) >> 15);
+            x = pNoise->lpState;
+        }
+
+        x = ((x >> 8) * (int32)pShape->gain) >> 15;
+        if(x > 32767)
+        {
+            x = 32767;
+        }
+        else if(x < -32768)
+        {
+            x = -32768;
+        }
+
+        pDest[0] = (int16)x;
+        pDest[1] = (int16)x;
+        pDest += 2;
+    }
 }
 
 
 static void CCKManager_ServiceManage( void *pvParameters )
 {
-    int i;  static int repeatCnt = 0;
-    FSE_FormatCheck res;
+    static int repeatCnt = 0;
     for(;;)
     {
         switch(mCCKManagerState)
@@ -313,24 +400,9 @@ static void CCKManager_ServiceManage( void *pvParameters )
                 if(mCCKOutputChannel < CCK_OUTPUT_SUBWOOFER_CHANNEL)
                 {
                     mCCKOutputChannel++;
-                    mNoiseInFlashStartAddr = CCKManager_GetNoiseStartAddr(mCCKOutputChannel);  
-
-                    for(i=0;i<10;i++)
-                    {
-                        sFLASH_ReadBuffer(WaveHeaderBuf, mNoiseInFlashStartAddr, WaveHeaderSize);
-                        res = pUSBFSE_Object->formatCheck(NULL, &(mNoiseWaveFormat),WaveHeaderBuf,1);
-                        if(res == FSE_Valid_WAVE_File)
-                            break;
-                    }
-
-                    if(res == FSE_Valid_WAVE_File)
-                    {
-                        mCCKManagerState = CCK_INIT_PLAY_NOISE;
-                    }
-                    else
-                    {
-                        mCCKManagerState = CCK_END_NOISE;
-                    }
+                    /* No header to read, the generator is ready once the channel is routed */
+                    CCKManager_SetNoiseChannel(mCCKOutputChannel);
+                    mCCKManagerState = CCK_INIT_PLAY_NOISE;
                 }
                 else
                 {
@@ -82,9 +82,24 @@ static void ControlCommandsManager_handleCommand(
     void *params
 );
 
+/**
+ * Returns the number of parameter bytes a command carries. For the commands
+ * with a variable length the fixed part is returned until it is available.
+ *
+ * @param command       The command opcode.
+ * @param params        The parameters received so far.
+ * @param available     Number of parameter bytes received so far.
+ */
+static uint16 ControlCommandsManager_paramsLength(
+    uint8 command,
+    const uint8 *params,
+    uint16 available
+);
+
 const CTRL_CMD_HANDLE_OBJECT CtrlCommand_api =
 {
 	ControlCommandsManager_handleCommand,
+	ControlCommandsManager_paramsLength
 };
 const CTRL_CMD_HANDLE_OBJECT *pCtrlCmd_ObjCtrl = &CtrlCommand_api;
 
@@ -202,6 +217,43 @@ static void ControlCommandsManager_handleCommand(
     }
 }
 
+static uint16 ControlCommandsManager_paramsLength(
+    uint8 command,
+    const uint8 *params,
+    uint16 available
+)
+{
+    switch (command)
+    {
+        case CTRL_OPCODE_I2C_WRITE:
+		{
+			/* whichI2C, slaveAddress, innerAddress, counter, value[counter] */
+			if ( available < 4 )
+				return 4;
+
+			return ( 4 + params[3] );
+		}
+
+        case CTRL_OPCODE_I2C_READ:
+            return sizeof(Command_I2CReadParams);
+
+		case CTRL_OPCODE_GPIO_OUTPUT_CTRL:
+			return sizeof(Command_GpioSetParams);
+
+		case CTRL_OPCODE_EEPROM_WRITE:
+		{
+			/* address, size, value[size] */
+			if ( available < 4 )
+				return 4;
+
+			return ( 4 + (params[2] | (params[3] << 8)) );
+		}
+
+        default:
+            return 0;
+    }
+}
+
 static void ControlCommandsManager_I2CWriteCommand(
     Command_I2CWriteParams *params
 )
@@ -17,6 +17,7 @@ typedef enum
 typedef struct _CTRL_CMD_CTRL
 {
   void (*control_command)(uint8 command, void *params);
+  uint16 (*params_length)(uint8 command, const uint8 *params, uint16 available);
 }CTRL_CMD_HANDLE_OBJECT;
 
 
@@ -18,7 +18,6 @@
 #define configReturnChecksum 1
 #define SERVICE_HANLDER_TIME_TICK  TASK_MSEC2TICKS(10)    
 #define FC_QUEUE_LENGTH 4
-#define FACTORY_PACKAGE_MAX 28 /*header+ command type + data[24] + checksum*/
 
 #define FAC_CMD_TYPE_SET 0x63
 #define FAC_CMD_TYPE_GET 0x73    
@@ -58,6 +57,8 @@ typedef enum
     FAC_OPCODE_LED_CONTROL = 0x12,
     FAC_OPCODE_AUDIO_FORMAT = 0x13,
     FAC_OPCODE_BTM_CLEAN_DEVICE_LIST = 0x14,
+    FAC_OPCODE_DSP_ULD_CACHE = 0x15,
+    FAC_OPCODE_DSP_IRQ_LATENCY = 0x16,
     FAC_OPCODE_UNSUPPORT
 }FAC_OPCODE;
 //_______________________________________________________________
@@ -118,6 +119,20 @@ extern uint8 ButtonCmdDispatcher_getSwitchStatus( void );
 
 extern uint8 ButtonLowLevel_get_btn_ADC_Value( void );
 
+#if ( configCS4953x_ULD_CACHE == 1 )
+extern void cs49844_ULDCache_getStatistics( uint16 *hit, uint16 *miss, uint32 *saved_bytes );
+
+extern void cs49844_ULDCache_resetStatistics( void );
+#endif
+
+#if ( configCS4953x_IRQ_ISR == 1 )
+#define FAC_DSP_IRQ_LATENCY_BINS 8
+
+extern void cs49844_FchDetector_getStatistics( uint16 *wakeups, uint16 *histogram );
+
+extern void cs49844_FchDetector_resetStatistics( void );
+#endif
+
 //________________________________________________________________
 static bool FactoryCmdHandler_transfer2Task( void *params ); 
 
@@ -855,6 +870,30 @@ static void FactoryCmdHandler_setCommandHandle( uint8 *pdata )
         }
             break;
 
+#if ( configCS4953x_ULD_CACHE == 1 )
+        case FAC_OPCODE_DSP_ULD_CACHE: /*clear the counters*/
+        {
+            if ( pFacParams->op_mode == MODE_FACTORY )
+            {
+                cs49844_ULDCache_resetStatistics( );
+                FactoryCmdHandler_ackSuccess( pdata );
+            }
+        }
+            break;
+#endif
+
+#if ( configCS4953x_IRQ_ISR == 1 )
+        case FAC_OPCODE_DSP_IRQ_LATENCY: /*clear the counters*/
+        {
+            if ( pFacParams->op_mode == MODE_FACTORY )
+            {
+                cs49844_FchDetector_resetStatistics( );
+                FactoryCmdHandler_ackSuccess( pdata );
+            }
+        }
+            break;
+#endif
+
         default:
             break;
     }
@@ -1077,6 +1116,56 @@ static void FactoryCmdHandler_getCommandHandle( uint8 *pdata )
         }
             break;
 
+#if ( configCS4953x_ULD_CACHE == 1 )
+        case FAC_OPCODE_DSP_ULD_CACHE: /*hit(2), miss(2), bytes not read from flash(4), MSB first*/
+        {
+            if ( pFacParams->op_mode == MODE_FACTORY )
+            {
+                uint16 hit, miss;
+                uint32 saved_bytes;
+
+                cs49844_ULDCache_getStatistics( &hit, &miss, &saved_bytes );
+                *( pdata + FAC_RECV_DATA_POS ) = (uint8)( ( hit&0xFF00 ) >> 8 );
+                *( pdata + FAC_RECV_DATA_POS + 1 ) = (uint8)( hit&0x00FF );
+                *( pdata + FAC_RECV_DATA_POS + 2 ) = (uint8)( ( miss&0xFF00 ) >> 8 );
+                *( pdata + FAC_RECV_DATA_POS + 3 ) = (uint8)( miss&0x00FF );
+                *( pdata + FAC_RECV_DATA_POS + 4 ) = (uint8)( ( saved_bytes >> 24 )&0xFF );
+                *( pdata + FAC_RECV_DATA_POS + 5 ) = (uint8)( ( saved_bytes >> 16 )&0xFF );
+                *( pdata + FAC_RECV_DATA_POS + 6 ) = (uint8)( ( saved_bytes >> 8 )&0xFF );
+                *( pdata + FAC_RECV_DATA_POS + 7 ) = (uint8)( saved_bytes&0xFF );
+                *( pdata + FAC_RECV_CMD_LEN_POS) = 8+6;
+
+                FactoryCmdHandler_returnData( pdata );
+            }
+        }
+            break;
+#endif
+
+#if ( configCS4953x_IRQ_ISR == 1 )
+        case FAC_OPCODE_DSP_IRQ_LATENCY: /*detector wakeups(2), latency bins 0,1,2-3,...,64+ ms (2 each), MSB first*/
+        {
+            if ( pFacParams->op_mode == MODE_FACTORY )
+            {
+                uint16 wakeups;
+                uint16 histogram[FAC_DSP_IRQ_LATENCY_BINS];
+                uint8 i;
+
+                cs49844_FchDetector_getStatistics( &wakeups, histogram );
+                *( pdata + FAC_RECV_DATA_POS ) = (uint8)( ( wakeups&0xFF00 ) >> 8 );
+                *( pdata + FAC_RECV_DATA_POS + 1 ) = (uint8)( wakeups&0x00FF );
+                for( i = 0; i < FAC_DSP_IRQ_LATENCY_BINS; i++ )
+                {
+                    *( pdata + FAC_RECV_DATA_POS + 2 + (i*2) ) = (uint8)( ( histogram[i]&0xFF00 ) >> 8 );
+                    *( pdata + FAC_RECV_DATA_POS + 3 + (i*2) ) = (uint8)( histogram[i]&0x00FF );
+                }
+                *( pdata + FAC_RECV_CMD_LEN_POS) = 2+(FAC_DSP_IRQ_LATENCY_BINS*2)+6;
+
+                FactoryCmdHandler_returnData( pdata );
+            }
+        }
+            break;
+#endif
+
         default:
             break;
 
@@ -4,6 +4,8 @@
 #include "Defs.h"
 #include "api_typedef.h"
 
+#define FACTORY_PACKAGE_MAX 28 /*header+ command type + data[24] + checksum*/
+
 typedef struct _FACTORY_CMD_CTRL
 {
   bool (*Transfer2Task)( void *params );
@@ -16,5 +16,9 @@ typedef struct _HDMI_DEVICE_CTRL
 #endif
 }HDMI_DEVICE_MANAGER_OBJECT;
 
+#if ( configSIL953x_ISR == 1 ) && ( configSII953x_INT_WAKEUP == 1 )
+void HdmiDeviceManager_RepeaterWakeupFromISR( void );
+#endif
+
 
 #endif 
@@ -17,6 +17,12 @@
 #define POWER_STATE_SUBSYS_MAX 3
 #define POWER_HANDLER_TIMEOUT 160
 
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+#define POWER_BOOT_BIT(stage) ( 1 << (stage) )
+#define POWER_BOOT_POLL_TICK TASK_MSEC2TICKS(5)
+#define POWER_BOOT_WAIT_TIMEOUT TASK_MSEC2TICKS(1000)
+#endif
+
 //____________________________________________________________________________________________________________
 /*typedef enum{
     POWER_HANDLE_IDLE,
@@ -27,6 +33,9 @@
 typedef struct POWER_HANDLE_PARAMETERS
 {
     xTaskHandle TaskHandle;
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+    xSemaphoreHandle xWakeup; /*given on a power request, the task does not wait for its tick*/
+#endif
  } xPowerHandleParams;
 
 typedef struct POWER_HANDLE_SUBSYSTEM
@@ -35,6 +44,14 @@ typedef struct POWER_HANDLE_SUBSYSTEM
 	xPowerStateSubSystem pwr_state;
 } xPowerStateSubsystem;
 
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+typedef struct POWER_BOOT_STEP
+{
+	uint8 depends;		/*POWER_BOOT_BIT of the stages which have to be done first*/
+	uint16 settle_msec[POWER_BOOT_STAGE_MAX];	/*counted from the done time of each of them*/
+} xPowerBootStep;
+#endif
+
 //____________________________________________________________________________________________________________
 //static api header
 static void PowerHandler_Task( void *pvParameters );
@@ -60,6 +77,12 @@ static void PowerHandler_PowerCtrl( uint8 val );
 static uint8 PowerHandler_getSystemResetType( void );
 
 static void PowerManager_clrSystemResetType( void );
+
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+static bool PowerHandler_BootWait( xPowerBootStage stage );
+
+static void PowerHandler_BootDone( xPowerBootStage stage );
+#endif
 //____________________________________________________________________________________________________________
 const POWER_HANDLE_OBJECT PowerHandle =
 {
@@ -73,6 +96,10 @@ const POWER_HANDLE_OBJECT PowerHandle =
     PowerHandler_TurnOnDone,
     PowerHandler_getSystemResetType,
     PowerManager_clrSystemResetType,
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+    PowerHandler_BootWait,
+    PowerHandler_BootDone,
+#endif
 };
 const POWER_HANDLE_OBJECT *pPowerHandle_ObjCtrl = &PowerHandle;
 
@@ -84,9 +111,36 @@ static uint8 mSubsysHandle = 0;
 static POWER_STATE mPowerState = POWER_OFF;
 static xPowerStateSubsystem pwr_state_subsys[POWER_STATE_SUBSYS_MAX];
 
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+/*Indexed by xPowerBootStage, settle times in the order of xPowerBootStage.
+ The audio reset and device init keep the shortest margins the fixed 200/100 msec
+ reset delays gave behind the 100 msec power tick. No SiI953x power up time is
+ documented here, so HDMI keeps the 300 msec after the rails it always had. It
+ does not depend on the audio stages: the HDMI task waits for it while the audio
+ system handler brings the SRC, AMP and ADC up.*/
+static const xPowerBootStep mPowerBootStep[POWER_BOOT_STAGE_MAX] =
+{
+	{ 0, { 0, 0, 0, 0 } },																/*POWER_BOOT_RAILS*/
+	{ POWER_BOOT_BIT(POWER_BOOT_RAILS), { 100, 0, 0, 0 } },								/*POWER_BOOT_AUDIO_RESET*/
+	{ POWER_BOOT_BIT(POWER_BOOT_AUDIO_RESET), { 0, 100, 0, 0 } },						/*POWER_BOOT_AUDIO_DEVICES*/
+	{ POWER_BOOT_BIT(POWER_BOOT_RAILS), { 300, 0, 0, 0 } },								/*POWER_BOOT_HDMI*/
+};
+
+static uint8 mPowerBootDone = 0;
+static portTickType mPowerBootTick[POWER_BOOT_STAGE_MAX];
+#endif
+
 //____________________________________________________________________________________________________________
 static void PowerHandler_Initialize( void )
 {
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+	vSemaphoreCreateBinary( mPowerHandleParams.xWakeup );
+	if ( mPowerHandleParams.xWakeup != NULL )
+	{
+		xSemaphoreTake( mPowerHandleParams.xWakeup, BLOCK_TIME(0) );
+	}
+#endif
+
 	if ( xTaskCreate( 
 			PowerHandler_Task, 
 			( portCHAR * ) "Power_Task", 
@@ -144,6 +198,8 @@ static void PowerHandler_TurnOnDone( uint8 handle )
 	if ( handle == 0 )
 		return;
 
+	DEBUG_LATENCY_END( DEBUG_LATENCY_POWER_UP );
+
 	for ( i = 0; i < POWER_STATE_SUBSYS_MAX; i++ )
 	{
 		if ( pwr_state_subsys[i].handle == handle )
@@ -215,30 +271,117 @@ static xPowerHandleState PowerHandler_getPowerHandleState(void)
     return mPowerHandleState;
 }
 
+static void PowerHandler_Wakeup( void )
+{
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+	if ( mPowerHandleParams.xWakeup != NULL )
+	{
+		xSemaphoreGive( mPowerHandleParams.xWakeup );
+	}
+#endif
+}
+
 static void PowerHandler_PowerToggle(void)
 {
 	if ( mPowerState == POWER_OFF )
 	{
+		DEBUG_LATENCY_BEGIN( DEBUG_LATENCY_POWER_UP );
 		mPowerHandleState = POWER_HANDLE_UP; 
 	}
 	else if( mPowerState == POWER_ON )
 	{
 		mPowerHandleState = POWER_HANDLE_DOWN;  
 	}
+	PowerHandler_Wakeup();
 }
 
 static void PowerHandler_PowerCtrl( uint8 val )
 {
 	if ( val == POWER_UP )
 	{
+		DEBUG_LATENCY_BEGIN( DEBUG_LATENCY_POWER_UP );
 		mPowerHandleState = POWER_HANDLE_UP;
 	}
 	else if ( val == POWER_DOWN )
 	{
 		mPowerHandleState = POWER_HANDLE_DOWN;
 	}
+	PowerHandler_Wakeup();
 }
 
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+static void PowerHandler_BootReset( void )
+{
+	taskENTER_CRITICAL();
+	mPowerBootDone = 0;
+	taskEXIT_CRITICAL();
+}
+
+static bool PowerHandler_BootWait( xPowerBootStage stage )
+{
+	const xPowerBootStep *pStep;
+	portTickType settle;
+	portTickType elapsed;
+	portTickType remain = 0;
+	portTickType waited = 0;
+	uint8 i;
+
+	if ( stage >= POWER_BOOT_STAGE_MAX )
+		return FALSE;
+
+	pStep = &mPowerBootStep[stage];
+
+	while ( ( mPowerBootDone & pStep->depends ) != pStep->depends )
+	{
+		if ( waited >= POWER_BOOT_WAIT_TIMEOUT )
+		{
+			/*a late stage must not hang the power up, the caller decides what to skip*/
+			TRACE_ERROR((0, "power boot stage %d waits too long for 0x%X", stage, ( pStep->depends & ~mPowerBootDone ) ));
+			return FALSE;
+		}
+		vTaskDelay( POWER_BOOT_POLL_TICK );
+		waited += POWER_BOOT_POLL_TICK;
+	}
+
+	/*wait for the dependency whose settle time ends last*/
+	for ( i = 0; i < POWER_BOOT_STAGE_MAX; i++ )
+	{
+		if ( pStep->depends & POWER_BOOT_BIT(i) )
+		{
+			settle = TASK_MSEC2TICKS( pStep->settle_msec[i] );
+			elapsed = xTaskGetTickCount() - mPowerBootTick[i];
+			if ( ( elapsed < settle ) && ( ( settle - elapsed ) > remain ) )
+			{
+				remain = settle - elapsed;
+			}
+		}
+	}
+
+	if ( remain > 0 )
+	{
+		vTaskDelay( remain );
+	}
+
+	return TRUE;
+}
+
+static void PowerHandler_BootDone( xPowerBootStage stage )
+{
+	if ( stage >= POWER_BOOT_STAGE_MAX )
+		return;
+
+	taskENTER_CRITICAL();
+	mPowerBootTick[stage] = xTaskGetTickCount();
+	mPowerBootDone |= POWER_BOOT_BIT(stage);
+	taskEXIT_CRITICAL();
+
+#if ( configDEBUG_LATENCY == 1 )
+	TRACE_DEBUG((0, "power boot stage %d done at %d ms", stage, 
+		( ( mPowerBootTick[stage] - mPowerBootTick[POWER_BOOT_RAILS] ) * portTICK_RATE_MS ) ));
+#endif
+}
+#endif
+
 static void PowerHandler_Task( void *pvParameters )
 {
 	static uint8 timeout = 0;
@@ -259,6 +402,9 @@ static void PowerHandler_Task( void *pvParameters )
 				GPIOMiddleLevel_Set(__O_EN_24V);
 				GPIOMiddleLevel_Set(__O_DE_5V);
 				GPIOMiddleLevel_Set(__O_EN_1V);
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+				PowerHandler_BootDone( POWER_BOOT_RAILS );
+#endif
 				mPowerState = POWER_ON;
 				mPowerHandleState = POWER_HANDLE_IDLE;
 			}
@@ -271,6 +417,9 @@ static void PowerHandler_Task( void *pvParameters )
 					GPIOMiddleLevel_Clr(__O_EN_24V);
 					GPIOMiddleLevel_Clr(__O_DE_5V);
 					GPIOMiddleLevel_Clr(__O_EN_1V);
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+					PowerHandler_BootReset();
+#endif
 					vTaskDelay(TASK_MSEC2TICKS(100));
                     TRACE_DEBUG((0, "system shut down"));
 					mPowerState = POWER_OFF;
@@ -288,6 +437,9 @@ static void PowerHandler_Task( void *pvParameters )
 						GPIOMiddleLevel_Clr(__O_EN_24V);
 						GPIOMiddleLevel_Clr(__O_DE_5V);
 						GPIOMiddleLevel_Clr(__O_EN_1V);
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+						PowerHandler_BootReset();
+#endif
 						vTaskDelay(TASK_MSEC2TICKS(100));
 						mPowerHandleState = POWER_HANDLE_IDLE;
 						mPowerState = POWER_OFF;
@@ -305,7 +457,18 @@ static void PowerHandler_Task( void *pvParameters )
 		
 		}
 
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+		if ( mPowerHandleParams.xWakeup != NULL )
+		{
+			xSemaphoreTake( mPowerHandleParams.xWakeup, POWER_HANDLER_TICK );
+		}
+		else
+		{
+			vTaskDelay( POWER_HANDLER_TICK );
+		}
+#else
         vTaskDelay( POWER_HANDLER_TICK );
+#endif
     }
 }
 
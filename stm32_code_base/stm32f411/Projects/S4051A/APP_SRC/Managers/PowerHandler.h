@@ -5,6 +5,17 @@
 #include "api_typedef.h"
 #include "device_config.h"
 
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+/*Power up stages, the dependencies and settle times are in PowerHandler.c*/
+typedef enum
+{
+    POWER_BOOT_RAILS = 0,       /*24V, 5V and 1V switched on*/
+    POWER_BOOT_AUDIO_RESET,     /*DSP, SRC, ADC, AMP and RF out of reset*/
+    POWER_BOOT_AUDIO_DEVICES,   /*SRC, AMP and ADC initialized, the ULD loader started*/
+    POWER_BOOT_HDMI,            /*SiI953x asked to leave standby*/
+    POWER_BOOT_STAGE_MAX
+}xPowerBootStage;
+#endif
 
 typedef struct _Power_HANDLE
 {
@@ -18,6 +29,10 @@ typedef struct _Power_HANDLE
     void (*turn_on_done)( uint8 handle );
     uint8 (*getSystemResetType)( void );
     void (*clrSystemResetType)( void );
+#if ( configPOWER_BOOT_SEQUENCER == 1 )
+    bool (*boot_wait)( xPowerBootStage stage );   /*FALSE if a dependency was never done*/
+    void (*boot_done)( xPowerBootStage stage );
+#endif
 }POWER_HANDLE_OBJECT;
 
 
@@ -13,6 +13,40 @@
 
 #define PARAMETER_SIZER (sizeof(xHMISystemParams)/sizeof(uint8))
 
+#if ( configSTORAGE_JOURNAL == 1 )
+/* User parameter journal.
+ * SendEvent only updates m_liveParams. When nothing has changed for
+ * configSTORAGE_JOURNAL_DELAY msec, or at SYSTEM_DOWN / SAVE_USER_SETTING,
+ * the bytes which differ from m_storedParams are appended to
+ * STORAGE_PARTITION_5 as records. The records run through the partition; when
+ * it is full m_storedParams becomes the new base in the USER_PARAMETERS cell
+ * and the log starts over at slot 0.
+ *
+ * record : seq, offset, value, ~(seq^offset^value)
+ * USER_JOURNAL_SEQ holds the seq of slot 0. At power up the records are
+ * replayed on the base from slot 0 for as long as they are valid and their seq
+ * counts up.
+ *
+ * The seq is only 8 bits, so an old record from an earlier pass can carry the
+ * very seq the replay expects. The slot after the last record therefore always
+ * holds an end record, which never passes the check. An append writes its
+ * records after the first one together with the new end record, and then the
+ * first one over the old end record, so a power loss leaves either the old or
+ * the new log. When the log starts over, slot 0 is made an end record before
+ * the new seq is written.
+ */
+#define JOURNAL_RECORD_SIZE 4
+#define JOURNAL_RECORD_SEQ 0
+#define JOURNAL_RECORD_OFFSET 1
+#define JOURNAL_RECORD_VALUE 2
+#define JOURNAL_RECORD_CHECK 3
+
+#define JOURNAL_CHECK(rec) ((uint8)~((rec)[JOURNAL_RECORD_SEQ]^(rec)[JOURNAL_RECORD_OFFSET]^(rec)[JOURNAL_RECORD_VALUE]))
+
+/*0xFF ^ 0xFF ^ 0xFF inverted is 0x00, so the erased pattern fails the check*/
+#define JOURNAL_END 0xFF
+#endif
+
 //___________________________________________________________________________________________________
 
 static int8 StorageDeiveManager_initialize( xHMISystemParams *params );
@@ -23,6 +57,16 @@ static bool StorageDeviceManager_read( STORAGE_DEVICE_CELL cell, void *buff );
 
 static bool StorageDeviceManager_write( STORAGE_DEVICE_CELL cell, void *buff );
 
+#if ( configSTORAGE_JOURNAL == 1 )
+static void StorageDeviceManager_journalReset( void );
+
+static bool StorageDeviceManager_journalReplay( xHMISystemParams *params );
+
+static bool StorageDeviceManager_journalCommit( void );
+
+static void StorageDeviceManager_journalTask( void *pvParameters );
+#endif
+
 
 //___________________________________________________________________________________________________
 extern IR_CMD_PROGRAM_OBJECT *pIR_PrgRemote_ObjCtrl;
@@ -36,6 +80,17 @@ const STORAGE_DEVICE_MANAGER_OBJECT STORAGE_OBJ =
 };
 const STORAGE_DEVICE_MANAGER_OBJECT *pSDM_ObjCtrl = &STORAGE_OBJ;
 
+#if ( configSTORAGE_JOURNAL == 1 )
+static xHMISystemParams m_liveParams;   /*what the HMI has set*/
+static xHMISystemParams m_storedParams; /*what the EEPROM gives at power up*/
+static uint8 m_journalRecords[(PARAMETER_SIZER+1)*JOURNAL_RECORD_SIZE];    /*records and the end record*/
+static uint16 m_journalSlots;
+static uint16 m_journalSlot;            /*next free record*/
+static uint8 m_journalSeq;              /*seq of the next record*/
+static xSemaphoreHandle m_journalChanged = NULL;
+static xSemaphoreHandle m_journalMutex = NULL;
+#endif
+
 const static xHMISystemParams DefaultSystemParams = { 
     SYS_EVENT_NULL,
     MODE_USER,    
@@ -91,6 +146,26 @@ static bool StorageDeiveManager_InstrSender( void *params )
         case SYS_EVENT_SRS_TSHD_SET:
         case SYS_EVENT_NIGHT_MODE_SET:
         case SYS_EVENT_AV_DELAY_SET:
+#if ( configSTORAGE_JOURNAL == 1 )
+        {
+            taskENTER_CRITICAL();
+            MEMCPY( &m_liveParams, pSystemParms, PARAMETER_SIZER );
+            taskEXIT_CRITICAL();
+
+            /*restart the stable time*/
+            if ( m_journalChanged != NULL )
+            {
+                xSemaphoreGive( m_journalChanged );
+            }
+        }
+            break;
+
+        case SYS_EVENT_SYSTEM_DOWN:
+        {
+            ret = StorageDeviceManager_journalCommit( );
+        }
+            break;
+#endif
         case SYS_EVENT_SAVE_USER_SETTING:
         {
             ret = pSDM_ObjCtrl->write( STORAGE_DEVICE_CELL_USER_PARAMETERS ,(uint8*)pSystemParms );
@@ -127,12 +202,43 @@ static int8 StorageDeiveManager_initialize( xHMISystemParams *params )
         {
             ret = -2;
         }
+#if ( configSTORAGE_JOURNAL == 1 )
+        StorageDeviceManager_journalReset( );
+#endif
     }
 
     if ( StorageDevice_read( STORAGE_DEVICE_CELL_USER_PARAMETERS, params ) == FALSE )
     {
         ret = -3;
     }
+
+#if ( configSTORAGE_JOURNAL == 1 )
+    if ( StorageDeviceManager_journalReplay( params ) == FALSE )
+    {
+        ret = -3;
+    }
+
+    MEMCPY( &m_liveParams, params, PARAMETER_SIZER );
+    MEMCPY( &m_storedParams, params, PARAMETER_SIZER );
+
+    if ( m_journalMutex == NULL )
+    {
+        m_journalMutex = xSemaphoreCreateMutex( );
+        vSemaphoreCreateBinary( m_journalChanged );
+        xSemaphoreTake( m_journalChanged, 0 );
+
+        if ( xTaskCreate( StorageDeviceManager_journalTask,
+                          ( portCHAR * ) "Storage_journal",
+                          configMINIMAL_STACK_SIZE, NULL,
+                          tskSTORAGE_JOURNAL_PRIORITY, NULL ) != pdPASS )
+        {
+            /*Without the task SendEvent must not wait for the stable time*/
+            vSemaphoreDelete( m_journalChanged );
+            m_journalChanged = NULL;
+            TRACE_ERROR((0, "Storage journal task create failed"));
+        }
+    }
+#endif
 #endif  
 
     return ret;
@@ -143,6 +249,16 @@ static bool StorageDeviceManager_read( STORAGE_DEVICE_CELL cell, void *buff )
     bool retVal = TRUE;
 
 #if( configAPP_STORAGE_MANAGER == 1)
+#if ( configSTORAGE_JOURNAL == 1 )
+    if ( cell == STORAGE_DEVICE_CELL_USER_PARAMETERS )
+    {
+        /*the cell only holds the journal base*/
+        taskENTER_CRITICAL();
+        MEMCPY( buff, &m_liveParams, PARAMETER_SIZER );
+        taskEXIT_CRITICAL();
+        return retVal;
+    }
+#endif
     retVal = StorageDevice_read( cell, buff );
 #endif 
 
@@ -154,9 +270,175 @@ static bool StorageDeviceManager_write( STORAGE_DEVICE_CELL cell, void *buff )
     bool retVal = TRUE;
 
 #if( configAPP_STORAGE_MANAGER == 1)
+#if ( configSTORAGE_JOURNAL == 1 )
+    if ( cell == STORAGE_DEVICE_CELL_USER_PARAMETERS )
+    {
+        taskENTER_CRITICAL();
+        MEMCPY( &m_liveParams, buff, PARAMETER_SIZER );
+        taskEXIT_CRITICAL();
+        return StorageDeviceManager_journalCommit( );
+    }
+#endif
     retVal = StorageDevice_write( cell, buff );
 #endif 
 
     return retVal;    
 }
 
+
+#if ( configSTORAGE_JOURNAL == 1 )
+static void StorageDeviceManager_journalReset( void )
+{
+    uint8 record[JOURNAL_RECORD_SIZE];
+
+    /*Pick a slot 0 seq which can not match the record left in slot 0*/
+    StorageDevice_readPartition( STORAGE_PARTITION_5, 0, record, JOURNAL_RECORD_SIZE );
+    m_journalSeq = record[JOURNAL_RECORD_SEQ] + 0x80;
+    m_journalSlot = 0;
+
+    MEMSET( record, JOURNAL_END, JOURNAL_RECORD_SIZE );
+    StorageDevice_writePartition( STORAGE_PARTITION_5, 0, record, JOURNAL_RECORD_SIZE );
+    StorageDevice_write( STORAGE_DEVICE_CELL_USER_JOURNAL_SEQ, &m_journalSeq );
+}
+
+static bool StorageDeviceManager_journalReplay( xHMISystemParams *params )
+{
+    uint8 record[JOURNAL_RECORD_SIZE];
+    uint8 *pParams = (uint8 *)params;
+    bool ret;
+
+    m_journalSlots = StorageDevice_partitionSize( STORAGE_PARTITION_5 )/JOURNAL_RECORD_SIZE;
+
+    ret = StorageDevice_read( STORAGE_DEVICE_CELL_USER_JOURNAL_SEQ, &m_journalSeq );
+
+    for ( m_journalSlot = 0; ( ret == TRUE ) && ( m_journalSlot < m_journalSlots ); m_journalSlot++ )
+    {
+        ret = StorageDevice_readPartition( STORAGE_PARTITION_5, 
+                                           m_journalSlot*JOURNAL_RECORD_SIZE, 
+                                           record, JOURNAL_RECORD_SIZE );
+
+        if ( ( ret == FALSE )
+            || ( record[JOURNAL_RECORD_SEQ] != m_journalSeq )
+            || ( record[JOURNAL_RECORD_OFFSET] >= PARAMETER_SIZER )
+            || ( record[JOURNAL_RECORD_CHECK] != JOURNAL_CHECK(record) ) )
+        {
+            break;
+        }
+
+        pParams[record[JOURNAL_RECORD_OFFSET]] = record[JOURNAL_RECORD_VALUE];
+        m_journalSeq++;
+    }
+
+    return ret;
+}
+
+static bool StorageDeviceManager_journalCommit( void )
+{
+    xHMISystemParams snapshot;
+    uint8 *pNew = (uint8 *)&snapshot;
+    uint8 *pOld = (uint8 *)&m_storedParams;
+    uint8 *pRecord;
+    uint16 count = 0;
+    uint16 length;
+    uint16 i;
+    bool ret = TRUE;
+
+    if ( m_journalMutex == NULL )
+    {
+        return FALSE;
+    }
+
+    xSemaphoreTake( m_journalMutex, portMAX_DELAY );
+
+    taskENTER_CRITICAL();
+    MEMCPY( &snapshot, &m_liveParams, PARAMETER_SIZER );
+    taskEXIT_CRITICAL();
+
+    /*sys_event is only the reason of the last SendEvent*/
+    snapshot.sys_event = m_storedParams.sys_event;
+
+    for ( i = 0; i < PARAMETER_SIZER; i++ )
+    {
+        if ( pNew[i] != pOld[i] )
+        {
+            pRecord = &m_journalRecords[count*JOURNAL_RECORD_SIZE];
+            pRecord[JOURNAL_RECORD_SEQ] = (uint8)(m_journalSeq + count);
+            pRecord[JOURNAL_RECORD_OFFSET] = (uint8)i;
+            pRecord[JOURNAL_RECORD_VALUE] = pNew[i];
+            pRecord[JOURNAL_RECORD_CHECK] = JOURNAL_CHECK(pRecord);
+            count++;
+        }
+    }
+
+    if ( ( count > 0 ) && ( ( m_journalSlot + count ) > m_journalSlots ) )
+    {
+        /* The log is full. The stored parameters become the new base first,
+         * a power loss before the seq is written replays the old log on a
+         * base which already has it. Slot 0 is ended before the seq of slot 0
+         * moves on, an old record there may carry the new seq. */
+        MEMSET( &m_journalRecords[count*JOURNAL_RECORD_SIZE], JOURNAL_END, JOURNAL_RECORD_SIZE );
+        ret &= StorageDevice_write( STORAGE_DEVICE_CELL_USER_PARAMETERS, &m_storedParams );
+        ret &= StorageDevice_writePartition( STORAGE_PARTITION_5, 0,
+                                             &m_journalRecords[count*JOURNAL_RECORD_SIZE],
+                                             JOURNAL_RECORD_SIZE );
+        ret &= StorageDevice_write( STORAGE_DEVICE_CELL_USER_JOURNAL_SEQ, &m_journalSeq );
+        m_journalSlot = 0;
+    }
+
+    if ( ( count > 0 ) && ( ret == TRUE ) )
+    {
+        /*the end record is left out when the records fill the log*/
+        MEMSET( &m_journalRecords[count*JOURNAL_RECORD_SIZE], JOURNAL_END, JOURNAL_RECORD_SIZE );
+        length = count - 1;
+        if ( ( m_journalSlot + count ) < m_journalSlots )
+        {
+            length++;
+        }
+
+        if ( length > 0 )
+        {
+            ret = StorageDevice_writePartition( STORAGE_PARTITION_5, 
+                                                ( m_journalSlot + 1 )*JOURNAL_RECORD_SIZE, 
+                                                &m_journalRecords[JOURNAL_RECORD_SIZE], 
+                                                length*JOURNAL_RECORD_SIZE );
+        }
+
+        /*the first record replaces the old end record and takes the rest in*/
+        if ( ret == TRUE )
+        {
+            ret = StorageDevice_writePartition( STORAGE_PARTITION_5, 
+                                                m_journalSlot*JOURNAL_RECORD_SIZE, 
+                                                m_journalRecords, JOURNAL_RECORD_SIZE );
+        }
+
+        if ( ret == TRUE )
+        {
+            m_journalSlot += count;
+            m_journalSeq += count;
+            MEMCPY( &m_storedParams, &snapshot, PARAMETER_SIZER );
+        }
+    }
+
+    xSemaphoreGive( m_journalMutex );
+
+    return ret;
+}
+
+static void StorageDeviceManager_journalTask( void *pvParameters )
+{
+    portTickType wait = portMAX_DELAY;
+
+    for( ;; )
+    {
+        if ( xSemaphoreTake( m_journalChanged, wait ) == pdTRUE )
+        {
+            wait = TASK_MSEC2TICKS( configSTORAGE_JOURNAL_DELAY );
+        }
+        else
+        {
+            StorageDeviceManager_journalCommit( );
+            wait = portMAX_DELAY;
+        }
+    }
+}
+#endif
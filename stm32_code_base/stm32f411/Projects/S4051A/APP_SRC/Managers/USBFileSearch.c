@@ -1,6 +1,14 @@
 #include "USBFileSearch.h"
 #include "USBMusicManager.h"
 #include "USBMediaManager.h"
+#if ( configUSB_MEDIA_INDEX == 1 )
+#include "diskio.h"
+#include "ext_flash_driver.h"
+
+#if ( configSPI_FLASH == 0 )
+#error "configUSB_MEDIA_INDEX keeps the index in the external flash"
+#endif
+#endif
 
 extern USB_MUSIC_MANAGE_OBJECT *pUSB_MMP_ObjCtrl;
 extern USB_MEDIA_MANAGE_OBJECT *pUSBMedia_ObjCtrl;
@@ -10,6 +18,23 @@ extern USB_MEDIA_MANAGE_OBJECT *pUSBMedia_ObjCtrl;
 //#define WAVE_MONO
 //#define WAVE_BITS_PER_SAMPLE_8
 
+#if ( configUSB_MEDIA_INDEX == 1 )
+/* The block reserved by sFLASH_USB_INDEX_ADDR (above the IAP payload) holds the index of the
+   last stick: header, folder table, then the file entries in the order they were found.
+   The header is written when the search is done, so a partial index never matches. */
+#define FSE_INDEX_FLASH_ADDR        sFLASH_USB_INDEX_ADDR
+#define FSE_INDEX_FOLDER_ADDR       (FSE_INDEX_FLASH_ADDR + 0x0100)
+#define FSE_INDEX_FILE_ADDR         (FSE_INDEX_FLASH_ADDR + 0x1000)
+#define FSE_INDEX_FLASH_END         (FSE_INDEX_FLASH_ADDR + sFLASH_USB_INDEX_SIZE)
+#define FSE_INDEX_MAGIC             0x49455346      /* "FSEI" */
+
+#define FSE_FLASH_PAGE_SIZE         256
+#define FSE_PAGE_ENTRIES            (FSE_FLASH_PAGE_SIZE/sizeof(FSE_IndexEntry))
+#define FS_MAX_FILE_NUMBER          ((FSE_INDEX_FLASH_END - FSE_INDEX_FILE_ADDR)/sizeof(FSE_IndexEntry))
+
+#define FSE_SEARCH_STEP             5   /* directory entries per call until the first file is found */
+#endif
+
 /*_______________________________________________________________________________________________________*/
 
 typedef enum
@@ -25,6 +50,51 @@ typedef enum
     FSE_STATE_DONE,        
 }FSE_State;
 
+#if ( configUSB_MEDIA_INDEX == 1 )
+typedef struct
+{
+    char name[12];          /* 8.3 name of the directory entry, opens whatever the long name is */
+    uint16_t folder;        /* index in the folder table */
+    uint16_t sampleRate;
+} FSE_IndexEntry;
+
+typedef struct
+{
+    char name[12];
+    uint16_t parent;        /* folder 0 is the root */
+    uint8_t depth;
+    uint8_t reserved;
+} FSE_IndexFolder;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t serial;        /* volume serial of the boot record */
+    uint32_t clusters;      /* volume size and FSInfo free count catch a rewritten stick with the same serial */
+    uint32_t freeClusters;
+    uint32_t fileNumber;
+    uint32_t folderNumber;
+} FSE_IndexHeader;
+
+typedef struct
+{
+    bool bFolderOpen;
+    bool bSearchError;
+    DIR dir;
+    uint16_t folderIdx;
+    FSE_IndexHeader key;            /* of the mounted volume */
+    uint32_t flushedNumber;         /* entries already in the flash */
+    FSE_IndexEntry page[FSE_FLASH_PAGE_SIZE/sizeof(FSE_IndexEntry)];   /* entries waiting for a full flash page */
+    
+} FSE_Control;
+
+
+typedef struct
+{
+    FSE_IndexFolder folder[FS_MAX_FOLDER_NUMBER];
+    uint32_t folderNumber;
+} FSE_FolderList;
+#else
 typedef struct
 {
     bool bFolderOpen;
@@ -39,6 +109,7 @@ typedef struct
     char folderPath[FS_MAX_FOLDER_NUMBER][FS_MAX_PATH_LENGTH];
     uint32_t folderNumber;
 } FSE_FolderList;
+#endif
 
 
 //____________________________________________________________________________________________________________
@@ -49,6 +120,13 @@ static unsigned int FSE_Get_File_Num(void);
 static FSE_FormatCheck FSE_Is_Valid_Wav_File( char* filePath, FSE_WaveFormat* fileFormat,uint8* headerBuf,int IsChannelCheck);
 static bool FSE_File_Search(void);
 static bool FSE_Is_EndOfSearch(void);
+#if ( configUSB_MEDIA_INDEX == 1 )
+static bool FSE_Get_Wave_File(uint32_t idx, char* filePath, uint32_t* sampleRate);
+static void FSE_Drop_Index(void);
+static bool FSE_Index_ReadKey(FATFS* fs, FSE_IndexHeader* key);
+static bool FSE_Index_Load(void);
+static void FSE_Index_Commit(void);
+#endif
 
 /*_______________________________________________________________________________________________________*/
 static FSE_Control gEngineControl;
@@ -66,7 +144,11 @@ const USB_FILE_SEARCH_OBJECT USBFileSearch =
     FSE_StateDispatcher,
     FSE_Get_File_Num,
     FSE_Is_Valid_Wav_File,
-    FSE_Is_EndOfSearch
+    FSE_Is_EndOfSearch,
+#if ( configUSB_MEDIA_INDEX == 1 )
+    FSE_Get_Wave_File,
+    FSE_Drop_Index
+#endif
 };
 
 const USB_FILE_SEARCH_OBJECT *pUSBFSE_Object = &USBFileSearch;
@@ -95,6 +177,36 @@ static void FSE_StateDispatcher(void)
             MEMSET(&gFolderList, 0, sizeof(FSE_FolderList));
             MEMSET(&gFileList, 0, sizeof(FSE_FileList));
 
+#if ( configUSB_MEDIA_INDEX == 1 )
+            gFolderList.folderNumber = 1;   /* folder 0 is the root */
+
+            if (f_opendir(&(gEngineControl.dir), "0:") != FR_OK)
+            {
+                mFSE_state = FSE_STATE_DONE;
+                break;
+            }
+            gEngineControl.bFolderOpen = TRUE;
+
+            if ((FSE_Index_ReadKey(gEngineControl.dir.fs, &(gEngineControl.key)) == TRUE) &&
+                (FSE_Index_Load() == TRUE))
+            {
+                /* Known stick, play from the stored index without walking it */
+                mFSE_state = FSE_STATE_DONE;
+                break;
+            }
+
+#if ( configSPI_FLASH_DMA == 1 )
+            /* The erase runs on while the stick is walked, the first index write waits for it.
+               The file list is kept in the index block, without the flash nothing can be listed */
+            if (sFLASH_EraseSector_Async(FSE_INDEX_FLASH_ADDR) == FALSE)
+            {
+                mFSE_state = FSE_STATE_DONE;
+                break;
+            }
+#else
+            sFLASH_EraseSector(FSE_INDEX_FLASH_ADDR);
+#endif
+#endif
             mFSE_state = FSE_STATE_SEARCH;
         }
         break;
@@ -105,6 +217,12 @@ static void FSE_StateDispatcher(void)
                 
             if (result == FALSE)
             {
+#if ( configUSB_MEDIA_INDEX == 1 )
+                if (gEngineControl.bSearchError == FALSE)
+                {
+                    FSE_Index_Commit();
+                }
+#endif
                 mFSE_state = FSE_STATE_DONE;
             }
         }
@@ -153,6 +271,296 @@ static bool FSE_Is_Wav_File(char* filePath)
         
 }
 
+#if ( configUSB_MEDIA_INDEX == 1 )
+static bool FSE_Is_BootRecord(const BYTE* sect)
+{
+    /* Same test as check_fs() in ff.c */
+    if (LD_WORD(&sect[BS_55AA]) != 0xAA55)
+        return FALSE;
+
+    if (((LD_DWORD(&sect[BS_FilSysType]) & 0xFFFFFF) == 0x544146) ||
+        ((LD_DWORD(&sect[BS_FilSysType32]) & 0xFFFFFF) == 0x544146))
+        return TRUE;
+
+    return FALSE;
+}
+
+static bool FSE_Index_ReadKey(FATFS* fs, FSE_IndexHeader* key)
+{
+    static BYTE sect[_MAX_SS];
+    DWORD bsect = 0;
+
+    MEMSET(key, 0, sizeof(FSE_IndexHeader));
+
+    /* Boot record at sector 0 (SFD) or at the first partition */
+    if (disk_read(fs->drive, sect, bsect, 1) != RES_OK)
+        return FALSE;
+
+    if (FSE_Is_BootRecord(sect) == FALSE)
+    {
+        bsect = LD_DWORD(&sect[MBR_Table + 8]);
+        if ((disk_read(fs->drive, sect, bsect, 1) != RES_OK) || (FSE_Is_BootRecord(sect) == FALSE))
+            return FALSE;
+    }
+
+    key->magic = FSE_INDEX_MAGIC;
+    key->serial = LD_DWORD(&sect[(fs->fs_type == FS_FAT32) ? BS_VolID32 : BS_VolID]);
+    key->clusters = fs->max_clust;
+#if !_FS_READONLY
+    key->freeClusters = fs->free_clust;
+#endif
+    return TRUE;
+}
+
+static bool FSE_Index_Load(void)
+{
+    FSE_IndexHeader header;
+
+    if (sFLASH_ReadBuffer((uint8_t *)&header, FSE_INDEX_FLASH_ADDR, sizeof(header)) == FALSE)
+    {
+        return FALSE;
+    }
+
+    if ((header.magic != FSE_INDEX_MAGIC) ||
+        (header.serial != gEngineControl.key.serial) ||
+        (header.clusters != gEngineControl.key.clusters) ||
+        (header.freeClusters != gEngineControl.key.freeClusters) ||
+        (header.fileNumber > FS_MAX_FILE_NUMBER) ||
+        (header.folderNumber == 0) || (header.folderNumber > FS_MAX_FOLDER_NUMBER))
+    {
+        return FALSE;
+    }
+
+    if (sFLASH_ReadBuffer((uint8_t *)gFolderList.folder, FSE_INDEX_FOLDER_ADDR, (header.folderNumber*sizeof(FSE_IndexFolder))) == FALSE)
+    {
+        return FALSE;
+    }
+    gFolderList.folderNumber = header.folderNumber;
+
+    gEngineControl.flushedNumber = header.fileNumber;
+    gFileList.fileNumber = header.fileNumber;
+    return TRUE;
+}
+
+/* Write the entries found since the last full page; on failure they stay in the page */
+static bool FSE_Index_Flush(void)
+{
+    uint32_t addr = FSE_INDEX_FILE_ADDR + (gEngineControl.flushedNumber*sizeof(FSE_IndexEntry));
+    uint32_t pending = gFileList.fileNumber - gEngineControl.flushedNumber;
+
+    if (pending == 0)
+        return TRUE;
+
+    if (sFLASH_WriteBuffer((uint8_t *)gEngineControl.page, &addr, (pending*sizeof(FSE_IndexEntry))) == FALSE)
+        return FALSE;
+
+    gEngineControl.flushedNumber = gFileList.fileNumber;
+    return TRUE;
+}
+
+/* The header goes last and only after everything else is written, so a failed write leaves no index */
+static void FSE_Index_Commit(void)
+{
+    FSE_IndexHeader header;
+    uint32_t addr;
+
+    if (FSE_Index_Flush() == FALSE)
+        return;
+
+    if (gEngineControl.key.magic != FSE_INDEX_MAGIC)
+        return;
+
+    addr = FSE_INDEX_FOLDER_ADDR;
+    if (sFLASH_WriteBuffer((uint8_t *)gFolderList.folder, &addr, (gFolderList.folderNumber*sizeof(FSE_IndexFolder))) == FALSE)
+        return;
+
+    header = gEngineControl.key;
+    header.fileNumber = gFileList.fileNumber;
+    header.folderNumber = gFolderList.folderNumber;
+
+    addr = FSE_INDEX_FLASH_ADDR;
+    sFLASH_WriteBuffer((uint8_t *)&header, &addr, sizeof(header));
+}
+
+static void FSE_Drop_Index(void)
+{
+    uint32_t magic = 0;
+    uint32_t addr = FSE_INDEX_FLASH_ADDR;
+
+    /* Clearing bits needs no erase; the next mount walks the stick again */
+    sFLASH_WriteBuffer((uint8_t *)&magic, &addr, sizeof(magic));
+}
+
+/* "0:/DIR/SUB/NAME.EXT" from the folder chain, name is NULL for the folder itself */
+static void FSE_Make_Path(uint16_t folder, const char* name, char* path)
+{
+    uint16_t chain[FS_MAX_FOLDER_DEPTH];
+    uint8_t depth = 0;
+    int len;
+
+    while ((folder != 0) && (depth < FS_MAX_FOLDER_DEPTH))
+    {
+        chain[depth++] = folder;
+        folder = gFolderList.folder[folder].parent;
+    }
+
+    len = sprintf(path, "0:");
+    while (depth > 0)
+    {
+        len += sprintf(path + len, "/%.12s", gFolderList.folder[chain[--depth]].name);
+    }
+
+    if (name != NULL)
+    {
+        sprintf(path + len, "/%.12s", name);
+    }
+}
+
+static bool FSE_Get_Wave_File(uint32_t idx, char* filePath, uint32_t* sampleRate)
+{
+    FSE_IndexEntry entry;
+
+    if (idx >= gFileList.fileNumber)
+        return FALSE;
+
+    if (idx >= gEngineControl.flushedNumber)
+    {
+        MEMCPY(&entry, &(gEngineControl.page[idx - gEngineControl.flushedNumber]), sizeof(entry));
+    }
+    else
+    {
+        if (sFLASH_ReadBuffer((uint8_t *)&entry, FSE_INDEX_FILE_ADDR + (idx*sizeof(entry)), sizeof(entry)) == FALSE)
+            return FALSE;
+    }
+
+    FSE_Make_Path(entry.folder, entry.name, filePath);
+    *sampleRate = entry.sampleRate;
+    return TRUE;
+}
+
+//Return value, 1:search done, 0: searching 
+static bool FSE_File_Search(void)
+{
+    uint8_t i = 0;
+    uint8_t step;
+    FRESULT res = FR_OK;
+    FILINFO fno;
+    bool bEndDir = FALSE;
+    static char path[FS_MAX_PATH_LENGTH];
+    static FSE_WaveFormat format;
+    FSE_IndexFolder* pFolder;
+    FSE_IndexEntry* pEntry;
+    char* fn;
+#if _USE_LFN
+    static char lfn[_MAX_LFN + 1];
+
+    fno.lfname = lfn;
+    fno.lfsize = sizeof(lfn);
+#endif
+
+    if (gEngineControl.bFolderOpen == FALSE)
+    {
+        FSE_Make_Path(gEngineControl.folderIdx, NULL, path);
+
+        res = f_opendir(&(gEngineControl.dir), path);
+        if (res == FR_OK)
+        {
+            gEngineControl.bFolderOpen = TRUE;
+        }
+        else
+        {
+            gEngineControl.bSearchError = TRUE;
+            return FALSE;
+        }
+    }
+
+    /* Once a file can play, one entry per call so the media reader is not held up */
+    step = (gFileList.fileNumber == 0) ? FSE_SEARCH_STEP : 1;
+
+    for (i = 0;i < step;i++)
+    {
+        res = f_readdir(&(gEngineControl.dir), &fno);
+        
+        if (res != FR_OK) //read error
+        {
+            gEngineControl.bSearchError = TRUE;
+            return FALSE;
+        }
+
+        if (fno.fname[0] == 0) //end of dir
+        {
+            bEndDir = TRUE;
+            break;
+        }
+        else
+            bEndDir = FALSE;
+
+        if (fno.fname[0] == '.') continue;     // Ignore dot entry
+
+        if (fno.fattrib & AM_DIR)              // It is a directory 
+        {
+            if ((gFolderList.folderNumber >= FS_MAX_FOLDER_NUMBER) ||
+                (gFolderList.folder[gEngineControl.folderIdx].depth >= FS_MAX_FOLDER_DEPTH))
+                continue;
+
+            pFolder = &(gFolderList.folder[gFolderList.folderNumber]);
+            strncpy(pFolder->name, fno.fname, sizeof(pFolder->name));
+            pFolder->parent = gEngineControl.folderIdx;
+            pFolder->depth = gFolderList.folder[gEngineControl.folderIdx].depth + 1;
+            gFolderList.folderNumber++;
+        } 
+        else   // It is a file.                
+        {
+            /* The long name decides the type, the index keeps and opens the 8.3 alias */
+#if _USE_LFN
+            fn = *fno.lfname ? fno.lfname : fno.fname;
+#else
+            fn = fno.fname;
+#endif
+            if (FSE_Is_Wav_File(fn) == FALSE) //Not wav file
+                continue;
+
+            FSE_Make_Path(gEngineControl.folderIdx, fno.fname, path);
+
+            if (FSE_Is_Valid_Wav_File(path, &format, NULL, 0) != FSE_Valid_WAVE_File)
+               continue;
+
+            pEntry = &(gEngineControl.page[gFileList.fileNumber - gEngineControl.flushedNumber]);
+            strncpy(pEntry->name, fno.fname, sizeof(pEntry->name));
+            pEntry->folder = gEngineControl.folderIdx;
+            pEntry->sampleRate = (uint16_t)format.SampleRate;
+            gFileList.fileNumber++;
+
+            if ((gFileList.fileNumber - gEngineControl.flushedNumber) >= FSE_PAGE_ENTRIES)
+            {
+                /* The page is full and cannot be emptied, stop with what is listed */
+                if (FSE_Index_Flush() == FALSE)
+                {
+                    gEngineControl.bSearchError = TRUE;
+                    return FALSE;
+                }
+            }
+
+            if (gFileList.fileNumber >= FS_MAX_FILE_NUMBER)
+                return FALSE;
+        }
+    }
+    
+    if (bEndDir) //End of dir
+    {
+        if (gEngineControl.folderIdx + 1 >= gFolderList.folderNumber) //All folder is searched
+            return FALSE;
+        gEngineControl.folderIdx++;
+        gEngineControl.bFolderOpen = FALSE;
+    }
+    else
+    {
+        gEngineControl.bFolderOpen = TRUE;
+    }
+
+    return TRUE;
+}
+#else
 //Return value, 1:search done, 0: searching 
 static bool FSE_File_Search(void)
 {
@@ -301,6 +709,7 @@ static bool FSE_File_Search(void)
 
     return TRUE;
 }
+#endif /*( configUSB_MEDIA_INDEX == 1 )*/
 
 
 
@@ -7,10 +7,18 @@
 #include "api_typedef.h"
 
 #include "ff.h"       /* FATFS */
+#include "device_config.h"
 
+#if ( configUSB_MEDIA_INDEX == 1 )
+#define FS_MAX_FOLDER_DEPTH 8
+#define FS_MAX_PATH_LENGTH (3 + (FS_MAX_FOLDER_DEPTH + 1)*13)    /* "0:" + "/NAME.EXT" per level */
+#define FS_MAX_FOLDER_NUMBER 128
+/* the file index lives in the external SPI flash, see USBFileSearch.c */
+#else
 #define FS_MAX_PATH_LENGTH 64
 #define FS_MAX_FOLDER_NUMBER 16
 #define FS_MAX_FILE_NUMBER 32//128
+#endif
 
 
 typedef enum
@@ -43,6 +51,13 @@ typedef struct
   uint32_t  Seeker;
 }FSE_WaveFormat;
 
+#if ( configUSB_MEDIA_INDEX == 1 )
+typedef struct
+{
+    uint32_t fileNumber;    /* grows while the index is built, use getWaveFile() for the entries */
+    
+}FSE_FileList;
+#else
 typedef struct
 {
     //uint8_t filePath[FS_MAX_FILE_NUMBER][FS_MAX_PATH_LENGTH];
@@ -50,6 +65,7 @@ typedef struct
     uint32_t fileNumber;
     
 }FSE_FileList;
+#endif
 
 typedef struct _USB_FILE_SEARCH
 {
@@ -58,6 +74,10 @@ typedef struct _USB_FILE_SEARCH
     unsigned int (*getWaveFileNum)(void);
     FSE_FormatCheck (*formatCheck)(char* filePath, FSE_WaveFormat* fileFormat,uint8* headerBuf,int IsChannelCheck);
     bool (*isSearchDone)(void);
+#if ( configUSB_MEDIA_INDEX == 1 )
+    bool (*getWaveFile)(uint32_t idx, char* filePath, uint32_t* sampleRate);
+    void (*dropIndex)(void);
+#endif
 }USB_FILE_SEARCH_OBJECT;
 
 
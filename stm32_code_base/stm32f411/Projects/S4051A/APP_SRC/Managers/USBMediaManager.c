@@ -2,8 +2,8 @@
 #include "USBMediaManager.h"
 #include "stm3210c_usb_audio_codec.h"
 
-#include "ext_flash_driver.h"
 #include "ChannelCheckManager.h"
+#include "Debug.h"
 
 #define CHK_POP_SOLUTION 1
 #if CHK_POP_SOLUTION//For fix issue for channel check pop sound. Angus 2014/10/28
@@ -12,6 +12,9 @@
 #include "AudioDeviceManager.h"
 #endif
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+#define WAVE_DMA_HALF_SIZE          (4096)   /* ~21ms of 48KHz stereo per half */
+#else
 #define WAVE_READ_BUFFER_SIZE     (1024)
 
 #define MAX_BUFFER_NUM                   (6)//(16)
@@ -19,6 +22,7 @@
 #define MAX_SUPPLE_BUFFER_NUM     ((MAX_BUFFER_NUM*2)/3)    /* If catching too much it will lose sound */
 
 #define MAX_EMPTY_FRAME (6)
+#endif
 
 static int counter_empty = 0 ;
 
@@ -54,6 +58,15 @@ typedef struct{
 	uint32_t Seeker;
 }xWaveFileIndicator;
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+typedef struct{
+    uint8_t Buffer[2][WAVE_DMA_HALF_SIZE];  /* the I2S DMA wraps over both halves */
+    __IO bool HalfFree[2];     /* set by the DMA ISR once the half has been played */
+    __IO bool End;             /* no more data, freed halves are filled with silence */
+    uint8_t LastHalf;          /* half holding the end of the data */
+    __IO uint16_t Underrun;    /* halves the DMA reached before they were refilled */
+}xUSBMediaManagerDmaBuffer;
+#else
 typedef struct{
     __IO uint16_t count;
     uint8_t QueueBuffer[MAX_BUFFER_NUM][WAVE_FILE_BUFFER_SIZE];
@@ -61,6 +74,7 @@ typedef struct{
     uint16_t setIndex;
     uint16_t getIndex;
 }xUSBMediaManagerQueue;
+#endif
 
 #if CHK_POP_SOLUTION//For fix issue for channel check pop sound. Angus 2014/10/28
 extern AUDIO_LOWLEVEL_DRIVER_OBJECT *pAudLowLevel_ObjCtrl;
@@ -77,8 +91,14 @@ static void USBMediaManage_RePlay(void);
 static void USBMusicManager_AssignUSBFileList(void * FileList);
 static void USBMediaManager_ServiceManager(void);
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+static void USBMediaManage_HalfFreed(uint8_t half);
+static uint16_t USBMediaManage_UnderrunCount(void);
+static uint16_t USBMediaManage_FillWaveHalf(uint8_t half);
+#else
 static QueueState USBMediaManage_FetchQueue(void);
 static QueueState USBMediaManage_FetchEmptyQueue(void);
+#endif
 
 static void USBMediaManage_ReqWaveSong(uint8_t num);
 static bool USBMediaManage_IsEndOfSong(void);
@@ -88,10 +108,15 @@ static FRESULT USBMediaManage_CloseWaveFile( void );
 static void USBMusicManager_AssignCCKWaveFormat(void * WaveFormat) ;
 static void USBMediaManage_CCKPlay(void);
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 0 )
 static void USBMediaManager_PlayBack_Reset( void ) ;
+#endif
 
 //____________________________________________________________________________________________________________
 extern CCK_MANAGE_OBJECT *pCCKManage_ObjCtrl;
+#if ( configUSB_MEDIA_INDEX == 1 )
+extern USB_FILE_SEARCH_OBJECT *pUSBFSE_Object;
+#endif
 
 const USB_MEDIA_MANAGE_OBJECT   USBMediaManage =
 {
@@ -102,7 +127,12 @@ const USB_MEDIA_MANAGE_OBJECT   USBMediaManage =
     USBMediaManage_RePlay,
     USBMusicManager_AssignUSBFileList,
     USBMediaManager_ServiceManager,
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+    USBMediaManage_HalfFreed,
+    USBMediaManage_UnderrunCount,
+#else
     USBMediaManage_FetchQueue,
+#endif
     USBMediaManage_ReqWaveSong,
     USBMediaManage_IsEndOfSong,
     USBMusicManager_AssignCCKWaveFormat,
@@ -117,29 +147,41 @@ static xUSBMediaManagerState USBMediaManagerLastState = USB_MEDIA_IDLE;
 
 static FSE_FileList* mMediaManagerUSBFileList;
 static FIL waveFilefatfs;
+#if ( configUSB_MEDIA_INDEX == 1 )
+static char mWaveFilePath[FS_MAX_PATH_LENGTH];
+#endif
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+static xUSBMediaManagerDmaBuffer mWaveDma;
+#else
 static uint8_t waveReadBuffer[WAVE_READ_BUFFER_SIZE] ={0};
 static uint16_t   wave_read_size = 0;
 
 xUSBMediaManagerQueue USBMediaQueue;
+#endif
 
 static uint8_t mPlayWaveNum = 0;
 static bool USBMediaPlaySuspend = FALSE;
 
 static FSE_WaveFormat* mCCKWaveFormat;
 static xWaveFileIndicator mWaveFileIndicator;
-static uint8_t Tmp_RAM_Buf[WAVE_READ_BUFFER_SIZE];
 static bool mCCKPlay = FALSE;
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 0 )
 uint8_t EmptyBuffer[WAVE_FILE_BUFFER_SIZE];
 uint16_t EmptyBufferSize = WAVE_FILE_BUFFER_SIZE;
+#endif
 
 //____________________________________________________________________________________________________________
 
 static void USBMediaManage_Init(void)
 {
     USBMediaManagerState = USB_MEDIA_IDLE;
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+    MEMSET(&mWaveDma, 0, sizeof(mWaveDma));
+#else
     MEMSET(&USBMediaQueue, 0, sizeof(USBMediaQueue));
+#endif
     MEMSET(&mWaveFileIndicator, 0, sizeof(mWaveFileIndicator));
 }
 
@@ -157,6 +199,13 @@ static void USBMediaManage_CCKPlay(void)
 
 static void USBMediaManage_Pause(void)
 {
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+    /* The circular DMA never runs dry by itself, hold it here; replay refills both halves */
+    if( USBMediaManagerState == USB_MEDIA_PLAY_FILE)
+    {
+        Audio_MAL_Stop();
+    }
+#endif
     USBMediaManagerLastState = USBMediaManagerState;
     USBMediaManagerState = USB_MEDIA_PAUSE;
 }
@@ -229,18 +278,94 @@ static FRESULT USBMediaManage_CloseWaveFile( void )
     return res ;
 }
 
-void  USBMediaManage_MonoToStero(uint8_t src[],uint8_t dest[],int size)
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+/* Read the next wave data straight into pDest (a DMA half), no intermediate copy.
+   *pReadSize is less than size once the data has run out. */
+static FRESULT USBMediaManage_ReadWaveData(uint8_t *pDest, uint16_t size, uint16_t *pReadSize)
 {
-    int i;
-    for(i=0;i<size;i+=2)
+    FRESULT res = FR_OK; 
+    UINT read_size = 0;
+    uint32_t remain;
+
+    *pReadSize = 0;
+
+    if(mCCKPlay == FALSE)
     {
-        dest[i*2] = src[i];
-        dest[i*2+2] = src[i];
-        dest[(i+1)*2 -1] = src[i+1];
-        dest[(i+1)*2 +1] = src[i+1];
+        res = f_read(&waveFilefatfs, pDest, size, &read_size);
+        *pReadSize = (uint16_t)read_size;
+        return res;
     }
+
+    if(mWaveFileIndicator.Seeker >= mCCKWaveFormat->DataSize)    /* Angus debug 2013/12/25 */	
+    {
+#if CHK_POP_SOLUTION //Fix issue for play channel check will cause pop sound (Angus 2013/10/29)
+        pAudLowLevel_ObjCtrl->SetVolRampEvent(AUD_VOL_EVENT_CHK_VOLUME_DELAY_RELEASE);
+#endif
+        return FR_NO_FILE;
+    }
+
+    remain = mCCKWaveFormat->DataSize - mWaveFileIndicator.Seeker;
+
+    /* The noise is rendered as stereo frames; DataSize counts it as a mono wave */
+    read_size = (remain < (size/2)) ? remain : (size/2);
+    pCCKManage_ObjCtrl->RenderNoise((int16 *)pDest, (uint16)(read_size/2));
+
+    mWaveFileIndicator.Seeker += read_size;
+    *pReadSize = (uint16_t)(read_size*2);
+
+    return res;
 }
 
+/* Refill one DMA half, the part past the end of the data is silence. Returns the data bytes read. */
+static uint16_t USBMediaManage_FillWaveHalf(uint8_t half)
+{
+    uint8_t *pHalf = mWaveDma.Buffer[half];
+    uint16_t read_size = 0;
+
+    if(mWaveDma.End == FALSE)
+    {
+        if(USBMediaManage_ReadWaveData(pHalf, WAVE_DMA_HALF_SIZE, &read_size) != FR_OK)
+        {
+            read_size = 0;
+        }
+
+        if(read_size < WAVE_DMA_HALF_SIZE)
+        {
+            mWaveDma.LastHalf = half;
+            mWaveDma.End = TRUE;
+        }
+    }
+
+    if(read_size < WAVE_DMA_HALF_SIZE)
+    {
+        MEMSET(pHalf + read_size, 0, (WAVE_DMA_HALF_SIZE - read_size));
+    }
+
+    mWaveDma.HalfFree[half] = FALSE;
+    return read_size;
+}
+
+/* DMA ISR: HT frees half 0, TC frees half 1 */
+static void USBMediaManage_HalfFreed(uint8_t half)
+{
+    uint8_t next = (half ^ 1);
+
+    mWaveDma.HalfFree[half] = TRUE;
+
+    /* The DMA is entering a half that was not refilled, play silence instead of looping old audio */
+    if((mWaveDma.HalfFree[next] == TRUE) && (mWaveDma.End == FALSE))
+    {
+        MEMSET(mWaveDma.Buffer[next], 0, WAVE_DMA_HALF_SIZE);
+        mWaveDma.Underrun++;
+    }
+}
+
+static uint16_t USBMediaManage_UnderrunCount(void)
+{
+    return mWaveDma.Underrun;
+}
+
+#else
 FRESULT USBMediaManage_ReadWaveFile(void)
 {
     FRESULT res = FR_OK; 
@@ -255,56 +380,8 @@ FRESULT USBMediaManage_ReadWaveFile(void)
     }
     else
     {
-        if(mWaveFileIndicator.Seeker >= mCCKWaveFormat->DataSize)    /* Angus debug 2013/12/25 */	
-        {
-#if CHK_POP_SOLUTION //Fix issue for play channel check will cause pop sound (Angus 2013/10/29)
-            pAudLowLevel_ObjCtrl->SetVolRampEvent(AUD_VOL_EVENT_CHK_VOLUME_DELAY_RELEASE);
-#endif
-            return FR_NO_FILE;
-        }
-
-        if(mCCKWaveFormat->NumChannels == CHANNEL_MONO)
-        {
-            if(mWaveFileIndicator.ChunkIndex < mWaveFileIndicator.ChunkSize )
-            {                                                                                                               
-                sFLASH_ReadBuffer(Tmp_RAM_Buf, mWaveFileIndicator.Seeker+pCCKManage_ObjCtrl->Get_NoiseFile_Start_Addr(), (WAVE_READ_BUFFER_SIZE/2));
-                USBMediaManage_MonoToStero(Tmp_RAM_Buf,waveReadBuffer,(WAVE_READ_BUFFER_SIZE/2));
-                wave_read_size = WAVE_READ_BUFFER_SIZE;
-                res = FR_OK;
-        
-                mWaveFileIndicator.Seeker = (mWaveFileIndicator.Seeker + (WAVE_READ_BUFFER_SIZE/2)); //next chunk entry pointer//
-                mWaveFileIndicator.ChunkIndex +=1;
-            }
-            else
-            {                                                                                                               
-                sFLASH_ReadBuffer(Tmp_RAM_Buf, mWaveFileIndicator.Seeker+pCCKManage_ObjCtrl->Get_NoiseFile_Start_Addr(), ((mCCKWaveFormat->DataSize)%(WAVE_READ_BUFFER_SIZE/2)));
-                USBMediaManage_MonoToStero(Tmp_RAM_Buf,waveReadBuffer,(WAVE_READ_BUFFER_SIZE/2));
-                wave_read_size = ((mCCKWaveFormat->DataSize)%(WAVE_READ_BUFFER_SIZE));
-                res = FR_OK;
-        
-                mWaveFileIndicator.Seeker = (mWaveFileIndicator.Seeker + (mCCKWaveFormat->DataSize)%(WAVE_READ_BUFFER_SIZE/2));
-            }
-        }
-        else
-        {
-            if(mWaveFileIndicator.ChunkIndex < mWaveFileIndicator.ChunkSize )
-            {
-                sFLASH_ReadBuffer(waveReadBuffer, mWaveFileIndicator.Seeker, (WAVE_READ_BUFFER_SIZE));
-                wave_read_size = WAVE_READ_BUFFER_SIZE;
-                res = FR_OK;
-        
-                mWaveFileIndicator.Seeker = (mWaveFileIndicator.Seeker + (WAVE_READ_BUFFER_SIZE)); //next chunk entry pointer//
-                mWaveFileIndicator.ChunkIndex +=1;
-            }
-            else
-            {
-                sFLASH_ReadBuffer(waveReadBuffer, mWaveFileIndicator.Seeker, ((mCCKWaveFormat->DataSize)%(WAVE_READ_BUFFER_SIZE)));
-                wave_read_size = ((mCCKWaveFormat->DataSize)%(WAVE_READ_BUFFER_SIZE));
-                res = FR_OK;
-                
-                mWaveFileIndicator.Seeker = (mWaveFileIndicator.Seeker + (mCCKWaveFormat->DataSize)%(WAVE_READ_BUFFER_SIZE));
-            }
-        }
+        /* Channel check needs configUSB_WAV_CIRCULAR_DMA, its noise is rendered into the DMA halves */
+        res = FR_NO_FILE;
     }
     
     return res;
@@ -434,13 +511,18 @@ static QueueState USBMediaManage_FetchEmptyQueue(void)
     
     return QueueFetchOK;
 }
+#endif /*( configUSB_WAV_CIRCULAR_DMA == 1 )*/
 
 static void USBMediaManager_ServiceManager(void)
 {
     ErrorCode err;
     static uint32 sampleRate;
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+    uint8_t half;
+#else
     QueueState resQueue;
     int i;
+#endif
        
     switch(USBMediaManagerState)
     {
@@ -453,6 +535,26 @@ static void USBMediaManager_ServiceManager(void)
         {
             if(mCCKPlay == FALSE)
             {
+#if ( configUSB_MEDIA_INDEX == 1 )
+                if(pUSBFSE_Object->getWaveFile(mPlayWaveNum, mWaveFilePath, &sampleRate) == FALSE)
+                {
+                    USBMediaManagerState = USB_MEDIA_FINISH;
+                    break;
+                }
+
+                err = USBMediaManage_OpenWaveFile(mWaveFilePath);  
+
+                if(err == Valid_WAVE_File)
+                {
+                    USBMediaManagerState = USB_MEDIA_INIT_I2S;
+                }
+                else
+                {
+                    /* The stick changed behind a matching index: skip the song, walk the stick on the next mount */
+                    pUSBFSE_Object->dropIndex();
+                    USBMediaManagerState = USB_MEDIA_FINISH;
+                }
+#else
                 err = USBMediaManage_OpenWaveFile(mMediaManagerUSBFileList->fileData[mPlayWaveNum].filePath);  
 
                 if(err == Valid_WAVE_File)
@@ -460,11 +562,13 @@ static void USBMediaManager_ServiceManager(void)
                     USBMediaManagerState = USB_MEDIA_INIT_I2S;
                     sampleRate = mMediaManagerUSBFileList->fileData[mPlayWaveNum].SampleRate;
                 }
+#endif
             }
             else
             {
                 MEMSET(&mWaveFileIndicator, 0, sizeof(mWaveFileIndicator)); 
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 0 )
                 if(mCCKWaveFormat->NumChannels == CHANNEL_MONO)
                 {
                     mWaveFileIndicator.ChunkSize = (mCCKWaveFormat->DataSize /(WAVE_READ_BUFFER_SIZE/2));
@@ -473,6 +577,7 @@ static void USBMediaManager_ServiceManager(void)
                 {
                     mWaveFileIndicator.ChunkSize = (mCCKWaveFormat->DataSize /(WAVE_READ_BUFFER_SIZE));
                 }
+#endif
 
                 USBMediaManagerState = USB_MEDIA_INIT_I2S;
                 sampleRate = mCCKWaveFormat->SampleRate;
@@ -508,12 +613,59 @@ static void USBMediaManager_ServiceManager(void)
                     break;
             }
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 0 )
             MEMSET(&USBMediaQueue, 0, sizeof(USBMediaQueue));
+#endif
             USBMediaManagerState = USB_MEDIA_INIT_PLAY_FILE;
 
         }
         break;
         
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+        case USB_MEDIA_INIT_PLAY_FILE:
+        {
+            mWaveDma.End = FALSE;
+            mWaveDma.Underrun = 0;
+
+            if(USBMediaManage_FillWaveHalf(0) == 0)
+            {
+                USBMediaManagerState = USB_MEDIA_IDLE;
+                USBMediaManage_CloseWaveFile();
+                break;
+            }
+            USBMediaManage_FillWaveHalf(1);
+
+#if CHK_POP_SOLUTION //Fix issue for play channel check will cause pop sound (Angus 2013/10/29)
+            if(mCCKPlay)
+            {  
+                pAudLowLevel_ObjCtrl->SetVolRampEvent(AUD_VOL_EVENT_CHK_VOLUME_DELAY_RELEASE);
+            }
+#endif           
+            /* From here on the DMA wraps by itself, PLAY_FILE only refills the freed halves */
+            Audio_MAL_PlayCircular((uint32_t)&mWaveDma.Buffer[0][0], (sizeof(mWaveDma.Buffer)/2));
+            USBMediaManagerState = USB_MEDIA_PLAY_FILE;
+        }
+        break;
+        case USB_MEDIA_PLAY_FILE:
+        {
+            for(half = 0; half < 2; half++)
+            {
+                if(mWaveDma.HalfFree[half] == FALSE)
+                    continue;
+
+                if((mWaveDma.End == TRUE) && (half == mWaveDma.LastHalf))
+                {
+                    /* The last data has been played out */
+                    USBMediaManagerState = USB_MEDIA_STOP;
+                    USBMediaManage_CloseWaveFile();
+                    break;
+                }
+
+                USBMediaManage_FillWaveHalf(half);
+            }
+        }
+        break;
+#else
         case USB_MEDIA_INIT_PLAY_FILE:
         {   
  
@@ -578,6 +730,7 @@ static void USBMediaManager_ServiceManager(void)
             }
         }
         break;
+#endif
         case USB_MEDIA_PAUSE:
         {
             /* Don't do anything for PAUSE play wave music. */
@@ -587,6 +740,12 @@ static void USBMediaManager_ServiceManager(void)
         case USB_MEDIA_STOP:
         {
             Audio_MAL_Stop();
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+            if(mWaveDma.Underrun > 0)
+            {
+                TRACE_DEBUG((0, "USB media: %d DMA half underruns", mWaveDma.Underrun));
+            }
+#endif
             USBMediaManagerState = USB_MEDIA_FINISH;
             mCCKPlay = FALSE;
         }
@@ -599,6 +758,7 @@ static void USBMediaManager_ServiceManager(void)
     }
 }
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 0 )
 static void USBMediaManager_PlayBack_Reset( void ) 
 {
     int idx = 0;
@@ -614,3 +774,4 @@ static void USBMediaManager_PlayBack_Reset( void )
     }
 #endif    
 }
+#endif /*( configUSB_WAV_CIRCULAR_DMA == 0 )*/
@@ -2,6 +2,7 @@
 #define __USB_MEDIA_MANAGER_H__
 
 #include "ff.h"       /* FATFS */
+#include "device_config.h"
 
 #if 0
 typedef enum{
@@ -44,7 +45,12 @@ typedef struct _USB_MEDIA_MANAGE
     void (*media_rePlay)(void);
     void (*assign_usb_filelist)(void* filelist);
     void (*mediaManagerTask)(void);
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+    void (*HalfFreed)(uint8_t half);    /*called from the I2S DMA ISR*/
+    uint16_t (*underrun_count)(void);   /*silent halves inserted in the current/last file*/
+#else
     QueueState (* FetchQueue)(void);
+#endif
     void (*media_reqWaveNum)(uint8_t num);
     bool (*media_isPlayFinished)(void);
     void (*assign_cck_waveFormat)(void* WaveFormat);
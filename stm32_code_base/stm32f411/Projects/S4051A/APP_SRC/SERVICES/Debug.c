@@ -1,5 +1,12 @@
 #ifdef DEBUG
 #include "Debug.h"
+#include "device_config.h"
+
+#if ( configDEBUG_DEFERRED == 1 )
+#include "freertos_conf.h"
+#include "freertos_task.h"
+#include "VirtualTimer.h"
+#endif
 
 
 /** Table used for hexadecimal and decimal to char conversion */
@@ -16,11 +23,115 @@ static const char CHAR_MAP[] = {'0', '1', '2', '3', '4', '5', '6', '7',
 /** Maximal buffer to use for conversion of a number */
 #define MAX_NUMBER_BUFFER 10
 
+/** Maximal number of arguments of one printout */
+#define MAX_ARGS 6
+
 static uint32 m_traceEnableMask;
 
+#if ( configDEBUG_DEFERRED == 1 )
+/** Number of printouts the ring holds until the drain task sends them, must
+    be a power of two */
+#define DEBUG_RING_SIZE 32
+#define DEBUG_RING_MASK (DEBUG_RING_SIZE - 1)
+
+/** Number of characters sent to the VCP in one transfer */
+#define DEBUG_PACKET_SIZE 64
+
+/** Characters a record keeps of its %s arguments, terminators included */
+#define DEBUG_STRING_SIZE 32
+
+#if ( configDEBUG_TASK_SWITCH == 1 )
+/** Interval of the context switch report, in seconds */
+#define DEBUG_TASK_SWITCH_PERIOD_SEC 10
+
+#define DEBUG_DRAIN_TIME_TICK TASK_MSEC2TICKS(DEBUG_TASK_SWITCH_PERIOD_SEC * 1000)
+#else
+#define DEBUG_DRAIN_TIME_TICK portMAX_DELAY
+#endif
+
+/** A printout as taken by TRACE_*, formatted later by the drain task */
+typedef struct
+{
+    /** Slot number + 1 once the record is complete */
+    volatile uint32 sequence;
+
+    /** Format string; the TRACE strings are literals kept in flash */
+    const char *format;
+
+    const char *moduleStr;
+
+    /** VirtualTimer_now() at the TRACE call */
+    uint32 timestamp;
+
+    uint16 strId;
+
+    /** Number of arguments taken for the format string */
+    uint16 argc;
+
+    /** A %s argument points into strings, not to the caller's buffer */
+    uint32 args[MAX_ARGS];
+
+    /** Copies of the %s arguments, truncated to fit */
+    char strings[DEBUG_STRING_SIZE];
+
+} Debug_record;
+
+static Debug_record m_ring[DEBUG_RING_SIZE];
+
+/** Next slot to claim; claimed by any task or ISR with LDREX/STREX */
+static volatile uint32 m_ringHead = 0;
+
+/** Next slot to send, only moved by the drain task */
+static volatile uint32 m_ringTail = 0;
+
+/** Printouts lost because the ring was full */
+static volatile uint32 m_ringDropped = 0;
+
+/** Given for each queued or dropped printout, the drain task waits on it */
+static xSemaphoreHandle m_drainSema = NULL;
+
+/** Characters collected by the drain task for the next transfer */
+static char m_packet[DEBUG_PACKET_SIZE];
+static uint16 m_packetLength = 0;
+#endif
+
+/** Counted by traceTASK_SWITCHED_IN, see FreeRTOSConfig.h */
+volatile uint32_t ulDebugTaskSwitchCount = 0;
+
+#if ( configDEBUG_LATENCY == 1 )
+/** Statistics of one measured path, times in usec */
+typedef struct
+{
+    /** DWT cycle count at the begin mark, 0 while no measure is open */
+    uint32 start;
+
+    uint32 count;
+
+    uint32 min;
+
+    uint32 max;
+
+    uint32 total;
+
+} Debug_latency;
+
+static Debug_latency m_latency[DEBUG_LATENCY_NUMBER];
+
+static const char * const m_latencyName[DEBUG_LATENCY_NUMBER] =
+{
+    "input switch",
+    "volume step",
+    "ULD load",
+    "power up"
+};
+#endif
+
 //! < External Application ___________________________________________________________________________________@{
 //These applicatons is only used on here.
 extern void usart_putchar(const char c);
+#if ( configDEBUG_DEFERRED == 1 )
+extern void usart_putbuffer(const uint8_t *buf, uint32_t length);
+#endif
 //! @}
 
 /**
@@ -39,6 +150,40 @@ static void Debug_printf(DEBUG_FIELDS moduleId,
                          uint16 strId,
                          va_list args);
 
+/**
+ * Writes a printout whose arguments have already been taken from the
+ * variable argument list.
+ *
+ * @param   moduleStr is the module string to be printout as a prefix.
+ * @param   strId is the Static String ID that is sent to the AppCom.
+ * @param   str is the format string.
+ * @param   args are the arguments, one 32 bit word each.
+ * @param   argc is the number of arguments; conversions past it print '?'.
+ */
+static void Debug_format(const char *moduleStr,
+                         uint16 strId,
+                         const char *str,
+                         const uint32 *args,
+                         uint16 argc);
+
+#if ( configDEBUG_DEFERRED == 1 )
+/**
+ * Sends the characters collected by the drain task.
+ */
+static void Debug_flush(void);
+
+/**
+ * Wakes the drain task, from a task or from an ISR.
+ */
+static void Debug_wakeDrain(void);
+
+/**
+ * Low priority task formatting the deferred printouts and sending them to
+ * the VCP a packet at a time.
+ */
+static void Debug_drainTask(void *pvParameters);
+#endif
+
 /**
  * Writes a single character to the output.
  *
@@ -89,6 +234,25 @@ void Debug_initialize(void)
 
     /*All printouts are disabled.*/
     m_traceEnableMask = mask;
+
+#if ( configDEBUG_DEFERRED == 1 )
+    vSemaphoreCreateBinary( m_drainSema );
+    if ( m_drainSema == NULL )
+    {
+        m_traceEnableMask = 0;
+        return;
+    }
+    xSemaphoreTake( m_drainSema, 0 );
+
+    if ( xTaskCreate( Debug_drainTask,
+                      ( portCHAR * ) "Debug_drain",
+                      configMINIMAL_STACK_SIZE, NULL,
+                      tskDEBUG_DRAIN_PRIORITY, NULL ) != pdPASS )
+    {
+        /*Printouts would only fill the ring without the drain task*/
+        m_traceEnableMask = 0;
+    }
+#endif
 }
 
 /*----------------------------------------------------------------------------*/
@@ -127,7 +291,13 @@ static void Debug_printf(
     va_list args
 )
 {
-    char *str;
+    const char *format;
+    const char *str;
+    uint32 argv[MAX_ARGS];
+    uint16 argc = 0;
+#if ( configDEBUG_DEFERRED == 1 )
+    uint16 strMask = 0;
+#endif
 
     /*Check whether the moduleId printouts are enabled*/
     if (!(m_traceEnableMask & moduleId))
@@ -136,6 +306,112 @@ static void Debug_printf(
         return;
     }
 
+    format = va_arg(args, const char *);
+    if (format == NULL)
+    {
+        return;
+    }
+
+    /*Take the arguments the format string asks for*/
+    for (str = format; (*str != '\0') && (argc < MAX_ARGS); str++)
+    {
+        if (*str == '%')
+        {
+            str++;
+
+            if ((*str == 'd') || (*str == 'u') || (*str == 'X') || (*str == 's'))
+            {
+#if ( configDEBUG_DEFERRED == 1 )
+                if (*str == 's')
+                {
+                    strMask |= (1 << argc);
+                }
+#endif
+                argv[argc++] = va_arg(args, uint32);
+            }
+            else if (*str == '\0')
+            {
+                break;
+            }
+        }
+    }
+
+    va_end(args);
+
+#if ( configDEBUG_DEFERRED == 1 )
+    {
+        Debug_record *pRecord;
+        uint32 slot;
+        const char *pSrc;
+        uint16 i;
+        uint16 pos = 0;
+
+        /*Claim a slot; the drain task formats and sends it later*/
+        do
+        {
+            slot = __LDREXW((uint32 *)&m_ringHead);
+            if ((slot - m_ringTail) >= DEBUG_RING_SIZE)
+            {
+                __CLREX();
+                m_ringDropped++;
+                Debug_wakeDrain();
+                return;
+            }
+        } while (__STREXW(slot + 1, (uint32 *)&m_ringHead));
+
+        pRecord = &m_ring[slot & DEBUG_RING_MASK];
+        pRecord->format = format;
+        pRecord->moduleStr = moduleStr;
+        pRecord->timestamp = VirtualTimer_now();
+        pRecord->strId = strId;
+        pRecord->argc = argc;
+        MEMCPY(pRecord->args, argv, (argc * sizeof(uint32)));
+
+        /*The caller's string may be gone by the time the drain task runs*/
+        for (i = 0; i < argc; i++)
+        {
+            if (!(strMask & (1 << i)))
+            {
+                continue;
+            }
+
+            pRecord->args[i] = (uint32)&pRecord->strings[pos];
+            pSrc = (const char *)argv[i];
+            if (pSrc != NULL)
+            {
+                while ((*pSrc != '\0') && (pos < (DEBUG_STRING_SIZE - 1)))
+                {
+                    pRecord->strings[pos++] = *pSrc++;
+                }
+            }
+            pRecord->strings[pos] = '\0';
+            if (pos < (DEBUG_STRING_SIZE - 1))
+            {
+                pos++;
+            }
+        }
+
+        __DMB();
+        pRecord->sequence = slot + 1;
+
+        Debug_wakeDrain();
+    }
+#else
+    Debug_format(moduleStr, strId, format, argv, argc);
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+static void Debug_format(
+    const char *moduleStr,
+    uint16 strId,
+    const char *str,
+    const uint32 *args,
+    uint16 argc
+)
+{
+    uint16 argi = 0;
+
     /*In case the String ID is NULL, the printout will be in legacy mode,
       without sending the String ID to the PC*/
     if (STR_ID_NULL != strId)
@@ -153,13 +429,11 @@ static void Debug_printf(
         Debug_writeChar(strId & 0xff);
     }
 
-    str = va_arg(args, char *);
-
     /*Printout the printed module string*/
     Debug_writeString(moduleStr);
     Debug_writeString("\t>>  ");
 
-    while ((*str != '\0') && (str != NULL))
+    while (*str != '\0')
     {
         if (*str == '%')
         {
@@ -168,18 +442,38 @@ static void Debug_printf(
             switch (*str)
             {
                 case 'd':
-                    Debug_writeNumber(va_arg(args, int), DECIMAL_BASE);
-                    break;
                 case 'u':
-                    Debug_writeUnsignedNumber(
-                        va_arg(args, int), DECIMAL_BASE);
-                    break;
                 case 'X':
-                    Debug_writeUnsignedNumber(
-                        va_arg(args, int), HEXADECIMAL_BASE);
-                    break;
                 case 's':
-                    Debug_writeString(va_arg(args, const char *));
+                    /*Only the arguments taken by Debug_printf are valid*/
+                    if (argi >= argc)
+                    {
+                        Debug_writeChar('?');
+                    }
+                    else if (*str == 'd')
+                    {
+                        Debug_writeNumber((int32)args[argi++], DECIMAL_BASE);
+                    }
+                    else if (*str == 'u')
+                    {
+                        Debug_writeUnsignedNumber(args[argi++], DECIMAL_BASE);
+                    }
+                    else if (*str == 'X')
+                    {
+                        Debug_writeUnsignedNumber(args[argi++], HEXADECIMAL_BASE);
+                    }
+                    else if (args[argi] == 0)
+                    {
+                        argi++;
+                        Debug_writeString("(null)");
+                    }
+                    else
+                    {
+                        Debug_writeString((const char *)args[argi++]);
+                    }
+                    break;
+                case '\0':
+                    str--;
                     break;
                 default:
                     Debug_writeChar(*str);
@@ -196,10 +490,102 @@ static void Debug_printf(
     Debug_writeChar(' ');
     Debug_writeChar('\r');
     Debug_writeChar('\n');
+}
 
-    va_end(args);
+#if ( configDEBUG_DEFERRED == 1 )
+/*----------------------------------------------------------------------------*/
+static void Debug_flush(void)
+{
+    if (m_packetLength > 0)
+    {
+        usart_putbuffer((const uint8_t *)m_packet, m_packetLength);
+        m_packetLength = 0;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+static void Debug_wakeDrain(void)
+{
+    if (m_drainSema == NULL)
+    {
+        return;
+    }
+
+    /*The drain task runs at idle priority, so there is no switch to request*/
+    if (__get_IPSR() != 0)
+    {
+        xSemaphoreGiveFromISR(m_drainSema, NULL);
+    }
+    else
+    {
+        xSemaphoreGive(m_drainSema);
+    }
 }
 
+/*----------------------------------------------------------------------------*/
+static void Debug_drainTask(void *pvParameters)
+{
+    Debug_record *pRecord;
+    uint32 dropped = 0;
+    uint32 args[MAX_ARGS];
+#if ( configDEBUG_TASK_SWITCH == 1 )
+    portTickType switchTick = xTaskGetTickCount();
+    uint32 switchCount = ulDebugTaskSwitchCount;
+#endif
+
+    for (;;)
+    {
+        while (m_ringTail != m_ringHead)
+        {
+            pRecord = &m_ring[m_ringTail & DEBUG_RING_MASK];
+
+            /*The slot is claimed but still being written*/
+            if (pRecord->sequence != (m_ringTail + 1))
+            {
+                break;
+            }
+
+            __DMB();
+
+            Debug_writeUnsignedNumber(
+                VIRTUAL_TIMER_TICKS2MSEC(pRecord->timestamp), DECIMAL_BASE);
+            Debug_writeChar(' ');
+            Debug_format(pRecord->moduleStr, pRecord->strId,
+                         pRecord->format, pRecord->args, pRecord->argc);
+
+            __DMB();
+            m_ringTail++;
+        }
+
+        if (dropped != m_ringDropped)
+        {
+            args[0] = m_ringDropped - dropped;
+            dropped += args[0];
+            Debug_format("ERR", STR_ID_NULL, "%u printouts dropped", args, 1);
+        }
+
+#if ( configDEBUG_TASK_SWITCH == 1 )
+        if ((xTaskGetTickCount() - switchTick) >= TASK_MSEC2TICKS(DEBUG_TASK_SWITCH_PERIOD_SEC * 1000))
+        {
+            switchTick = xTaskGetTickCount();
+            args[0] = (ulDebugTaskSwitchCount - switchCount) / DEBUG_TASK_SWITCH_PERIOD_SEC;
+            switchCount = ulDebugTaskSwitchCount;
+
+            if (m_traceEnableMask & DEBUG_DEBUG)
+            {
+                Debug_format("DBG", STR_ID_NULL, "%u task switches/s", args, 1);
+            }
+        }
+#endif
+
+        Debug_flush();
+
+        /*Sleeps until a printout is queued or dropped*/
+        xSemaphoreTake(m_drainSema, DEBUG_DRAIN_TIME_TICK);
+    }
+}
+#endif
+
 void putch(char c)
 {
     usart_putchar(c);
@@ -208,7 +594,16 @@ void putch(char c)
 /*----------------------------------------------------------------------------*/
 static void Debug_writeChar(char ch)
 {
+#if ( configDEBUG_DEFERRED == 1 )
+    /*Only the drain task formats printouts in this mode*/
+    m_packet[m_packetLength++] = ch;
+    if (m_packetLength >= DEBUG_PACKET_SIZE)
+    {
+        Debug_flush();
+    }
+#else
     putch(ch);
+#endif
 }
 
 /*----------------------------------------------------------------------------*/
@@ -253,7 +648,7 @@ static void Debug_writeUnsignedNumber(uint32 number, uint16 base)
     /* Print the characters in the right order */
     while (pos < MAX_NUMBER_BUFFER)
     {
-        putch(result[pos]);
+        Debug_writeChar(result[pos]);
         pos++;
     }
 }
@@ -265,27 +660,91 @@ void Debug_printEEDIDData(uint8 *buff, uint16 size)
 
     /* Send the identification code to the AppCom*/
     /* The AppCom will recognizes this printout as EEDID data*/
-    Debug_writeChar(STR_EEDID_ID_CODE_1);
-    Debug_writeChar(STR_EEDID_ID_CODE_2);
+    /* Written directly, also in the deferred mode */
+    putch(STR_EEDID_ID_CODE_1);
+    putch(STR_EEDID_ID_CODE_2);
 
     /* Send the high bype of a 16 bits integer*/
-    Debug_writeChar(size >> 8);
+    putch(size >> 8);
 
     /* Send the low bype of a 16 bits integer*/
-    Debug_writeChar(size & 0xff);
+    putch(size & 0xff);
 
     /** Print out the buffer */
     for (i = 0; i < size; i++)
     {
         data = *(buff + i);
-        Debug_writeUnsignedNumber(data, HEXADECIMAL_BASE);
+        if (data >= HEXADECIMAL_BASE)
+        {
+            putch(CHAR_MAP[data >> 4]);
+        }
+        putch(CHAR_MAP[data & 0x0F]);
         putch((char)STR_EEDID_DELIMITER);
     }
 
-    Debug_writeChar('\n');
+    putch('\n');
 }
 
+#if ( configDEBUG_LATENCY == 1 )
+/*----------------------------------------------------------------------------*/
+void Debug_latencyBegin(DEBUG_LATENCY_ID id)
+{
+    if (id >= DEBUG_LATENCY_NUMBER)
+    {
+        return;
+    }
 
+    /* The cycle counter runs without a debugger once trace is enabled */
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /* Never 0, which marks a closed measure */
+    m_latency[id].start = DWT->CYCCNT | 1;
+}
+
+/*----------------------------------------------------------------------------*/
+void Debug_latencyEnd(DEBUG_LATENCY_ID id)
+{
+    Debug_latency *pLatency;
+    uint32 usec;
+
+    if (id >= DEBUG_LATENCY_NUMBER)
+    {
+        return;
+    }
+
+    pLatency = &m_latency[id];
+    if (pLatency->start == 0)
+    {
+        return;
+    }
+
+    /* The counter wraps after 2^32 cycles, about 42 seconds at 100MHz */
+    usec = (DWT->CYCCNT - pLatency->start) / (SystemCoreClock / 1000000);
+    pLatency->start = 0;
+
+    if ((pLatency->count == 0) || (usec < pLatency->min))
+    {
+        pLatency->min = usec;
+    }
+
+    if (usec > pLatency->max)
+    {
+        pLatency->max = usec;
+    }
+
+    pLatency->total += usec;
+    pLatency->count++;
+
+    TRACE_DEBUG((0, "LATENCY %s %u us min %u max %u avg %u n %u",
+                 m_latencyName[id], usec, pLatency->min, pLatency->max,
+                 (pLatency->total / pLatency->count), pLatency->count));
+}
+#endif
 
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef __APPLICATION_DEBUG_H__
 #define __APPLICATION_DEBUG_H__
 
+#include "device_config.h"
+
 #ifdef DEBUG
 
 #include "Defs.h"
@@ -216,5 +218,43 @@ DEBUG_PRINT_DEF(SPI);
                 (str), (50 * t) / 1000));} \
     }
 
+/*--------------------------------LATENCY-------------------------------------*/
+
+#if defined ( DEBUG ) && ( configDEBUG_LATENCY == 1 )
+/**
+ * The paths measured by the latency probes. A probe runs from its begin mark
+ * to its end mark, which may be in another task.
+ */
+typedef enum
+{
+    DEBUG_LATENCY_INPUT_SWITCH = 0,
+    DEBUG_LATENCY_VOLUME_STEP,
+    DEBUG_LATENCY_ULD_LOAD,
+    DEBUG_LATENCY_POWER_UP,
+    DEBUG_LATENCY_NUMBER
+} DEBUG_LATENCY_ID;
+
+/**
+ * Marks the start of a measured path with the DWT cycle counter.
+ *
+ * @param id  The path.
+ */
+void Debug_latencyBegin(DEBUG_LATENCY_ID id);
+
+/**
+ * Marks the end of a measured path. The time since the begin mark and the
+ * min/max/average of the path are printed. Ignored without a begin mark.
+ *
+ * @param id  The path.
+ */
+void Debug_latencyEnd(DEBUG_LATENCY_ID id);
+
+#define DEBUG_LATENCY_BEGIN(id) Debug_latencyBegin(id)
+#define DEBUG_LATENCY_END(id)   Debug_latencyEnd(id)
+#else
+#define DEBUG_LATENCY_BEGIN(id)
+#define DEBUG_LATENCY_END(id)
+#endif
+
 #endif /* __APPLICATION_DEBUG_H__ */
 
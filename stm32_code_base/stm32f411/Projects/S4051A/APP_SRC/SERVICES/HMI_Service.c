@@ -50,6 +50,11 @@ typedef struct HMI_SERVICE_PARAMETERS
     TaskHandleState userState;
     xQueueParameters serviceQueue;
     xOS_TaskErrIndicator xOS_ErrId;
+#if ( configHMI_EVENT_DRIVEN == 1 )
+    xTimerHandle apcTimer;
+    xTimerHandle aidTimer;
+    bool apcEnabled; /*APC is held off while the auto input detect runs*/
+#endif
 } xHMISrvClusion;
 
 typedef struct _MASTER_GAIN_LIMIT
@@ -124,9 +129,19 @@ static void HMI_AutoInputDetect_CreateTask(void);
 
 static void HMI_AutoInputDetect_TaskCtl(bool val);
 
+static void HMI_AutoInputDetect_Process( void );
+
+#if ( configHMI_EVENT_DRIVEN == 1 )
+static void HMI_AutoInputDetect_Timer( xTimerHandle xTimer );
+
+static void HMI_AutoPowerControl_Arm( void );
+#else
 static void HMI_AutoInputDetect_task( void *pvParameters );
+#endif
 
 static xHMISystemParams HMI_Service_getSystemParams( void );
+
+static void HMI_Service_commitStorage( void );
 //_________________________________________________________________________________________
 
 extern POWER_HANDLE_OBJECT *pPowerHandle_ObjCtrl;
@@ -166,6 +181,14 @@ const HMI_FACTORY_OBJECT *pHFS_ObjCtrl = &HMI_FACTORY_OBJ;
 
 //_________________________________________________________________________________________
 
+/*Commit the pending parameters before the power task can drop the rails,
+  the EEPROM write runs in the caller's context*/
+static void HMI_Service_commitStorage( void )
+{
+    mSystemParams.sys_event = SYS_EVENT_SYSTEM_DOWN;
+    pSDM_ObjCtrl->SendEvent( &mSystemParams );
+}
+
 static void _PWR_ENABLE_CTRL(bool b_pwr_on)
 {
 #if ( configSTM32F411_PORTING == 1 )
@@ -179,6 +202,11 @@ static void _PWR_ENABLE_CTRL(bool b_pwr_on)
         return;
     }
 #endif    
+    if ( !b_pwr_on && pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
+    {
+        HMI_Service_commitStorage();
+    }
+
     pPowerHandle_ObjCtrl->power_toggle();
     //pBTHandle_ObjCtrl->power_ctl();    // No need to do this here. It is included in BT_HANDLE_RESET_BT event when execute _RST_DEF_SETTING
 
@@ -402,6 +430,11 @@ static void HMI_Service_sendCommand( xHMIUserEvents event )
 
         case USER_EVENT_POWER:
         {
+            if ( pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
+            {
+                HMI_Service_commitStorage();
+            }
+
             pPowerHandle_ObjCtrl->power_toggle();  
             
 #if ( configSTM32F411_PORTING == 1 )  
@@ -413,7 +446,6 @@ static void HMI_Service_sendCommand( xHMIUserEvents event )
                 pUDM_ObjCtrl->SendEvent( &mSystemParams );
                 pASH_ObjCtrl->SendEvent( &mSystemParams );
 #if ( configSTM32F411_PORTING == 1 )   
-                pSDM_ObjCtrl->SendEvent( &mSystemParams ); 
                 pUSB_MMP_ObjCtrl->SendEvent(&mSystemParams);
 
                 if (pSystemParams->auto_input_detect == TRUE)
@@ -1234,10 +1266,10 @@ static void HMI_Service_sendCommand( xHMIUserEvents event )
                 pBTN_ObjCtrl->register_user_cmd();              
                 TRACE_DEBUG((0, "MODE - USER "));
                 
+                HMI_Service_commitStorage();
                 pPowerHandle_ObjCtrl->power_toggle();
                 pBTHandle_ObjCtrl->power_ctl();
                 mSystemParams.sys_event = SYS_EVENT_SYSTEM_DOWN;
-                pSDM_ObjCtrl->SendEvent( &mSystemParams ); 
                 pASH_ObjCtrl->SendEvent( &mSystemParams );
 #if ( configSTM32F411_PORTING == 1 )                
                 pUSB_MMP_ObjCtrl->SendEvent(&mSystemParams);
@@ -1270,10 +1302,10 @@ static void HMI_Service_sendCommand( xHMIUserEvents event )
                 pBTN_ObjCtrl->register_user_cmd();
                 TRACE_DEBUG((0, "MODE - USER "));
                 
+                HMI_Service_commitStorage();
                 pPowerHandle_ObjCtrl->power_toggle();
                 pBTHandle_ObjCtrl->power_ctl();
                 mSystemParams.sys_event = SYS_EVENT_SYSTEM_DOWN;
-                pSDM_ObjCtrl->SendEvent( &mSystemParams ); 
                 pASH_ObjCtrl->SendEvent( &mSystemParams );
 #if ( configSTM32F411_PORTING == 1 )                
                 pUSB_MMP_ObjCtrl->SendEvent(&mSystemParams);
@@ -1307,10 +1339,10 @@ static void HMI_Service_sendCommand( xHMIUserEvents event )
                 pBTN_ObjCtrl->register_user_cmd();
        
                 TRACE_DEBUG((0, "MODE - USER "));
+                HMI_Service_commitStorage();
                 pPowerHandle_ObjCtrl->power_toggle();
                 pBTHandle_ObjCtrl->power_ctl();
                 mSystemParams.sys_event = SYS_EVENT_SYSTEM_DOWN;
-                pSDM_ObjCtrl->SendEvent( &mSystemParams ); 
                 pASH_ObjCtrl->SendEvent( &mSystemParams );
 #if ( configSTM32F411_PORTING == 1 )                
                 pUSB_MMP_ObjCtrl->SendEvent(&mSystemParams);
@@ -1768,6 +1800,34 @@ static uint8 HMI_Service_InstrGetQueueNumber( void )
     return (uint8)uxQueueMessagesWaiting(mHMISrvClusion.serviceQueue.xQueue);
 }
 
+#if ( configHMI_EVENT_DRIVEN == 1 )
+void HMI_ServiceUser( void *pvParameters )
+{
+    xHMISrvEventParams EventParams;
+
+    pSDM_ObjCtrl->Initialize( &mSystemParams ); /*Reloader user parameters from EEPROM*/
+    mHMISrvClusion.userState = TASK_READY;
+
+    for( ;; )
+    {
+        /*Sleep until an event is queued, nothing in here is periodic*/
+        if ( xQueueReceive( mHMISrvClusion.serviceQueue.xQueue, &EventParams, portMAX_DELAY ) != pdPASS )
+        {
+            continue;
+        }
+
+        mHMISrvClusion.userState = TASK_RUNING;
+#if ( configMonitorHeapSize == 1 )        
+        free_heap_size = xPortGetFreeHeapSize();    
+#endif
+        HMI_Service_handleCommand( &EventParams );
+
+        /*The event may have changed power, APD or op mode*/
+        HMI_AutoPowerControl_Arm();
+        mHMISrvClusion.userState = TASK_READY;
+    }
+}
+#else
 void HMI_ServiceUser( void *pvParameters )
 {
     xHMISrvEventParams EventParams;
@@ -1821,87 +1881,146 @@ void HMI_ServiceUser( void *pvParameters )
         vTaskDelay(HMI_TIME_TICK);
     }
 }
+#endif
 
-void HMI_AutoPowerControl_Task( void *pvParameters )
+static void HMI_AutoPowerControl_Process( void )
 {
-    xHMISrvEventParams srv_parms = {xHMI_EVENT_APC, USER_EVENT_UNDEFINED };
+    static xHMISrvEventParams srv_parms = {xHMI_EVENT_APC, USER_EVENT_UNDEFINED };
     static uint16 timeout = HMI_APD_TIMEOUT;
 
-    for( ;; )
+    if( pPowerHandle_ObjCtrl->get_power_state() == POWER_OFF )
     {
-        if( pPowerHandle_ObjCtrl->get_power_state() == POWER_OFF )
-        {
-            timeout = HMI_APD_TIMEOUT;
+        timeout = HMI_APD_TIMEOUT;
 
-            switch( pSystemParams->op_mode )
+        switch( pSystemParams->op_mode )
+        {
+            case MODE_FACTORY:
             {
-                case MODE_FACTORY:
-                {
-                    /*TODO*/
-                    srv_parms.event_id = xHMI_EVENT_UART; /*ir m2489 or vcp factory command*/
-                }
-                    break;
-                case MODE_DEMO_1:
-                {
-                    HMI_Service_setDemo1n3_SysParams( pSystemParams->op_mode );
-                    pBTN_ObjCtrl->register_demo_1n3_cmd();
-                }
-                    break;
-                    
-                case MODE_DEMO_2:
-                {
-                    HMI_Service_setDemo1n3_SysParams( pSystemParams->op_mode );
-                    pBTN_ObjCtrl->register_demo_2_cmd();
-                }
-                    break;
-                    
-                case MODE_DEMO_3:
-                {
-                    HMI_Service_setDemo1n3_SysParams( pSystemParams->op_mode );
-                    pBTN_ObjCtrl->register_demo_1n3_cmd();
-                }
-                    break;
+                /*TODO*/
+                srv_parms.event_id = xHMI_EVENT_UART; /*ir m2489 or vcp factory command*/
             }
-
-            if ( pSystemParams->op_mode != MODE_USER )
+                break;
+            case MODE_DEMO_1:
             {
-                srv_parms.event = USER_EVENT_POWER;
-                HMI_Service_EventSender( &srv_parms );
+                HMI_Service_setDemo1n3_SysParams( pSystemParams->op_mode );
+                pBTN_ObjCtrl->register_demo_1n3_cmd();
             }
-        
+                break;
+                
+            case MODE_DEMO_2:
+            {
+                HMI_Service_setDemo1n3_SysParams( pSystemParams->op_mode );
+                pBTN_ObjCtrl->register_demo_2_cmd();
+            }
+                break;
+                
+            case MODE_DEMO_3:
+            {
+                HMI_Service_setDemo1n3_SysParams( pSystemParams->op_mode );
+                pBTN_ObjCtrl->register_demo_1n3_cmd();
+            }
+                break;
         }
-        else if ( pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
+
+        if ( pSystemParams->op_mode != MODE_USER )
         {
-            if ( pSystemParams->apd == TRUE )
+            srv_parms.event = USER_EVENT_POWER;
+            HMI_Service_EventSender( &srv_parms );
+        }
+    
+    }
+    else if ( pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
+    {
+        if ( pSystemParams->apd == TRUE )
+        {
+            if ( pASH_ObjCtrl->IsSignalAvailable() == 0)
             {
-                if ( pASH_ObjCtrl->IsSignalAvailable() == 0)
+                if ( timeout < 1 )
                 {
-                    if ( timeout < 1 )
-                    {
-                        timeout = HMI_APD_TIMEOUT;
-                        srv_parms.event = USER_EVENT_POWER;
-                        HMI_Service_EventSender( &srv_parms );
-                    }
-                    else
-                    {
-                        timeout --;
-                        TRACE_DEBUG((0, "APD COUNT = %d", timeout ));
-                    }
+                    timeout = HMI_APD_TIMEOUT;
+                    srv_parms.event = USER_EVENT_POWER;
+                    HMI_Service_EventSender( &srv_parms );
                 }
                 else
                 {
-                    timeout = HMI_APD_TIMEOUT;
+                    timeout --;
+                    TRACE_DEBUG((0, "APD COUNT = %d", timeout ));
                 }
             }
+            else
+            {
+                timeout = HMI_APD_TIMEOUT;
+            }
+        }
+    }
+}
+
+#if ( configHMI_EVENT_DRIVEN == 1 )
+static void HMI_AutoPowerControl_Timer( xTimerHandle xTimer )
+{
+    HMI_AutoPowerControl_Process();
+
+    /*Stops itself once there is nothing left to watch, the next HMI event arms it again*/
+    HMI_AutoPowerControl_Arm();
+}
+
+static void HMI_AutoPowerControl_Arm( void )
+{
+    bool relevant = FALSE;
+
+    if ( mHMISrvClusion.apcTimer == NULL )
+    {
+        return;
+    }
+
+    if ( mHMISrvClusion.apcEnabled == TRUE )
+    {
+        if ( pPowerHandle_ObjCtrl->get_power_state() == POWER_OFF )
+        {
+            relevant = ( pSystemParams->op_mode != MODE_USER );  /*demo modes power up again*/
         }
+        else if ( pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
+        {
+            relevant = ( pSystemParams->apd == TRUE );  /*auto standby countdown*/
+        }
+    }
+
+    if ( relevant == TRUE )
+    {
+        if ( xTimerIsTimerActive( mHMISrvClusion.apcTimer ) == pdFALSE )
+        {
+            xTimerStart( mHMISrvClusion.apcTimer, 0 );
+        }
+    }
+    else
+    {
+        xTimerStop( mHMISrvClusion.apcTimer, 0 );
+    }
+}
+#else
+void HMI_AutoPowerControl_Task( void *pvParameters )
+{
+    for( ;; )
+    {
+        HMI_AutoPowerControl_Process();
         
         vTaskDelay(HMI_APC_TIME_TICK);
     }
 }
+#endif
 
 void HMI_AutoPowerControl_CreateTask( void )
 {
 #if ( configAPP_APD == 1 )
+#if ( configHMI_EVENT_DRIVEN == 1 )
+    /*Created stopped like the task was created suspended*/
+    mHMISrvClusion.apcEnabled = FALSE;
+    mHMISrvClusion.apcTimer = xTimerCreate( "HMI_APC", HMI_APC_TIME_TICK, pdTRUE, NULL, HMI_AutoPowerControl_Timer );
+    if ( mHMISrvClusion.apcTimer == NULL )
+    {
+        TRACE_ERROR((0, "HMI_APC timer create failure " ));
+    }
+#else
     if ( xTaskCreate( 
         HMI_AutoPowerControl_Task, 
         ( portCHAR * ) "HMI_APC", 
@@ -1916,11 +2035,32 @@ void HMI_AutoPowerControl_CreateTask( void )
     {
         vTaskSuspend( mHMISrvClusion.apcTaskHandle );
     }
+#endif
 #endif     
 }
 
 static void HMI_AutoPowerControl_TaskCtl(bool val)
 {
+#if ( configHMI_EVENT_DRIVEN == 1 )
+    if( val == BTASK_SUSPENDED )
+    {
+        if ( mHMISrvClusion.apcEnabled == TRUE )
+        {
+            TRACE_DEBUG((0, "SUSPEND: HMI_AutoPowerControl_TaskCtl"));
+            mHMISrvClusion.apcEnabled = FALSE;
+            HMI_AutoPowerControl_Arm();
+        }
+    }
+    else
+    {
+        if ( mHMISrvClusion.apcEnabled == FALSE )
+        {
+            mHMISrvClusion.apcEnabled = TRUE;
+            HMI_AutoPowerControl_Arm();
+            TRACE_DEBUG((0, "RESUME: HMI_AutoPowerControl_TaskCtl"));
+        }
+    }
+#else
     if( val == BTASK_SUSPENDED )
     {
         if ( xTaskIsTaskSuspended( mHMISrvClusion.apcTaskHandle ) != pdPASS ) /*task is working*/
@@ -1937,6 +2077,7 @@ static void HMI_AutoPowerControl_TaskCtl(bool val)
             TRACE_DEBUG((0, "RESUME: HMI_AutoPowerControl_TaskCtl"));
         }
     }
+#endif
 }
 
 /*******************************************************************************
@@ -1945,6 +2086,13 @@ static void HMI_AutoPowerControl_TaskCtl(bool val)
 static void HMI_AutoInputDetect_CreateTask(void)
 {
 #if ( configAPP_AID == 1 )
+#if ( configHMI_EVENT_DRIVEN == 1 )
+    mHMISrvClusion.aidTimer = xTimerCreate( "HMI_AID", HMI_AID_TIME_TICK, pdTRUE, NULL, HMI_AutoInputDetect_Timer );
+    if ( ( mHMISrvClusion.aidTimer == NULL ) || ( xTimerStart( mHMISrvClusion.aidTimer, 0 ) != pdPASS ) )
+    {
+        TRACE_ERROR((0, "Auto_Input_Detect_Manager timer create failure " ));
+    }
+#else
     if ( xTaskCreate( 
                     HMI_AutoInputDetect_task, 
                     ( portCHAR * ) "Auto_Input_Detect_Manager", 
@@ -1956,11 +2104,46 @@ static void HMI_AutoInputDetect_CreateTask(void)
         vTaskDelete( mHMISrvClusion.aidTaskHandle  );
         TRACE_ERROR((0, "Auto_Input_Detect_Manager task create failure " ));
     }
+#endif
 #endif       
 }
 
 static void HMI_AutoInputDetect_TaskCtl(bool val)
 {
+#if ( configHMI_EVENT_DRIVEN == 1 )
+    if ( mHMISrvClusion.aidTimer == NULL )
+    {
+        return;
+    }
+
+    if( val == BTASK_SUSPENDED )
+    {
+        if ( xTimerIsTimerActive( mHMISrvClusion.aidTimer ) != pdFALSE ) /*timer is running*/
+        {
+            TRACE_DEBUG((0, "SUSPEND: Auto_Input_Detect_Manager"));
+            HMI_AutoPowerControl_TaskCtl(BTASK_RESUME);
+            xTimerStop( mHMISrvClusion.aidTimer, 0 );
+        }
+    }
+    else
+    {
+        if ( xTimerIsTimerActive( mHMISrvClusion.aidTimer ) == pdFALSE ) /*timer is stopped*/
+        {
+            AID_timeout = AID_TIMEOUT;
+            mSignalAvaiableCnt = 0;
+            mSignalUnavaiableCnt = 0;
+            mProcessCnt = 0;  
+            xTimerStart( mHMISrvClusion.aidTimer, 0 );
+            TRACE_DEBUG((0, "RESUME: Auto_Input_Detect_Manager"));
+            HMI_AutoPowerControl_TaskCtl(BTASK_SUSPENDED);
+            if (  pPowerHandle_ObjCtrl->get_power_state() != POWER_ON )
+            {
+                aid_parms.event = USER_EVENT_POWER; /* Poweron*/
+                HMI_Service_EventSender( &aid_parms );
+            }
+        }
+    }
+#else
     if( val == BTASK_SUSPENDED )
     {
         if ( xTaskIsTaskSuspended( mHMISrvClusion.aidTaskHandle ) != pdPASS ) /*task is working*/
@@ -1988,152 +2171,173 @@ static void HMI_AutoInputDetect_TaskCtl(bool val)
             }
         }
     }
+#endif
 }
 
-static void HMI_AutoInputDetect_task( void *pvParameters )
+static void HMI_AutoInputDetect_Process( void )
 {
     uint8 SignalAvaliableThrehold; 
     uint8 SystemResetType;
 
-    for(;;)
+    if( pHMISrvClusion->userState == TASK_READY )
     {
-        if( pHMISrvClusion->userState == TASK_READY )
+        /*Turn off when flag is not set*/
+        if ( pSystemParams->auto_input_detect == FALSE)
         {
-            /*Turn off when flag is not set*/
-            if ( pSystemParams->auto_input_detect == FALSE)
+            HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
+        }
+        
+        if (  pPowerHandle_ObjCtrl->get_power_state() == POWER_OFF )
+        {
+            aid_parms.event = USER_EVENT_POWER; /* Poweron*/
+            HMI_Service_EventSender( &aid_parms );
+        }
+        
+        if (  pPowerHandle_ObjCtrl->get_power_state() == POWER_ON ) 
+        {
+            mProcessCnt++;
+
+            SystemResetType = pPowerHandle_ObjCtrl->getSystemResetType();
+
+            UserParmsAutoPowerDown = pSystemParams->auto_input_detect;
+
+            /* Terminate the auto detection when it is not User mode. Tony140108 */
+            if ( pSystemParams->op_mode != MODE_USER ) 
             {
                 HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
             }
-            
-            if (  pPowerHandle_ObjCtrl->get_power_state() == POWER_OFF )
+
+            /* Clean ac on and reset flag */
+            if ( SystemResetType == RCC_FLAG_PORRST || SystemResetType == RCC_FLAG_SFTRST )
             {
-                aid_parms.event = USER_EVENT_POWER; /* Poweron*/
-                HMI_Service_EventSender( &aid_parms );
+                pPowerHandle_ObjCtrl->clrSystemResetType();
             }
-            
-            if (  pPowerHandle_ObjCtrl->get_power_state() == POWER_ON ) 
-            {
-                mProcessCnt++;
-
-                SystemResetType = pPowerHandle_ObjCtrl->getSystemResetType();
 
-                UserParmsAutoPowerDown = pSystemParams->auto_input_detect;
+            /*If auto power down condition is changed, reset the time stamp */
+            if (LastUserParmsAutoPowerDown!=UserParmsAutoPowerDown )
+            {
+                AID_timeout = AID_TIMEOUT;
+            }
+            
+            /* Update current AutoPower down flag */
+            LastUserParmsAutoPowerDown = UserParmsAutoPowerDown;
 
-                /* Terminate the auto detection when it is not User mode. Tony140108 */
-                if ( pSystemParams->op_mode != MODE_USER ) 
+            if ( AID_timeout < 1 )
+            {      
+                if ( pSystemParams->auto_input_detect == TRUE )
                 {
+                    aid_parms.event = USER_EVENT_AUTO_INPUT_DETECT_CLEAN; /*Clean Flag*/
+                    HMI_Service_EventSender( &aid_parms );
+                    if (  pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
+                    {
+                        aid_parms.event = USER_EVENT_POWER; /* Powerdown*/
+                    }
+                    HMI_Service_EventSender( &aid_parms );
+                    TRACE_DEBUG((0, "  Auto detection 15 mins auto power down   !! ")); 
+                    AID_timeout = AID_TIMEOUT;
                     HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
                 }
-
-                /* Clean ac on and reset flag */
-                if ( SystemResetType == RCC_FLAG_PORRST || SystemResetType == RCC_FLAG_SFTRST )
+                else
                 {
-                    pPowerHandle_ObjCtrl->clrSystemResetType();
+                    AID_timeout = AID_TIMEOUT;
+                    TRACE_DEBUG((0, "  Auto detection 15 mins reset   !! "));
                 }
+            }
+            else
+            {
+                AID_timeout --;
+                //TRACE_DEBUG((0, "  AID_timeout =%X ",AID_timeout));
+            }
 
-                /*If auto power down condition is changed, reset the time stamp */
-                if (LastUserParmsAutoPowerDown!=UserParmsAutoPowerDown )
+            switch( pSystemParams->input_src ) 
+            {
+                case AUDIO_SOURCE_AUX1:
+                case AUDIO_SOURCE_AUX2:
                 {
-                    AID_timeout = AID_TIMEOUT;
+                    SignalAvaliableThrehold = AnalogThrehold;
                 }
-                
-                /* Update current AutoPower down flag */
-                LastUserParmsAutoPowerDown = UserParmsAutoPowerDown;
+                break;
 
-                if ( AID_timeout < 1 )
-                {      
-                    if ( pSystemParams->auto_input_detect == TRUE )
-                    {
-                        aid_parms.event = USER_EVENT_AUTO_INPUT_DETECT_CLEAN; /*Clean Flag*/
-                        HMI_Service_EventSender( &aid_parms );
-                        if (  pPowerHandle_ObjCtrl->get_power_state() == POWER_ON )
-                        {
-                            aid_parms.event = USER_EVENT_POWER; /* Powerdown*/
-                        }
-                        HMI_Service_EventSender( &aid_parms );
-                        TRACE_DEBUG((0, "  Auto detection 15 mins auto power down   !! ")); 
-                        AID_timeout = AID_TIMEOUT;
-                        HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
-                    }
-                    else
-                    {
-                        AID_timeout = AID_TIMEOUT;
-                        TRACE_DEBUG((0, "  Auto detection 15 mins reset   !! "));
-                    }
-                }
-                else
+                case AUDIO_SOURCE_COAXIAL:
+                case AUDIO_SOURCE_OPTICAL:
                 {
-                    AID_timeout --;
-                    //TRACE_DEBUG((0, "  AID_timeout =%X ",AID_timeout));
+                    SignalAvaliableThrehold = DigitalThrehold;
                 }
+                break;
 
-                switch( pSystemParams->input_src ) 
+                default:
                 {
-                    case AUDIO_SOURCE_AUX1:
-                    case AUDIO_SOURCE_AUX2:
-                    {
-                        SignalAvaliableThrehold = AnalogThrehold;
-                    }
-                    break;
-
-                    case AUDIO_SOURCE_COAXIAL:
-                    case AUDIO_SOURCE_OPTICAL:
-                    {
-                        SignalAvaliableThrehold = DigitalThrehold;
-                    }
-                    break;
+                    aid_parms.event = USER_EVENT_AUTO_INPUT_DETECT_CLEAN; /*Clean Flag*/
+                    HMI_Service_EventSender( &aid_parms );
 
-                    default:
-                    {
-                        aid_parms.event = USER_EVENT_AUTO_INPUT_DETECT_CLEAN; /*Clean Flag*/
-                        HMI_Service_EventSender( &aid_parms );
-
-                        TRACE_DEBUG((0,"Not a Auto Detection source"));
-                        HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
+                    TRACE_DEBUG((0,"Not a Auto Detection source"));
+                    HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
 
-                        return;
+                    return;
 }
-                    break;
-                }
+                break;
+            }
 
-                if ( mProcessCnt > SignalAvaliableThrehold )
+            if ( mProcessCnt > SignalAvaliableThrehold )
+            {
+                if( pASH_ObjCtrl->IsSignalAvailable() == 1)
                 {
-                    if( pASH_ObjCtrl->IsSignalAvailable() == 1)
-                    {
-                        mSignalAvaiableCnt++;
-                        if ( mSignalAvaiableCnt >= CheckSignalAvaiableTime)
-                        {
-                            aid_parms.event = USER_EVENT_AUTO_INPUT_DETECT_CLEAN; 
-                            HMI_Service_EventSender( &aid_parms );
-                            
-                            HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
-                        } 
-                    }
-                    else
+                    mSignalAvaiableCnt++;
+                    if ( mSignalAvaiableCnt >= CheckSignalAvaiableTime)
                     {
-                        //TRACE_DEBUG((0,"mProcessCnt=%X,SignalAvaliableThrehold=%X",mProcessCnt,SignalAvaliableThrehold));
-                        mSignalUnavaiableCnt++;
+                        aid_parms.event = USER_EVENT_AUTO_INPUT_DETECT_CLEAN; 
+                        HMI_Service_EventSender( &aid_parms );
                         
-                        if (mSignalUnavaiableCnt >= CheckSignalUnAvaiableTime)
-                        {   
-                            mSignalAvaiableCnt = 0;
-                            mSignalUnavaiableCnt = 0;
-                            mProcessCnt = 0;  
-                            
-                            aid_parms.event = USER_EVENT_AUTO_SEL_SRC;/* Switch source*/
-                            HMI_Service_EventSender( &aid_parms );
-                        }
-                    }    
+                        HMI_AutoInputDetect_TaskCtl(BTASK_SUSPENDED);
+                    } 
                 }
-            }    
-        }
+                else
+                {
+                    //TRACE_DEBUG((0,"mProcessCnt=%X,SignalAvaliableThrehold=%X",mProcessCnt,SignalAvaliableThrehold));
+                    mSignalUnavaiableCnt++;
+                    
+                    if (mSignalUnavaiableCnt >= CheckSignalUnAvaiableTime)
+                    {   
+                        mSignalAvaiableCnt = 0;
+                        mSignalUnavaiableCnt = 0;
+                        mProcessCnt = 0;  
+                        
+                        aid_parms.event = USER_EVENT_AUTO_SEL_SRC;/* Switch source*/
+                        HMI_Service_EventSender( &aid_parms );
+                    }
+                }    
+            }
+        }    
+    }
+}
+
+#if ( configHMI_EVENT_DRIVEN == 1 )
+static void HMI_AutoInputDetect_Timer( xTimerHandle xTimer )
+{
+    HMI_AutoInputDetect_Process();
+}
+#else
+static void HMI_AutoInputDetect_task( void *pvParameters )
+{
+    for(;;)
+    {
+        HMI_AutoInputDetect_Process();
         vTaskDelay(HMI_AID_TIME_TICK);
     }     
 }
+#endif
 
 
 void HMI_Service_CreateTask( void )
 {
+    /*The queue has to exist before the task blocks on it*/
+    mHMISrvClusion.serviceQueue.xQueue = xQueueCreate( HMI_QUEUE_LENGTH,(unsigned portBASE_TYPE )(sizeof(xHMISrvEventParams)/sizeof(uint8)) );
+    mHMISrvClusion.serviceQueue.xBlockTime = BLOCK_TIME(0);
+    if( mHMISrvClusion.serviceQueue.xQueue == NULL )
+    {
+        mHMISrvClusion.xOS_ErrId = xOS_TASK_QUEUE_CREATE_FAIL;
+    }
+
     if ( xTaskCreate( 
         HMI_ServiceUser, 
         ( portCHAR * ) "HMI_SRV_USER", 
@@ -2146,12 +2350,6 @@ void HMI_Service_CreateTask( void )
         mHMISrvClusion.xOS_ErrId = xOS_TASK_CREATE_FAIL;
     }
 
-    mHMISrvClusion.serviceQueue.xQueue = xQueueCreate( HMI_QUEUE_LENGTH,(unsigned portBASE_TYPE )(sizeof(xHMISrvEventParams)/sizeof(uint8)) );
-    mHMISrvClusion.serviceQueue.xBlockTime = BLOCK_TIME(0);
-    if( mHMISrvClusion.serviceQueue.xQueue == NULL )
-    {
-        mHMISrvClusion.xOS_ErrId = xOS_TASK_QUEUE_CREATE_FAIL;
-    }
 
     pPowerHandle_ObjCtrl->initialize(); 
     pASH_ObjCtrl->CreateTask( );
@@ -130,6 +130,11 @@ void usart_putchar( const char c )
 	APP_FOPS.pIf_DataTx(&buf, 1);
 }
 
+void usart_putbuffer( const uint8_t *buf, uint32_t length )
+{
+	APP_FOPS.pIf_DataTx((uint8_t *)buf, length);
+}
+
 static void USBHostDeviceHandler_MSC_ErrHandle( void *pvParameters )
 {
     for( ;; )
@@ -60,11 +60,13 @@ extern uint8_t  APP_Rx_Buffer []; /* Write CDC received data in this buffer.
 extern uint32_t APP_Rx_ptr_in;    /* Increment this pointer or roll it back to
                                      start address when writing received data
                                      in the buffer APP_Rx_Buffer. */
+extern uint32_t APP_Rx_ptr_out;   /* Moved by the SOF handler as the data is
+                                     handed to the USB IN endpoint. */
 
 									 
 /* Extern function prototypes -----------------------------------------------*/
 	 
-extern void usart_lowlevel_handler(uint8_t port, uint8_t c);
+extern void usart_lowlevel_rx_handler(uint8_t port, uint8_t *data, uint32_t length);
 
 /* Private function prototypes -----------------------------------------------*/
 static uint16_t VCP_Init     (void);
@@ -219,20 +221,48 @@ static uint16_t VCP_Ctrl (uint32_t Cmd, uint8_t* Buf, uint32_t Len)
   */
 static uint16_t VCP_DataTx (uint8_t* Buf, uint32_t Len)
 {
+	uint32_t first;
+	uint32_t used;
+	uint32_t primask;
+	uint16_t ret = USBD_OK;
+
+	/* One byte stays free so a full ring is not taken for an empty one */
+	if (Len >= APP_RX_DATA_SIZE)
+	{
+		return USBD_FAIL;
+	}
 
 	if (Len > 0)
 	{
-		for (uint32_t i = 0; i < Len; i++)
-		{
-			APP_Rx_Buffer[APP_Rx_ptr_in] = *(Buf+i);
-			APP_Rx_ptr_in++;		
+		/* Tasks and ISRs may both print; the copy is at most one ring long,
+		   so masking the interrupts around it is the cheapest lock */
+		primask = __get_PRIMASK();
+		__disable_irq();
 
-			if(APP_Rx_ptr_in >= APP_RX_DATA_SIZE)
+		used = (APP_Rx_ptr_in + APP_RX_DATA_SIZE - (APP_Rx_ptr_out % APP_RX_DATA_SIZE)) % APP_RX_DATA_SIZE;
+		if (Len > (APP_RX_DATA_SIZE - 1 - used))
+		{
+			/* The host is not reading; drop the buffer instead of
+			   overwriting what is still queued */
+			ret = USBD_FAIL;
+		}
+		else
+		{
+			/* A buffer that straddles the end of the ring goes in two pieces;
+			   the SOF handler only sees the new APP_Rx_ptr_in once both are in */
+			first = APP_RX_DATA_SIZE - APP_Rx_ptr_in;
+			if (first > Len)
 			{
-				APP_Rx_ptr_in = 0;
-				return USBD_FAIL;
-			}  		  
+				first = Len;
+			}
+
+			memcpy(&APP_Rx_Buffer[APP_Rx_ptr_in], Buf, first);
+			memcpy(&APP_Rx_Buffer[0], (Buf + first), (Len - first));
+
+			APP_Rx_ptr_in = (APP_Rx_ptr_in + Len) % APP_RX_DATA_SIZE;
 		}
+
+		__set_PRIMASK(primask);
 	}
 
 //! Smith mark; Virtual com port doesn't need physical com port.	@{
@@ -256,7 +286,7 @@ static uint16_t VCP_DataTx (uint8_t* Buf, uint32_t Len)
 #endif   
 //!	@}
   
-	return USBD_OK;
+	return ret;
 }
 
 /**
@@ -276,12 +306,8 @@ static uint16_t VCP_DataTx (uint8_t* Buf, uint32_t Len)
   */
 static uint16_t VCP_DataRx (uint8_t* Buf, uint32_t Len)
 {
-	uint32_t i;
-
-	for (i = 0; i < Len; i++)
-	{
-		usart_lowlevel_handler(VIRTUAL_PORT, *(Buf+i) );
-	}
+	/* the whole OUT packet goes to the receive buffer at once */
+	usart_lowlevel_rx_handler(VIRTUAL_PORT, Buf, Len);
 
 //! Smith mark; Virtual com port doesn't need physical com port.	@{	
 #if 0
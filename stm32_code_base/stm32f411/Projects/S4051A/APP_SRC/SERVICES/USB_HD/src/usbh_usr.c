@@ -376,7 +376,12 @@ int USBH_USR_MSC_Application(void)
 		{
 			pUSBFSE_Object->fileSearchTask();
         
+#if ( configUSB_MEDIA_INDEX == 1 )
+                    /* Play from the first file found, the search goes on in USH_USR_FS_PLAY */
+                    if((pUSBFSE_Object->isSearchDone() == TRUE) || (pUSBFSE_Object->getWaveFileNum() > 0))
+#else
                     if(pUSBFSE_Object->isSearchDone() == TRUE)
+#endif
                     {
                         USBH_USR_ApplicationState = USH_USR_FS_PLAY;
                     }
@@ -384,6 +389,12 @@ int USBH_USR_MSC_Application(void)
 		break;
 		case USH_USR_FS_PLAY:
 		{	
+#if ( configUSB_MEDIA_INDEX == 1 )
+                    if(pUSBFSE_Object->isSearchDone() == FALSE)
+                    {
+                        pUSBFSE_Object->fileSearchTask();
+                    }
+#endif
 		      pUSBMedia_ObjCtrl->mediaManagerTask();
 		}
 			break;
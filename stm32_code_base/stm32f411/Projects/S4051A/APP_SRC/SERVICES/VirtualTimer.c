@@ -1,5 +1,6 @@
 #include "FreeRTOSConfig.h"
 #include "freertos_conf.h"
+#include "device_config.h"
 #include "VirtualTimer.h"
 //_________________________________________________________________________
 #define TIME_BASE	TIM3
@@ -8,6 +9,16 @@
 #define VirtualTimer_ISP	TIM3_IRQHandler
 #define configTACE_VIRTUAL_TIMER 0
 
+/* configVIRTUAL_TIMER_TICKLESS (device_config.h): TIM3 counts the 50us ticks
+ * by itself and only interrupts on the counter overflow, every 3.3 sec, instead
+ * of on every tick. VirtualTimer_now() reads the counter.
+ *
+ * VIRTUAL_TIMER_PROC is defined by no project, so the event queue and the
+ * sorted list are compiled out and the ISP only keeps the timer and seconds
+ * counters. Define it in the project options to get VirtualTimer_register()
+ * and friends back; in the tickless mode the deadline of the head event is
+ * then programmed on the TIM3 compare */
+
 
 /*----------------------- Private Member Definitions ------------------------ */
 
@@ -34,10 +45,37 @@ static struct
     void                   *data;     /**< pointer to data to pass        */
     /**< callback                       */
     VirtualTimer_flags      flags;    /**< flags                          */
+    uint8                   next;     /**< next active event by deadline  */
 
 } m_eventQueue[VIRTUAL_TIMER_MAX_EVENTS];
+
+#define VIRTUAL_TIMER_NO_EVENT  0xFF
+
+/**
+ *  first active event. valid and active events are linked in deadline order,
+ *  so the ISP only has to look at the head of the list
+ */
+static uint8 m_eventHead = VIRTUAL_TIMER_NO_EVENT;
+
+/* TRUE if tick a is before tick b, also across the wrap of the timer */
+#define VIRTUAL_TIMER_BEFORE(a, b)  ((int32)((a) - (b)) < 0)
+
+/* the list is shared with the ISP; mask the timer interrupt while editing it */
+#define VIRTUAL_TIMER_LOCK()        NVIC_DisableIRQ(TIME_BASE_IRQ)
+#define VIRTUAL_TIMER_UNLOCK()      NVIC_EnableIRQ(TIME_BASE_IRQ)
 #endif 
 
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+/**
+ *  upper bits of the system timer, the lower 16 bits are the TIM3 counter
+ */
+static volatile uint32 m_nowHigh = 0;
+
+/**
+ *  system time at which m_virtual_sec was last incremented
+ */
+static volatile uint32 m_secMark = 0;
+#else
 /**
  *  the system timer variable
  */
@@ -48,6 +86,11 @@ static volatile uint32 m_now = 0;
  */
 static volatile uint32 m_sleep = 0;
 
+/**
+ *  ticks left to the next m_virtual_sec increment
+ */
+static uint32 m_secTicks = VIRTUAL_TIMER_MSEC2TICKS(1000);
+#endif
 
 /**
  *  sleep timer counter
@@ -58,17 +101,176 @@ static volatile uint32 m_virtual_sec = 0;
 
 /*------------------------ Private Member Definitions ---------------------- */
 
+#if defined ( VIRTUAL_TIMER_PROC )
+/**
+ *  inserts an event in the active list behind the events with the same or an
+ *  earlier deadline. must be called with the timer interrupt masked
+ */
+static void VirtualTimer_link(uint8 event)
+{
+    uint8 *pNext = &m_eventHead;
+
+    while ((*pNext != VIRTUAL_TIMER_NO_EVENT) &&
+            !VIRTUAL_TIMER_BEFORE(m_eventQueue[event].deadline,
+                                  m_eventQueue[*pNext].deadline))
+    {
+        pNext = &m_eventQueue[*pNext].next;
+    }
+
+    m_eventQueue[event].next = *pNext;
+    *pNext = event;
+}
+
+/**
+ *  takes an event out of the active list if it is linked. must be called with
+ *  the timer interrupt masked
+ */
+static void VirtualTimer_unlink(uint8 event)
+{
+    uint8 *pNext = &m_eventHead;
+
+    while (*pNext != VIRTUAL_TIMER_NO_EVENT)
+    {
+        if (*pNext == event)
+        {
+            *pNext = m_eventQueue[event].next;
+            m_eventQueue[event].next = VIRTUAL_TIMER_NO_EVENT;
+            break;
+        }
+
+        pNext = &m_eventQueue[*pNext].next;
+    }
+}
+
+/**
+ *  services the events whose deadline has been reached. the list is sorted so
+ *  only the head is checked when nothing expires
+ */
+static void VirtualTimer_expire(uint32 now)
+{
+    uint8 i;
+
+    while ((m_eventHead != VIRTUAL_TIMER_NO_EVENT) &&
+            !VIRTUAL_TIMER_BEFORE(now, m_eventQueue[m_eventHead].deadline))
+    {
+        i = m_eventHead;
+        m_eventHead = m_eventQueue[i].next;
+        m_eventQueue[i].next = VIRTUAL_TIMER_NO_EVENT;
+
+        if ((m_eventQueue[i].flags.bits.periodic == 0) ||
+                (m_eventQueue[i].period == 0))
+        {
+            /* if event is not periodic cancel it */
+            m_eventQueue[i].flags.bits.active = 0;
+        }
+        else
+        {
+            /* if event is periodic update deadline */
+            m_eventQueue[i].deadline += m_eventQueue[i].period;
+            if (!VIRTUAL_TIMER_BEFORE(now, m_eventQueue[i].deadline))
+            {
+                m_eventQueue[i].deadline = now + m_eventQueue[i].period;
+            }
+            VirtualTimer_link(i);
+        }
+
+        /* if callback is available... */
+        if (m_eventQueue[i].callback)
+        {
+            if (m_eventQueue[i].flags.bits.realtime)
+            {
+                /* if it's realtime call it and pass its data */
+                m_eventQueue[i].callback(m_eventQueue[i].data);
+            }
+            else
+            {
+                /* otherwise flag it for execution */
+                m_eventQueue[i].flags.bits.execute = 1;
+            }
+        }
+    }
+}
+#endif 
+
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 ) && defined ( VIRTUAL_TIMER_PROC )
 /**
- *  timer ISP that gets called each tick and scans the event list for checking
- *  events to execute
+ *  programs the TIM3 compare for the deadline at the head of the list. a
+ *  deadline more than one counter period away is armed again at the overflow
+ */
+static void VirtualTimer_arm(void)
+{
+    uint32 deadline;
+
+    TIM_ITConfig(TIME_BASE, TIM_IT_CC1, DISABLE);
+
+    if (m_eventHead == VIRTUAL_TIMER_NO_EVENT)
+    {
+        return;
+    }
+
+    deadline = m_eventQueue[m_eventHead].deadline;
+    if ((int32)(deadline - VirtualTimer_now()) >= 0x10000)
+    {
+        return;
+    }
+
+    TIM_SetCompare1(TIME_BASE, (uint16)deadline);
+    TIM_ClearITPendingBit(TIME_BASE, TIM_IT_CC1);
+    TIM_ITConfig(TIME_BASE, TIM_IT_CC1, ENABLE);
+
+    /* the compare may have been passed while it was programmed */
+    if (!VIRTUAL_TIMER_BEFORE(VirtualTimer_now(), deadline))
+    {
+        TIM_GenerateEvent(TIME_BASE, TIM_EventSource_CC1);
+    }
+}
+#elif defined ( VIRTUAL_TIMER_PROC )
+#define VirtualTimer_arm()
+#endif
+
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+/**
+ *  timer ISP that gets called on the counter overflow and at the next event
+ *  deadline
  */
 void VirtualTimer_ISP(void)
 {
+    uint32 now;
+
+    if (TIM_GetITStatus(TIME_BASE, TIM_IT_Update) != RESET)
+    {
+        /* VirtualTimer_now() must not see the flag and the new upper bits */
+        __disable_irq();
+        m_nowHigh += 0x10000;
+        TIM_ClearITPendingBit(TIME_BASE, TIM_IT_Update);
+        __enable_irq();
+
+        /*Increment time for one second */
+        now = VirtualTimer_now();
+        while ((now - m_secMark) >= VIRTUAL_TIMER_MSEC2TICKS(1000))
+        {
+            m_secMark += VIRTUAL_TIMER_MSEC2TICKS(1000);
+            m_virtual_sec++;
+        }
+    }
+
+    if (TIM_GetITStatus(TIME_BASE, TIM_IT_CC1) != RESET)
+    {
+        TIM_ClearITPendingBit(TIME_BASE, TIM_IT_CC1);
+    }
 
 #if defined ( VIRTUAL_TIMER_PROC )
-	uint8 i;
+    VirtualTimer_expire(VirtualTimer_now());
+    VirtualTimer_arm();
 #endif 
-
+}
+#else
+/**
+ *  timer ISP that gets called each tick and checks the head of the event list
+ *  for events to execute
+ */
+void VirtualTimer_ISP(void)
+{
 #if ( configRTOS_DEBUG == 1 )
 	current_task = xTaskGetCurrentTaskHandle();
 	sprintf( taskname, "%s", pcTaskGetTaskName( current_task ));
@@ -81,8 +283,9 @@ void VirtualTimer_ISP(void)
 		m_now++;
 
 		/*Increment time for one second */
-		if ( (m_now % VIRTUAL_TIMER_MSEC2TICKS(1000)) == 0 )
+		if (--m_secTicks == 0)
 		{
+			m_secTicks = VIRTUAL_TIMER_MSEC2TICKS(1000);
 			m_virtual_sec++;
 		}
 
@@ -93,39 +296,7 @@ void VirtualTimer_ISP(void)
 		}
 
 #if defined ( VIRTUAL_TIMER_PROC )
-	    /* Scan timer event queue to check which events need to be serviced */
-	    for (i = 0; i < VIRTUAL_TIMER_MAX_EVENTS; i++)
-	    {
-	        if (m_eventQueue[i].flags.bits.valid &&
-	                m_eventQueue[i].flags.bits.active &&
-	                m_eventQueue[i].deadline == m_now)
-	        {
-	            /* if callback is available... */
-	            if (m_eventQueue[i].callback)
-	            {
-	                if (m_eventQueue[i].flags.bits.realtime)
-	                {
-	                    /* if it's realtime call it and pass its data */
-	                    m_eventQueue[i].callback(m_eventQueue[i].data);
-	                }
-	                else
-	                {
-	                    /* otherwise flag it for execution */
-	                    m_eventQueue[i].flags.bits.execute = 1;
-	                }
-	            }
-	            if (m_eventQueue[i].flags.bits.periodic == 0)
-	            {
-	                /* if event is not periodic cancel it */
-	                m_eventQueue[i].flags.bits.active = 0;
-	            }
-	            else
-	            {
-	                /* if event is periodic update deadline */
-	                m_eventQueue[i].deadline = m_now + m_eventQueue[i].period;
-	            }
-	        }
-	    }
+		VirtualTimer_expire(m_now);
 #endif 
 
 #if( configTACE_VIRTUAL_TIMER == 1 )
@@ -137,14 +308,22 @@ void VirtualTimer_ISP(void)
 	}
 
 }
+#endif
 
 /*------------------------ Public Member Definitions ------------------------ */
 
 void VirtualTimer_init(void)
 {
 #if defined ( VIRTUAL_TIMER_PROC )
+    uint8 i;
+
     /* initialize event queue so that everything is clear                     */
     MEMSET(((char *)m_eventQueue), 0, sizeof(m_eventQueue));
+    for (i = 0; i < VIRTUAL_TIMER_MAX_EVENTS; i++)
+    {
+        m_eventQueue[i].next = VIRTUAL_TIMER_NO_EVENT;
+    }
+    m_eventHead = VIRTUAL_TIMER_NO_EVENT;
 #endif 
 
     /*Enable TIM3 interrupt in every 50us*/
@@ -167,6 +346,21 @@ void VirtualTimer_init(void)
 	/* ---------------------------------------------------------------
 	TIME_BASE Configuration(Timer 3 is for basic timer):
 	--------------------------------------------------------------- */
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+	/* Counter runs at the 50us tick and wraps every 65536 ticks; the event
+	 * deadlines are set on the capture/compare 1 */
+	PrescalerValue = (SystemCoreClock /20000 ) - 1;
+	TIM_TimeBaseStructure.TIM_Prescaler = PrescalerValue;
+	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+	TIM_TimeBaseStructure.TIM_Period = 0xFFFF;
+	TIM_TimeBaseStructure.TIM_ClockDivision = 0;
+	TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+
+	TIM_TimeBaseInit(TIME_BASE, &TIM_TimeBaseStructure);
+
+	/* the prescaler load sets the update flag, that's not an overflow */
+	TIM_ClearITPendingBit(TIME_BASE, TIM_IT_Update);
+#else
 	/* Compute the prescaler value; Setup time base as 10Khz; Timer interrupt is in every 50us */
 	PrescalerValue = (SystemCoreClock /20000 ) - 1;
 	/* Time Base configuration */
@@ -177,6 +371,7 @@ void VirtualTimer_init(void)
 	TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
 
 	TIM_TimeBaseInit(TIME_BASE, &TIM_TimeBaseStructure);
+#endif
 
 	/* TIM IT enable */
 	TIM_ITConfig(TIME_BASE, TIM_IT_Update, ENABLE);
@@ -232,12 +427,20 @@ int VirtualTimer_register(
     if (i < VIRTUAL_TIMER_MAX_EVENTS)
     {
         /* if we found an empty entry to use let's fill it with event data  */
+        VIRTUAL_TIMER_LOCK();
         m_eventQueue[i].callback          = callback;
         m_eventQueue[i].data              = data;
         m_eventQueue[i].period            = time;
-        m_eventQueue[i].deadline          = m_now + time;
+        m_eventQueue[i].deadline          = VirtualTimer_now() + time;
         m_eventQueue[i].flags.data        = flags;
         m_eventQueue[i].flags.bits.valid  = 1;
+
+        if (m_eventQueue[i].flags.bits.active)
+        {
+            VirtualTimer_link(i);
+            VirtualTimer_arm();
+        }
+        VIRTUAL_TIMER_UNLOCK();
     }
     else
     {
@@ -259,7 +462,11 @@ bool VirtualTimer_cancel(uint8 event)
             m_eventQueue[event].flags.bits.valid)
     {
         /* disable it */
+        VIRTUAL_TIMER_LOCK();
+        VirtualTimer_unlink(event);
         m_eventQueue[event].flags.bits.active = 0;
+        VirtualTimer_arm();
+        VIRTUAL_TIMER_UNLOCK();
 
         /* and return TRUE */
         ret = TRUE;
@@ -279,8 +486,12 @@ bool VirtualTimer_remove(uint8 event)
             m_eventQueue[event].flags.bits.valid)
     {
         /* disable and invalidate it */
+        VIRTUAL_TIMER_LOCK();
+        VirtualTimer_unlink(event);
         m_eventQueue[event].flags.bits.active = 0;
         m_eventQueue[event].flags.bits.valid  = 0;
+        VirtualTimer_arm();
+        VIRTUAL_TIMER_UNLOCK();
 
         /* and return TRUE */
         ret = TRUE;
@@ -300,9 +511,14 @@ bool VirtualTimer_reschedule(uint8 event, uint32 timeMsec)
             m_eventQueue[event].flags.bits.valid)
     {
         /* Update deadline to new value and activate */
+        VIRTUAL_TIMER_LOCK();
+        VirtualTimer_unlink(event);
         m_eventQueue[event].deadline =
-            m_now + VIRTUAL_TIMER_MSEC2TICKS(timeMsec);
+            VirtualTimer_now() + VIRTUAL_TIMER_MSEC2TICKS(timeMsec);
         m_eventQueue[event].flags.bits.active = 1;
+        VirtualTimer_link(event);
+        VirtualTimer_arm();
+        VIRTUAL_TIMER_UNLOCK();
 
         /* and return TRUE */
         ret = TRUE;
@@ -314,25 +530,55 @@ bool VirtualTimer_reschedule(uint8 event, uint32 timeMsec)
 
 uint32 VirtualTimer_now(void)
 {
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+    uint32 high;
+    uint16 count;
+    bool overflow;
+
+    do
+    {
+        high     = m_nowHigh;
+        count    = TIM_GetCounter(TIME_BASE);
+        overflow = (TIM_GetFlagStatus(TIME_BASE, TIM_FLAG_Update) != RESET);
+    } while (high != m_nowHigh);
+
+    /* counter wrapped but the ISP has not run yet (masked or called from a
+     * higher priority interrupt) */
+    if (overflow && (count < 0x8000))
+    {
+        high += 0x10000;
+    }
+
+    return (high + count);
+#else
     return m_now;
+#endif
 }
 
 uint32 VirtualTimer_nowMs(void)
 {
     /* Returns the time in MS */
-    return VIRTUAL_TIMER_TICKS2MSEC(m_now);
+    return VIRTUAL_TIMER_TICKS2MSEC(VirtualTimer_now());
 }
 
 void VirtualTimer_sleep(uint32 timeMsec)
 {
 #if defined ( VIRTUAL_TIMER_PROC )
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+    uint32 start = VirtualTimer_now();
 
+    while ((VirtualTimer_now() - start) < VIRTUAL_TIMER_MSEC2TICKS(timeMsec))
+    {
+        /* VirtualTimer_poll(); */
+    };
+#else
     m_sleep = VIRTUAL_TIMER_MSEC2TICKS(timeMsec);
 
     while (m_sleep)
     {
         /* VirtualTimer_poll(); */
     };
+#endif
 #endif 
 	
 }
@@ -340,12 +586,21 @@ void VirtualTimer_sleep(uint32 timeMsec)
 void VirtualTimer_minisleep(uint32 time50usec)
 {
 #if defined ( VIRTUAL_TIMER_PROC )
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+    uint32 start = VirtualTimer_now();
+
+    while ((VirtualTimer_now() - start) < VIRTUAL_TIMER_50USEC2TICKS(time50usec))
+    {
+        /* VirtualTimer_poll(); */
+    };
+#else
     m_sleep = VIRTUAL_TIMER_50USEC2TICKS(time50usec);
 
     while (m_sleep)
     {
         /* VirtualTimer_poll(); */
     };
+#endif
 #endif 	
 }
 
@@ -381,6 +636,22 @@ bool VirtualTimer_isTimeout(uint32 *pTimeStamp, uint32 time)
  */
 uint32 VirtualTimer_getCurrentTime()
 {
+#if ( configVIRTUAL_TIMER_TICKLESS == 1 )
+    uint32 sec;
+    uint32 mark;
+    uint32 now;
+
+    /* m_virtual_sec only moves on the counter overflow, add the time since */
+    do
+    {
+        sec  = m_virtual_sec;
+        mark = m_secMark;
+        now  = VirtualTimer_now();
+    } while (sec != m_virtual_sec);
+
+    return ( sec + ((now - mark) / VIRTUAL_TIMER_MSEC2TICKS(1000)) );
+#else
     return ( m_virtual_sec );
+#endif
 }
 
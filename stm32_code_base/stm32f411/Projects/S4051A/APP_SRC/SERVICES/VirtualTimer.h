@@ -29,16 +29,21 @@
  * should be avoided as much as possible as these could interfere with the
  * execution other callbacks. <br>
  * @note Please note that this implementation is not reentrant so methods should
- * not be called by an ISP or in a multi tasking environment
+ * not be called by an ISP or in a multi tasking environment. The event list
+ * itself is edited with the timer interrupt masked.
  *
  * @section VTImplementation_Details Implementation Details
  *
  * The chosen approach is to use a hardware timer to periodically call an ISP
  * that increment a static member variable (m_now) which represents a software
- * timer which is checked against a list of registered events at each interrupt.
- * Whenever the timer is equal to the time of a registered event the event is
- * scheduled for execution and, depending on the nature of the event (single
- * shot or periodic) the event is deleted.<br>
+ * timer. Active events are kept in a list sorted by deadline, so at each
+ * interrupt only the head of the list is compared with the timer. Whenever the
+ * timer reaches the time of a registered event the event is scheduled for
+ * execution and, depending on the nature of the event (single shot or
+ * periodic) the event is deleted or queued again one period later.<br>
+ * With configVIRTUAL_TIMER_TICKLESS the hardware counter itself is the timer
+ * and the ISP only runs at the counter overflow and at the deadline of the
+ * head event, which is programmed on the timer compare.<br>
  * To allow maximum flexibility the event structure contains also a pointer to a
  * data structure so that a single function could implement different tasks
  * based on different contexts.<br>
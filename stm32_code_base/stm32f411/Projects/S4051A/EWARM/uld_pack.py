@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+#
+# Pack the CS4953x configuration tables (uint32 address/value pairs produced by
+# the cirrus dsp tool) into the ULZ block format read by cs49844_ulz.c.
+#
+# usage: python uld_pack.py ..\APP_SRC\Include\s4051_dsp_sdram_uld
+#
+# ULZ block:
+#   [0..3]  raw length in bytes, little endian
+#   tokens  0x00-0x7F : (t+1) literal bytes follow
+#           0x80-0xFF : copy (t&0x7F)+3 bytes from (next byte)+1 back in the
+#                       256 byte window
+# The bytes coded above are the table words after a stride-2 delta
+# (w[n] - w[n-2]), so consecutive addresses collapse to repeated 0x00000001.
+#
+# Every table is decoded again and compared with the source before the header
+# is written; a mismatch stops the build.
+
+import os
+import re
+import struct
+import sys
+
+ULZ_WINDOW = 256
+ULZ_MIN_MATCH = 3
+ULZ_MAX_MATCH = 0x7F + ULZ_MIN_MATCH
+ULZ_MAX_LITERAL = 0x80
+
+# header -> tables read by cs49844.c at LOADER_CONIGURATION
+ULD_TABLES = [
+    ('preKickStart.h', 'PREKICKSTART_CFG'),
+    ('ac3_initial.h', 'AC3_INITIAL_CFG'),
+    ('dts_initial.h', 'DTS_INITIAL_CFG'),
+    ('pcm_initial.h', 'PCM_INITIAL'),
+]
+
+OUT_FILE = 'cfg_ulz.h'
+
+
+def parse_table(path, name):
+    text = open(path, 'r').read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'//[^\n]*', '', text)
+    m = re.search(r'uint32\s+code\s+' + name + r'\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;', text, re.S)
+    if m is None:
+        raise SystemExit('%s: %s not found' % (path, name))
+    return [int(x, 16) for x in re.findall(r'0x[0-9a-fA-F]+', m.group(1))]
+
+
+def delta(words):
+    return [(words[i] - (words[i - 2] if i >= 2 else 0)) & 0xFFFFFFFF for i in range(len(words))]
+
+
+def undelta(words):
+    out = []
+    for i, d in enumerate(words):
+        out.append((d + (out[i - 2] if i >= 2 else 0)) & 0xFFFFFFFF)
+    return out
+
+
+def ulz_encode(raw):
+    data = struct.pack('<%dI' % len(raw), *delta(raw))
+    out = bytearray(struct.pack('<I', len(data)))
+    literal = bytearray()
+    i = 0
+
+    def flush():
+        while literal:
+            run = literal[:ULZ_MAX_LITERAL]
+            out.append(len(run) - 1)
+            out.extend(run)
+            del literal[:ULZ_MAX_LITERAL]
+
+    while i < len(data):
+        best_len = 0
+        best_dist = 0
+        for dist in range(1, min(ULZ_WINDOW, i) + 1):
+            n = 0
+            while n < ULZ_MAX_MATCH and i + n < len(data) and data[i + n] == data[i + n - dist]:
+                n += 1
+            if n > best_len:
+                best_len, best_dist = n, dist
+        if best_len >= ULZ_MIN_MATCH:
+            flush()
+            out.append(0x80 | (best_len - ULZ_MIN_MATCH))
+            out.append(best_dist - 1)
+            i += best_len
+        else:
+            literal.append(data[i])
+            i += 1
+
+    flush()
+    return bytes(out)
+
+
+def ulz_decode(packed):
+    length = struct.unpack('<I', packed[:4])[0]
+    data = bytearray()
+    pos = 4
+    while len(data) < length:
+        token = packed[pos]
+        pos += 1
+        if token < 0x80:
+            data.extend(packed[pos:pos + token + 1])
+            pos += token + 1
+        else:
+            dist = packed[pos] + 1
+            pos += 1
+            for _ in range((token & 0x7F) + ULZ_MIN_MATCH):
+                data.append(data[-dist])
+    if len(data) != length or pos != len(packed):
+        raise ValueError('ULZ stream length mismatch')
+    return undelta(list(struct.unpack('<%dI' % (length // 4), bytes(data))))
+
+
+def main(uld_dir):
+    lines = []
+    lines.append('#ifndef __CFG_ULZ_H__')
+    lines.append('#define __CFG_ULZ_H__')
+    lines.append('')
+    lines.append('/***********************************************')
+    lines.append('This file is created by EWARM/uld_pack.py, do not edit.')
+    lines.append('ULZ packed copies of the configuration tables, see cs49844_ulz.h')
+    lines.append('************************************************/')
+
+    for header, name in ULD_TABLES:
+        raw = parse_table(os.path.join(uld_dir, header), name)
+        packed = ulz_encode(raw)
+        if ulz_decode(packed) != raw:
+            raise SystemExit('%s: %s does not round-trip' % (header, name))
+
+        print('%-20s %6d -> %6d bytes' % (name, len(raw) * 4, len(packed)))
+
+        lines.append('')
+        lines.append('/* %s: %d bytes packed from %d */' % (header, len(packed), len(raw) * 4))
+        lines.append('static const uint8 code %s_ULZ[] = ' % name)
+        lines.append('{')
+        for i in range(0, len(packed), 16):
+            lines.append('  ' + ' '.join('0x%02x,' % b for b in packed[i:i + 16]))
+        lines.append('};')
+
+    lines.append('')
+    lines.append('#endif /*__CFG_ULZ_H__*/')
+    lines.append('')
+
+    with open(os.path.join(uld_dir, OUT_FILE), 'wb') as f:
+        f.write('\r\n'.join(lines).encode('ascii'))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        raise SystemExit('usage: uld_pack.py <uld header directory>')
+    main(sys.argv[1])
@@ -52,6 +52,23 @@ typedef struct _PES_ {
                                                             from an address specified by the application */
 #define CMD_JUMP                           ((uint8_t)0x03) /* Jumps to user application code located
                                                                  in the internal Flash memory or in SRAM */
+
+#if defined ( STM32F40_41xxx )
+#define configIAP_PAYLOAD_PROGRAM 1 /*erase and program only the payload, read it in sector aligned blocks and check the flash with the CRC unit*/
+#else
+#define configIAP_PAYLOAD_PROGRAM 0
+#endif
+
+#if defined ( EXT_FLASH )
+#define configIAP_EXT_FLASH_SECTOR_UPDATE 1 /*no chip erase: each SPI flash sector is compared with the payload, skipped if equal and erased just before it is written*/
+#else
+#define configIAP_EXT_FLASH_SECTOR_UPDATE 0
+#endif
+
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+#define IAP_READ_BLOCK_SIZE ((uint32_t)0x4000) /* 16 Kbytes per f_read, one MSC command per cluster run */
+#define IAP_READ_ALIGN      ((uint32_t)_MAX_SS)
+#endif
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */ 
 int COMMAND_IAPExecuteApplication(void);
@@ -58,6 +58,14 @@ extern USB_OTG_CORE_HANDLE          USB_OTG_Core;   //Jerry add
 extern uint8_t CMD_index;
 extern uint8_t joystick_use;
 static uint8_t RAM_Buf[PAGE_SIZE] = {0xFF};
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+/*the tail bytes of a block that do not fill a flash word are carried to the front of the next one;
+  word aligned for the flash and CRC word accesses*/
+#if defined ( __ICCARM__ ) /*!< IAR Compiler */
+  #pragma data_alignment=4   
+#endif
+static uint8_t RAM_Block[IAP_READ_BLOCK_SIZE + 4];
+#endif
 
 FIL filefatfs;
 PES *pPES;
@@ -81,6 +89,12 @@ static uint32_t mReadBinSize = 0;
 FRESULT COMMAND_isCorrectPES(void);
 FRESULT COMMAND_checkProjectID(void);
 FRESULT COMMAND_ProgramFlash(void);
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+static FRESULT COMMAND_ReadPayload(uint8_t *pBuf, uint32_t Remain, uint32_t *pReadSize);
+#endif
+#if ( configIAP_EXT_FLASH_SECTOR_UPDATE == 1 )
+static FRESULT COMMAND_UpdateExtFlashSector(uint32_t SectorAddr, uint32_t Size);
+#endif
 
 //________________________________________________________________________________________
 /**
@@ -402,18 +416,114 @@ void COMMAND_DOWNLOAD(void)
 }
 
 #if defined ( EXT_FLASH )
+#if ( configIAP_EXT_FLASH_SECTOR_UPDATE == 1 )
+#define EXT_FLASH_COMPARE_SIZE 256
+
+/**
+  * @brief  Brings one SPI flash sector to the payload at the file pointer.
+  *         The sector is read back first: an identical sector is left alone,
+  *         a blank one is programmed without erase and only a changed one is
+  *         erased, right before it is written. An interrupted update therefore
+  *         leaves every other sector intact and a retry only rewrites what
+  *         still differs.
+  * @param  SectorAddr: first address of the sector.
+  * @param  Size: payload bytes for this sector, up to sFLASH_SECTOR_SIZE.
+  * @retval FR_OK, or FR_DISK_ERR when the file or the flash fails.
+  */
+static FRESULT COMMAND_UpdateExtFlashSector(uint32_t SectorAddr, uint32_t Size)
+{
+    uint8_t flash_buf[EXT_FLASH_COMPARE_SIZE];
+    uint32_t file_pos = filefatfs.fptr;
+    uint32_t address;
+    uint32_t offset;
+    uint32_t read_size = 0;
+    uint32_t len, i, j;
+    bool bIsSame = TRUE;
+    bool bIsBlank = TRUE;
+    FRESULT res;
+
+    for ( offset = 0; (offset < Size) && (bIsSame || bIsBlank); offset += read_size )
+    {
+        len = ( (Size - offset) > PAGE_SIZE ) ? PAGE_SIZE : (Size - offset);
+        res = f_read(&filefatfs, RAM_Buf, len, (void *)&read_size);
+        if ( (res != FR_OK) || (read_size != len) )
+        {
+            return FR_DISK_ERR;
+        }
+
+        for ( i = 0; (i < read_size) && (bIsSame || bIsBlank); i += EXT_FLASH_COMPARE_SIZE )
+        {
+            len = ( (read_size - i) > EXT_FLASH_COMPARE_SIZE ) ? EXT_FLASH_COMPARE_SIZE : (read_size - i);
+            if ( sFLASH_ReadBuffer(flash_buf, (SectorAddr + offset + i), len) == FALSE )
+            {
+                return FR_DISK_ERR;
+            }
+
+            for ( j = 0; j < len; j++ )
+            {
+                if ( flash_buf[j] != RAM_Buf[i+j] )
+                {
+                    bIsSame = FALSE;
+                }
+
+                if ( flash_buf[j] != 0xFF )
+                {
+                    bIsBlank = FALSE;
+                }
+            }
+        }
+    }
+
+    if ( bIsSame )
+    {
+        return FR_OK;
+    }
+
+    if ( bIsBlank == FALSE )
+    {
+        sFLASH_EraseSector(SectorAddr);
+    }
+
+    res = f_lseek(&filefatfs, file_pos);
+    if ( res != FR_OK )
+    {
+        return FR_DISK_ERR;
+    }
+
+    address = SectorAddr;
+    for ( offset = 0; offset < Size; offset += read_size )
+    {
+        len = ( (Size - offset) > PAGE_SIZE ) ? PAGE_SIZE : (Size - offset);
+        res = f_read(&filefatfs, RAM_Buf, len, (void *)&read_size);
+        if ( (res != FR_OK) || (read_size != len) )
+        {
+            return FR_DISK_ERR;
+        }
+
+        if ( sFLASH_WriteBuffer(RAM_Buf, &address, read_size ) == FALSE )
+        {
+            return FR_DISK_ERR;
+        }
+    }
+
+    return FR_OK;
+}
+#endif
+
 FRESULT COMMAND_ProgramExtFlashMemory( void )
 {
     uint32_t address = 0;
     uint32_t read_size = 0x00;
+#if ( configIAP_EXT_FLASH_SECTOR_UPDATE == 0 )
     uint32_t page_num = 0;
    	uint32_t insufficient_page = 0;
 	uint32_t i = 0;
+#endif
     FRESULT res;
     uint32_t extflashPaySize = 0;
     
     
-    if ( ( mPayloadSize - (FLASH_SIZE-IAP_SIZE) ) > EXT_FLASH_ENDADDRESS )
+    if ( ( mPayloadSize - (FLASH_SIZE-IAP_SIZE) ) > ( sFLASH_USB_INDEX_ADDR - EXT_FLASH_STARTADDRESS ) )
     {
         return FR_INVALID_OBJECT; 
     }
@@ -425,9 +535,13 @@ FRESULT COMMAND_ProgramExtFlashMemory( void )
 
     extflashPaySize = mPayloadSize - (FLASH_SIZE-IAP_SIZE);
 
+#if ( configIAP_EXT_FLASH_SECTOR_UPDATE == 1 )
+    HT68F30_LightBar_EraseExtFlash( );
+#else
      /*chip earse*/
     sFLASH_EraseChip( );
     HT68F30_LightBar_EraseExtFlash( );
+#endif
 
     mSeekPointer = (mSeekPointer+(FLASH_SIZE-IAP_SIZE));
     mDebugTrace = mSeekPointer;
@@ -438,6 +552,19 @@ FRESULT COMMAND_ProgramExtFlashMemory( void )
         return FR_DISK_ERR; 
     }
 
+#if ( configIAP_EXT_FLASH_SECTOR_UPDATE == 1 )
+    for ( address = 0; address < extflashPaySize; address += sFLASH_SECTOR_SIZE )
+    {
+        read_size = ( (extflashPaySize - address) > sFLASH_SECTOR_SIZE ) ? sFLASH_SECTOR_SIZE : (extflashPaySize - address);
+        mDebugTrace = address;
+
+        res = COMMAND_UpdateExtFlashSector(address, read_size);
+        if ( res != FR_OK )
+        {
+            return res;
+        }
+    }
+#else
 
 	page_num = (extflashPaySize/PAGE_SIZE);
 	mDebugTrace = page_num;
@@ -448,7 +575,10 @@ FRESULT COMMAND_ProgramExtFlashMemory( void )
 			res = f_read(&filefatfs, RAM_Buf, PAGE_SIZE, (void *)&read_size);
 			if((read_size != 0) && (res == FR_OK)) 
 			{
-                sFLASH_WriteBuffer(RAM_Buf, &address, read_size );
+                if ( sFLASH_WriteBuffer(RAM_Buf, &address, read_size ) == FALSE )
+                {
+                    return FR_DISK_ERR;
+                }
 			}
            
 		}
@@ -463,9 +593,13 @@ FRESULT COMMAND_ProgramExtFlashMemory( void )
 		mDebugTrace = read_size;
 		if((read_size != 0) && (res == FR_OK)) 
 		{
-            sFLASH_WriteBuffer(RAM_Buf, &address, read_size );
+            if ( sFLASH_WriteBuffer(RAM_Buf, &address, read_size ) == FALSE )
+            {
+                return FR_DISK_ERR;
+            }
 		}
 	}
+#endif
 
     HT68F30_LightBar_ProgramExtFlash( );
 
@@ -643,14 +777,34 @@ FRESULT COMMAND_isCorrectPES(void)
 
 bool COMMAND_isCorrectCheckSum(uint8_t CheckSum)
 {
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+       uint32_t read_size = 0x00, remain = mPayloadSize;
+       uint32_t j;
+#else
        uint32_t read_size = 0x00,page_num = 0,insufficient_page = 0;
        uint32_t i ,j;
+#endif
        FRESULT res;
 
 
    /********************************************************
                 	Calcuation CheckSum
     *********************************************************/
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+    while ( remain != 0 )
+    {
+        res = COMMAND_ReadPayload(RAM_Block, remain, &read_size);
+        if ( res != FR_OK )
+            return FALSE;
+
+        for ( j = 0; j < read_size; j++ )
+        {
+            calCheckSum = calCheckSum ^ RAM_Block[j];
+        }
+
+        remain -= read_size;
+    }
+#else
 	page_num = mPayloadSize/PAGE_SIZE;
 	if ( page_num != 0 )
 	{
@@ -679,6 +833,7 @@ bool COMMAND_isCorrectCheckSum(uint8_t CheckSum)
             calCheckSum = calCheckSum ^ RAM_Buf[j];
         }
     }
+#endif
     
     /********************************************************
                      	Compare CheckSum
@@ -786,7 +941,11 @@ FRESULT COMMAND_EraseInternalFlash(void)
 #endif
 
 #if defined ( STM32F40_41xxx )
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+FRESULT COMMAND_EraseInternalFlash(uint32_t EndAddress)
+#else
 FRESULT COMMAND_EraseInternalFlash(void)
+#endif
 {
     __IO uint32_t erase_address = 0x00;
 
@@ -799,7 +958,12 @@ FRESULT COMMAND_EraseInternalFlash(void)
 
     /* Get the number of the start and end sectors */
     uwStartSector = FLASH_LAYER_GetSector(APPLICATIONADDRESS);
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+    /*Only the sectors the image reaches; EndAddress is exclusive*/
+    uwEndSector = FLASH_LAYER_GetSector(EndAddress - 1);
+#else
     uwEndSector = FLASH_LAYER_GetSector(FLASH_ENDADDRESS);
+#endif
 
     /* Strat the erase operation */
     uwSectorCounter = uwStartSector;
@@ -847,6 +1011,162 @@ FRESULT COMMAND_EraseInternalFlash(void)
 }
 #endif
 
+#if ( configIAP_PAYLOAD_PROGRAM == 1 )
+/**
+  * @brief  Reads the next payload bytes from the current file position.
+  *         The read ends on an IAP_READ_ALIGN boundary so that, after the first
+  *         block, f_read hands whole sectors straight to disk_read instead of
+  *         going through the FIL sector buffer.
+  * @param  pBuf: destination
+  * @param  Remain: payload bytes left
+  * @param  pReadSize: bytes read, never 0 on FR_OK
+  * @retval FR_OK or FR_DISK_ERR
+  */
+static FRESULT COMMAND_ReadPayload(uint8_t *pBuf, uint32_t Remain, uint32_t *pReadSize)
+{
+    FRESULT res;
+    uint32_t want = IAP_READ_BLOCK_SIZE - (filefatfs.fptr % IAP_READ_ALIGN);
+
+    if ( want > Remain )
+        want = Remain;
+
+    res = f_read(&filefatfs, pBuf, want, (void *)pReadSize);
+    if ( ( res != FR_OK ) || ( *pReadSize != want ) )
+        return FR_DISK_ERR;
+
+    return FR_OK;
+}
+
+FRESULT COMMAND_ProgramFlash(void)
+{
+    uint32_t read_size = 0x00;
+    uint32_t image_size = 0;
+    uint32_t remain = 0;
+    uint32_t carry = 0;
+    uint32_t program_size = 0;
+    uint32_t image_crc = 0;
+    uint32_t i = 0;
+
+    FRESULT res;
+    FLASH_Status flash_status = FLASH_COMPLETE;
+    uint8_t BlinkingCnt = 0;
+	bool bInvert = FALSE;
+
+
+	res = f_open(&filefatfs, UPGRAGE_FILE, FA_OPEN_EXISTING | FA_READ);
+	if ( res != FR_OK )
+		return FR_DISK_ERR;
+
+    /*The internal image is the payload itself, or its first (FLASH_SIZE-IAP_SIZE) bytes when the rest goes to the external flash*/
+    image_size = mPayloadSize;
+    if ( image_size > (FLASH_SIZE-IAP_SIZE) )
+    {
+        image_size = (FLASH_SIZE-IAP_SIZE);
+    }
+    mDebugTrace = image_size;
+
+    res = COMMAND_EraseInternalFlash(APPLICATIONADDRESS + ((image_size + 3) & ~3));
+    if ( res != FR_OK )
+        return res;
+
+    res = f_lseek(&filefatfs, mSeekPointer);
+    if ( res != FR_OK )
+        return FR_DISK_ERR; 
+
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_CRC, ENABLE);
+    CRC_ResetDR();
+    
+    /* Erase address init */
+    Last_PGAddress = APPLICATIONADDRESS;
+
+    remain = image_size;
+    while ( remain != 0 )
+    {
+        res = COMMAND_ReadPayload(&RAM_Block[carry], remain, &read_size);
+        if ( res != FR_OK )
+            return res;
+
+        remain -= read_size;
+        program_size = carry + read_size;
+
+        if ( remain != 0 )
+        {
+            /*keep the flash words aligned with the payload; the odd bytes wait for the next block*/
+            carry = program_size & 3;
+            program_size -= carry;
+        }
+        else
+        {
+            /*pad the last word as erased flash*/
+            carry = 0;
+            while ( program_size & 3 )
+            {
+                RAM_Block[program_size++] = 0xFF;
+            }
+        }
+
+        image_crc = CRC_CalcBlockCRC((uint32_t *)RAM_Block, program_size/4);
+
+        flash_status = FLASH_LAYER_write_n_word(&Last_PGAddress, RAM_Block, program_size);
+        if ( flash_status != FLASH_COMPLETE )
+        {
+            f_close(&filefatfs);
+            f_mount(0, NULL); 
+            
+            while (1)
+            {
+                while ( BlinkingCnt <= 20)
+                {
+                    bInvert = ! bInvert;
+
+                    HT68F30_LightBar_USB_StateError( bInvert );
+
+                    /* 0.1 seconds delay */
+                    USB_OTG_BSP_mDelay(100);
+
+                    BlinkingCnt ++;
+                }
+                BlinkingCnt = 0;
+            }
+        }
+
+        for ( i = 0; i < carry; i++ )
+        {
+            RAM_Block[i] = RAM_Block[program_size + i];
+        }
+    }
+
+    /*Verify the programmed words against the CRC of the file data instead of reading back the whole application area;
+      the ART data cache may still hold the old image*/
+    FLASH_DataCacheCmd(DISABLE);
+    FLASH_DataCacheReset();
+    FLASH_DataCacheCmd(ENABLE);
+
+    CRC_ResetDR();
+    if ( CRC_CalcBlockCRC((uint32_t *)APPLICATIONADDRESS, (Last_PGAddress - APPLICATIONADDRESS)/4) != image_crc )
+    {
+        while ( BlinkingCnt <= 20)
+        {
+            bInvert = ! bInvert;
+
+            HT68F30_LightBar_USB_StateError( bInvert );
+
+            /* 0.1 seconds delay */
+            USB_OTG_BSP_mDelay(100);
+
+            BlinkingCnt ++;
+        }
+        BlinkingCnt = 0;
+
+        return FR_DISK_ERR;
+    }
+
+     HT68F30_LightBar_USB_isUpgrading();
+
+	return res;
+    
+}
+#else
 FRESULT COMMAND_ProgramFlash(void)
 {
     uint32_t read_size = 0x00;
@@ -966,6 +1286,7 @@ FRESULT COMMAND_ProgramFlash(void)
 	return res;
     
 }
+#endif
 
 /**
   * @brief  COMMAND_IAPExecuteApplication
@@ -86,7 +86,11 @@
 */
 
 
+#if defined ( S4051A ) && !defined ( STM32_IAP )
+#define	_USE_LFN	1	/* USB wave search of the app, ff_convert() and ff_wtoupper() from option/ccsbcs.c */
+#else
 #define	_USE_LFN	0	/* 0, 1 or 2 */
+#endif
 #define	_MAX_LFN	255		/* Maximum LFN length to handle (12 to 255) */
 /* The _USE_LFN option switches the LFN support.
 /
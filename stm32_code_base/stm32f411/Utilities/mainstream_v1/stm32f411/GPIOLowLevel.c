@@ -25,6 +25,7 @@
 
 #if ( configSII_DEV_953x_PORTING == 1 )
 #include "si_platform.h"
+#include "HdmiDeviceManager.h"
 #endif
 
 #endif
@@ -35,6 +36,10 @@
 #define GPIOLowLevel_CS8422_ISR EXTI9_5_IRQHandler
 #endif
 
+#if ( configCS4953x_IRQ_ISR == 1 ) && !defined ( STM32_IAP )
+#define GPIOLowLevel_CS4953x_ISR EXTI2_IRQHandler
+#endif
+
 #if ( configSII_DEV953x_PORTING_PLATFORM_STM32F105 == 1 ) && ( configSIL953x_ISR == 1)
 #define SIL953x_INT_LINE EXTI_Line3
 #define SIL953x_IRQ EXTI3_IRQn
@@ -129,6 +134,10 @@ static void GPIOLowLevel_CS8422_ISR_Control( bool bIsrEnable );
 extern SRC_ISR_OBJECT *pSRCIsr_ObjCtrl;
 #endif
 
+#if ( configCS4953x_IRQ_ISR == 1 ) && !defined ( STM32_IAP )
+extern void cs49844_FchDetector_IrqFromISR( void );
+#endif
+
 const GPIO_ISR_OBJECT GPIOLOWLevelIsr_ObjCtrl = 
 {
     GPIOLowLevel_CS8422_ISR_Configure,
@@ -462,6 +471,9 @@ void GPIOLowLevel_SIL9533_ISR ( void )
     {
         SiiPlatformInterruptHandler();
         EXTI_ClearITPendingBit(SIL953x_INT_LINE);
+#if ( configSII953x_INT_WAKEUP == 1 )
+        HdmiDeviceManager_RepeaterWakeupFromISR();
+#endif
     }
 #endif 
 }
@@ -500,5 +512,40 @@ void GPIOLowLevel_SIL9533_ISR_Configure( void )
 }
 #endif
 
+#if ( configCS4953x_IRQ_ISR == 1 ) && !defined ( STM32_IAP )
+void GPIOLowLevel_CS4953x_ISR( void )
+{
+    if ( EXTI_GetITStatus( EXTI_Line2 ) != RESET )
+    {
+        EXTI_ClearITPendingBit(EXTI_Line2);
+        cs49844_FchDetector_IrqFromISR( );
+    }
+}
+
+void GPIOLowLevel_CS4953x_ISR_Configure( void )
+{
+    EXTI_InitTypeDef   EXTI_InitStructure;
+    NVIC_InitTypeDef   NVIC_InitStructure;
+
+    /* PC.02 (__I_SCP1_IRQ) is already an input from PhysicalPins */
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_SYSCFG, ENABLE);
+
+    SYSCFG_EXTILineConfig(EXTI_PortSourceGPIOC, EXTI_PinSource2);
+
+    /* the DSP pulls IRQ low while an unsolicited message is waiting */
+    EXTI_InitStructure.EXTI_Line = EXTI_Line2;
+    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Falling;
+    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&EXTI_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannel = EXTI2_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIB_CS4953x_INTERRUPT_PRIORITY;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+#endif
+
 #endif //! (__ARM_CORTEX_MX__) @}
 
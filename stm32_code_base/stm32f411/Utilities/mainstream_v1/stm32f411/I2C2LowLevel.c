@@ -30,6 +30,18 @@
 
 #define I2C_INTERVAL_TIME	5
 
+#if ( configI2C2_SCRIPT == 1 )
+#define sEE_I2C2_EV_IRQn                  I2C3_EV_IRQn
+#define sEE_I2C2_EV_IRQHandler            I2C3_EV_IRQHandler
+#define sEE_I2C2_ER_IRQn                  I2C3_ER_IRQn
+#define sEE_I2C2_ER_IRQHandler            I2C3_ER_IRQHandler
+#define sEE_I2C2_ERROR_FLAGS              (I2C_FLAG_AF | I2C_FLAG_BERR | I2C_FLAG_ARLO | I2C_FLAG_OVR)
+
+#define I2C2_SCRIPT_RETRY        3
+#define I2C2_SCRIPT_MAX_WRITE    32  /*register + data bytes of one WRITE entry*/
+#define I2C2_SCRIPT_ENTRY_TIME   10  /*msec allowed for one transaction before the script is aborted*/
+#endif
+
 //_______________________________________________________________________________________________________________________
 
 typedef FlagStatus ( *i2c_get_flag_status )( I2C_TypeDef* I2Cx, uint32_t I2C_FLAG );
@@ -38,6 +50,42 @@ typedef ErrorStatus ( *i2c_check_event ) ( I2C_TypeDef* I2Cx, uint32_t I2C_EVENT
 
 //_______________________________________________________________________________________________________________________
 static bool bIsI2C2_enable = FALSE;
+
+#if ( configI2C2_SCRIPT == 1 )
+typedef enum
+{
+    SCRIPT_IDLE,
+    SCRIPT_NEXT,        /*start the current entry, the event irq has been pended*/
+    SCRIPT_SB,          /*START sent*/
+    SCRIPT_ADDR,        /*slave address sent*/
+    SCRIPT_TXE,         /*TXE irq feeds register and data, DMA1 Stream4 belongs to the I2S2 output*/
+    SCRIPT_BTF,         /*wait the last byte on the bus*/
+    SCRIPT_RXNE,        /*UPDATE: wait the register value*/
+    SCRIPT_DELAY        /*DELAY entry, the timer pends the event irq*/
+} I2C2_SCRIPT_STATE;
+
+static struct
+{
+    volatile uint8 state;
+    bool reading;       /*UPDATE read phase*/
+    bool regSent;       /*UPDATE: register sent, repeated START for the read*/
+    uint8 retry;
+    byte device;
+    const I2C2_SCRIPT_ENTRY *script;
+    uint16 count;
+    uint16 index;
+    I2C2_SCRIPT_DONE done;
+    void *arg;
+    uint8 txLength;
+    uint8 txIndex;
+    byte tx[I2C2_SCRIPT_MAX_WRITE];
+} m_script;
+
+static xTimerHandle m_scriptTimer = NULL;
+static xSemaphoreHandle m_scriptDone = NULL;
+static bool m_scriptResult;
+static portBASE_TYPE m_scriptWoken;
+#endif
 //_______________________________________________________________________________________________________________________
 static void sEE_Init2(void);
 
@@ -530,9 +578,377 @@ static void sEE_Init2(void)
 
 }
 
+#if ( configI2C2_SCRIPT == 1 )
+static void I2C2_Script_finish( bool result )
+{
+    I2C_ITConfig(sEE_I2C2, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+    m_script.state = SCRIPT_IDLE;
+
+    if ( m_script.done != NULL )
+    {
+        m_script.done( m_script.arg, result, &m_scriptWoken );
+    }
+}
+
+static void I2C2_Script_start( void )
+{
+    uint32_t timeout = sEE_FLAG_TIMEOUT;
+
+    /*The STOP of the previous transaction is still on the bus for one bit time*/
+    while( ( sEE_I2C2->CR1 & I2C_CR1_STOP ) && ( timeout-- > 0 ) );
+
+    m_script.state = SCRIPT_SB;
+    I2C_GenerateSTART(sEE_I2C2, ENABLE);
+}
+
+static void I2C2_Script_next( void )
+{
+    const I2C2_SCRIPT_ENTRY *entry;
+
+    if ( m_script.index >= m_script.count )
+    {
+        I2C2_Script_finish( TRUE );
+        return;
+    }
+
+    entry = &m_script.script[m_script.index];
+
+    switch( entry->op )
+    {
+        case I2C2_SCRIPT_OP_DELAY:
+        {
+            /*one more tick, the first one is already running*/
+            m_script.state = SCRIPT_DELAY;
+            xTimerChangePeriodFromISR( m_scriptTimer, TASK_MSEC2TICKS(entry->value) + 1, &m_scriptWoken );
+        }
+            break;
+
+        case I2C2_SCRIPT_OP_UPDATE:
+        {
+            m_script.reading = TRUE;
+            m_script.regSent = FALSE;
+            I2C2_Script_start( );
+        }
+            break;
+
+        default:
+        {
+            m_script.reading = FALSE;
+            m_script.tx[0] = entry->reg;
+            if ( entry->data == NULL )
+            {
+                m_script.tx[1] = entry->value;
+                m_script.txLength = 2;
+            }
+            else
+            {
+                m_script.txLength = MINIMUM( entry->length, ( I2C2_SCRIPT_MAX_WRITE - 1 ) ) + 1;
+                MEMCPY( &m_script.tx[1], entry->data, ( m_script.txLength - 1 ) );
+            }
+            I2C2_Script_start( );
+        }
+            break;
+    }
+}
+
+static void I2C2_Script_error( void )
+{
+    I2C_ITConfig(sEE_I2C2, I2C_IT_BUF, DISABLE);
+    I2C_AcknowledgeConfig(sEE_I2C2, ENABLE);
+    I2C_GenerateSTOP(sEE_I2C2, ENABLE);
+
+    if ( m_script.state == SCRIPT_IDLE )
+    {
+        return;
+    }
+
+    m_script.retry++;
+    if ( m_script.retry < I2C2_SCRIPT_RETRY )
+    {
+        /*the whole entry again, an UPDATE reads the register again*/
+        I2C2_Script_next( );
+    }
+    else
+    {
+        I2C2_Script_finish( FALSE );
+    }
+}
+
+static void I2C2_Script_timer( xTimerHandle xTimer )
+{
+    if ( m_script.state == SCRIPT_DELAY )
+    {
+        m_script.index++;
+        m_script.state = SCRIPT_NEXT;
+        NVIC_SetPendingIRQ( sEE_I2C2_EV_IRQn );
+    }
+}
+
+static void I2C2_Script_wakeup( void *arg, bool result, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    m_scriptResult = result;
+    xSemaphoreGiveFromISR( m_scriptDone, pxHigherPriorityTaskWoken );
+}
+
+void sEE_I2C2_EV_IRQHandler( void )
+{
+    uint16 sr1 = sEE_I2C2->SR1;
+    byte value;
+
+    m_scriptWoken = pdFALSE;
+
+    switch( m_script.state )
+    {
+        case SCRIPT_NEXT:
+        {
+            I2C2_Script_next( );
+        }
+            break;
+
+        case SCRIPT_SB:
+        {
+            if ( sr1 & I2C_SR1_SB )
+            {
+                m_script.state = SCRIPT_ADDR;
+                I2C_Send7bitAddress(sEE_I2C2, m_script.device, 
+                                    ( m_script.reading && m_script.regSent ) ? I2C_Direction_Receiver : I2C_Direction_Transmitter);
+            }
+        }
+            break;
+
+        case SCRIPT_ADDR:
+        {
+            if ( ( sr1 & I2C_SR1_ADDR ) == 0 )
+            {
+                break;
+            }
+
+            if ( m_script.reading == FALSE )
+            {
+                (void)sEE_I2C2->SR2;
+
+                m_script.state = SCRIPT_TXE;
+                m_script.txIndex = 0;
+                I2C_SendData(sEE_I2C2, m_script.tx[m_script.txIndex++]);
+                I2C_ITConfig(sEE_I2C2, I2C_IT_BUF, ENABLE);
+            }
+            else if ( m_script.regSent == FALSE )
+            {
+                (void)sEE_I2C2->SR2;
+
+                m_script.state = SCRIPT_BTF;
+                m_script.regSent = TRUE;
+                I2C_SendData(sEE_I2C2, m_script.script[m_script.index].reg);
+            }
+            else
+            {
+                /*Single byte read: NACK and STOP are set before ADDR is cleared*/
+                I2C_AcknowledgeConfig(sEE_I2C2, DISABLE);
+                (void)sEE_I2C2->SR2;
+                I2C_GenerateSTOP(sEE_I2C2, ENABLE);
+
+                m_script.state = SCRIPT_RXNE;
+                I2C_ITConfig(sEE_I2C2, I2C_IT_BUF, ENABLE);
+            }
+        }
+            break;
+
+        case SCRIPT_TXE:
+        {
+            if ( ( sr1 & I2C_SR1_TXE ) == 0 )
+            {
+                break;
+            }
+
+            if ( m_script.txIndex < m_script.txLength )
+            {
+                I2C_SendData(sEE_I2C2, m_script.tx[m_script.txIndex++]);
+            }
+            else
+            {
+                /*The last byte is in the shift register, STOP is sent on BTF*/
+                I2C_ITConfig(sEE_I2C2, I2C_IT_BUF, DISABLE);
+                m_script.state = SCRIPT_BTF;
+            }
+        }
+            break;
+
+        case SCRIPT_BTF:
+        {
+            if ( ( sr1 & I2C_SR1_BTF ) == 0 )
+            {
+                break;
+            }
+
+            if ( m_script.reading == TRUE )
+            {
+                /*register address is out, repeated START for the read*/
+                m_script.state = SCRIPT_SB;
+                I2C_GenerateSTART(sEE_I2C2, ENABLE);
+            }
+            else
+            {
+                I2C_GenerateSTOP(sEE_I2C2, ENABLE);
+
+                m_script.index++;
+                m_script.retry = 0;
+                I2C2_Script_next( );
+            }
+        }
+            break;
+
+        case SCRIPT_RXNE:
+        {
+            if ( ( sr1 & I2C_SR1_RXNE ) == 0 )
+            {
+                break;
+            }
+
+            value = I2C_ReceiveData(sEE_I2C2);
+            I2C_ITConfig(sEE_I2C2, I2C_IT_BUF, DISABLE);
+            I2C_AcknowledgeConfig(sEE_I2C2, ENABLE);
+
+            /*write the merged value back with the same entry*/
+            m_script.reading = FALSE;
+            m_script.tx[0] = m_script.script[m_script.index].reg;
+            m_script.tx[1] = ( value & ~m_script.script[m_script.index].mask ) 
+                | ( m_script.script[m_script.index].value & m_script.script[m_script.index].mask );
+            m_script.txLength = 2;
+            I2C2_Script_start( );
+        }
+            break;
+
+        default:
+            break;
+    }
+
+    portEND_SWITCHING_ISR( m_scriptWoken );
+}
+
+void sEE_I2C2_ER_IRQHandler( void )
+{
+    m_scriptWoken = pdFALSE;
+
+    I2C_ClearFlag(sEE_I2C2, sEE_I2C2_ERROR_FLAGS);
+    I2C2_Script_error( );
+
+    portEND_SWITCHING_ISR( m_scriptWoken );
+}
+
+static void I2C2_Script_initialize( void )
+{
+    NVIC_InitTypeDef NVIC_InitStructure;  
+
+    if ( m_scriptTimer == NULL )
+    {
+        m_scriptTimer = xTimerCreate( ( const signed char * ) "i2c2_script", 1, pdFALSE, NULL, I2C2_Script_timer );
+        vSemaphoreCreateBinary( m_scriptDone );
+        xSemaphoreTake( m_scriptDone, 0 );
+    }
+
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIB_I2C_DMA_INTERRUPT_PRIORITY;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+
+    NVIC_InitStructure.NVIC_IRQChannel = sEE_I2C2_EV_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannel = sEE_I2C2_ER_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+    m_script.state = SCRIPT_IDLE;
+}
+
+static void I2C2_Script_abort( void )
+{
+    taskENTER_CRITICAL();
+    I2C_ITConfig(sEE_I2C2, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+    m_script.state = SCRIPT_IDLE;
+    taskEXIT_CRITICAL();
+
+    xTimerStop( m_scriptTimer, 0 );
+
+    /*Bus reset, the same as a timeout of the polled transfers*/
+    sEE_TIMEOUT_UserCallback2( m_script.device );
+}
+
+bool I2C2_startScript( byte device, const I2C2_SCRIPT_ENTRY *script, uint16 count, I2C2_SCRIPT_DONE done, void *arg )
+{
+    if ( ( bIsI2C2_enable != TRUE ) || ( m_scriptTimer == NULL ) || ( script == NULL ) || ( count == 0 ) )
+    {
+        return FALSE;
+    }
+
+    taskENTER_CRITICAL();
+    if ( m_script.state != SCRIPT_IDLE )
+    {
+        taskEXIT_CRITICAL();
+        return FALSE;
+    }
+
+    m_script.device = device;
+    m_script.script = script;
+    m_script.count = count;
+    m_script.index = 0;
+    m_script.retry = 0;
+    m_script.done = done;
+    m_script.arg = arg;
+    m_script.state = SCRIPT_NEXT;
+    taskEXIT_CRITICAL();
+
+    I2C_ClearFlag(sEE_I2C2, sEE_I2C2_ERROR_FLAGS);
+    I2C_ITConfig(sEE_I2C2, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+
+    /*The whole script runs in irq context, the first entry too*/
+    NVIC_SetPendingIRQ( sEE_I2C2_EV_IRQn );
+
+    return TRUE;
+}
+
+bool I2C2_runScript( byte device, const I2C2_SCRIPT_ENTRY *script, uint16 count )
+{
+    uint32 timeout = 0;
+    uint16 i;
+
+    if ( m_scriptDone == NULL )
+    {
+        return FALSE;
+    }
+
+    for ( i = 0; i < count; i++ )
+    {
+        timeout += ( script[i].op == I2C2_SCRIPT_OP_DELAY ) ? script[i].value : ( I2C2_SCRIPT_ENTRY_TIME*I2C2_SCRIPT_RETRY );
+    }
+
+    xSemaphoreTake( m_scriptDone, 0 );
+
+    if ( I2C2_startScript( device, script, count, I2C2_Script_wakeup, NULL ) == FALSE )
+    {
+        TRACE_ERROR((0, "Device Address 0x%X I2C script can not start !!", device));
+        return FALSE;
+    }
+
+    if ( xSemaphoreTake( m_scriptDone, TASK_MSEC2TICKS(timeout) ) != pdTRUE )
+    {
+        I2C2_Script_abort( );
+        return FALSE;
+    }
+
+    if ( m_scriptResult == FALSE )
+    {
+        TRACE_ERROR((0, "Device Address 0x%X I2C script stopped at entry %d !!", device, m_script.index));
+    }
+
+    return m_scriptResult;
+}
+#endif
+
 void TWI2_initialize( void )
 {
        sEE_Init2();
+#if ( configI2C2_SCRIPT == 1 )
+       I2C2_Script_initialize( );
+#endif
        bIsI2C2_enable = TRUE;
 }
 
@@ -2,6 +2,43 @@
 #define __I2C2_LOW_LEVEL_H__
 
 #include "Defs.h"
+#include "device_config.h"
+
+#if ( configI2C2_SCRIPT == 1 )
+#include "freertos_conf.h"
+
+/* Register script, run from the I2C event and DMA interrupts.
+ * WRITE  : reg followed by length bytes from data, or by value if data is NULL
+ * UPDATE : read reg, replace the bits in mask by value, write it back
+ * DELAY  : wait value msec before the next entry
+ * A NACKed transaction is retried, then the script stops with FALSE. */
+typedef enum
+{
+    I2C2_SCRIPT_OP_WRITE,
+    I2C2_SCRIPT_OP_UPDATE,
+    I2C2_SCRIPT_OP_DELAY
+} I2C2_SCRIPT_OP;
+
+typedef struct
+{
+    uint8 op;
+    uint8 reg;
+    uint8 value;
+    uint8 mask;
+    uint8 length;
+    const byte *data;
+} I2C2_SCRIPT_ENTRY;
+
+#define I2C2_SCRIPT_WRITE( reg, value )         { I2C2_SCRIPT_OP_WRITE, (reg), (value), 0, 1, NULL }
+#define I2C2_SCRIPT_WRITE_N( reg, data )        { I2C2_SCRIPT_OP_WRITE, (reg), 0, 0, sizeof(data), (data) }
+#define I2C2_SCRIPT_UPDATE( reg, mask, value )  { I2C2_SCRIPT_OP_UPDATE, (reg), (value), (mask), 1, NULL }
+#define I2C2_SCRIPT_DELAY( msec )               { I2C2_SCRIPT_OP_DELAY, 0, (msec), 0, 0, NULL }
+
+#define I2C2_SCRIPT_LENGTH( script ) ( sizeof(script)/sizeof(I2C2_SCRIPT_ENTRY) )
+
+/* Called from the I2C interrupt when the script has ended */
+typedef void ( *I2C2_SCRIPT_DONE )( void *arg, bool result, portBASE_TYPE *pxHigherPriorityTaskWoken );
+#endif
 
 
 /*-------------------------------------------------------------------------------------------------------*/
@@ -15,5 +52,13 @@ void TWI2_initialize( void );
 
 void TWI2_Deinitialize( void );
 
+#if ( configI2C2_SCRIPT == 1 )
+/*Starts the script on the device and returns at once, FALSE if a script is still running*/
+bool I2C2_startScript( byte device, const I2C2_SCRIPT_ENTRY *script, uint16 count, I2C2_SCRIPT_DONE done, void *arg );
+
+/*Runs the script and blocks the calling task until it has ended*/
+bool I2C2_runScript( byte device, const I2C2_SCRIPT_ENTRY *script, uint16 count );
+#endif
+
 
 #endif 
@@ -42,6 +42,9 @@ static uint16 IRLowLevel_getRowData( uint16 *pData );
 
 static void IRLowLevel_clrRowData( void );
 
+#if ( configIR_STREAM_DECODER == 1 )
+static bool IRLowLevel_getEdge( uint16 *pData, uint32 xBlockTime );
+#endif
 
 
 const IR_LOWLEVEL_OBJECT IR_ObjCtrl = 
@@ -49,6 +52,9 @@ const IR_LOWLEVEL_OBJECT IR_ObjCtrl =
     IRLowLevel_getRowData,
     IRLowLevel_getQueueNumber,
     IRLowLevel_clrRowData,
+#if ( configIR_STREAM_DECODER == 1 )
+    IRLowLevel_getEdge,
+#endif
 };
 
 const IR_LOWLEVEL_OBJECT *pIR_LowLevel = &IR_ObjCtrl;
@@ -111,6 +117,27 @@ static uint16 IRLowLevel_getRowData( uint16 *pData )
 
 }
 
+#if ( configIR_STREAM_DECODER == 1 )
+/*Blocks for the next pulse/space duration*/
+static bool IRLowLevel_getEdge( uint16 *pData, uint32 xBlockTime )
+{
+    if ( pData == NULL )
+        return FALSE;
+
+    if ( xOS_InfraredIsr.queue.xQueue == NULL )
+    {
+        vTaskDelay( TASK_MSEC2TICKS(10) );
+        return FALSE;
+    }
+
+    if ( xQueueReceive( xOS_InfraredIsr.queue.xQueue, pData, (portTickType)xBlockTime ) != pdPASS )
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
 
 void IRLowLevel_initialize( void )
 {
@@ -222,8 +249,17 @@ void IRLowLevel_ISR(void)
         }
         else
         {
+#if ( configIR_STREAM_DECODER == 1 )
+            /*the decoder drops any frame in progress*/
+            pluse_duration = IR_EDGE_GAP;
+            if( xOS_InfraredIsr.queue.xQueue != NULL )
+            {
+                xQueueSendFromISR( xOS_InfraredIsr.queue.xQueue, &pluse_duration, &xHigherPriorityTaskWoken );
+            }
+#else
             pluse_duration = 0;
             IRLowLevel_clrRowData();
+#endif
         }
         
     }
@@ -2,16 +2,25 @@
 #define __IR_LOW_LEVEL_H__
 
 #include "Defs.h"
+#include "device_config.h"
 
 #define IR_ROW_DATA_MAX (68)
 #define IR_TIME_BASE 50
 
+#if ( configIR_STREAM_DECODER == 1 )
+#define IR_EDGE_IDLE 0x7FFE /*no edge within the decoder timeout*/
+#define IR_EDGE_GAP 0x7FFF /*space longer than 110 msec, replaces the duration*/
+#endif
+
 
 typedef struct _IR_LOWLEVEL_OBJECT
 {
     uint16 (*get_row_data)( uint16 *pdata );
     uint16 (*get_queue_number )(void );
     void (*clr_rowdata)( void );
+#if ( configIR_STREAM_DECODER == 1 )
+    bool (*get_edge)( uint16 *pdata, uint32 block_ticks );
+#endif
 }IR_LOWLEVEL_OBJECT;
 
 #endif
@@ -141,6 +141,541 @@ static uint32 IRLowLevelDecoder_BitsReverse(uint32 value )
 
 }
 
+#if ( configIR_STREAM_DECODER == 1 )
+//____________________________________________________________________________________________________________
+/*Streaming decoder: every protocol keeps its own state machine and advances on each edge from IRLowLevel.c.
+  A decoder that cannot match drops back to idle at once, the first one that completes a valid frame sends its key.*/
+#define IR_STREAM_IDLE_MSEC 8 /*no edge for this long ends a Sony frame, drops the others*/
+#define IR_STREAM_HOLDOFF_MSEC 110 /*a held key on a frame repeating remote is sent once per window, as the buffered decoder did*/
+#define IR_SHARP_INV_IDLE_MAX ( ( 50/IR_STREAM_IDLE_MSEC ) + 1 )
+
+#define IR_IN_RANGE( x, min, max ) ( ( (x) > (min) ) && ( (x) < (max) ) )
+#define IR_IS_SPACE( x ) ( ( (x) & 0x8000 ) == 0 )
+
+typedef struct IR_STREAM_STATE
+{
+	int8 state;
+	uint8 data_cnt;
+	uint8 idle_cnt;
+	uint8 bit;
+	uint32 payload;
+	uint16 frame;
+	uint8 repeat_type;
+} xIrStreamState;
+
+typedef bool (*IR_STREAM_DECODE)( xIrStreamState *pState, uint16 edge, IR_PROTOCOL_PAYLOAD *pPayload );
+
+/*same priority as the buffered decoder tried the protocols*/
+enum
+{
+	IR_STREAM_NEC = 0,
+	IR_STREAM_SONY,
+	IR_STREAM_SHARP,
+	IR_STREAM_JVC,
+	IR_STREAM_RC5,
+	IR_STREAM_MAX
+};
+
+static xIrStreamState mIrStream[IR_STREAM_MAX];
+static IR_PROTOCOL_PAYLOAD mIrStreamPending;
+static uint8 mIrStreamPendingIdx = IR_STREAM_MAX;
+
+static void IRLowLevelDecoder_StreamReset( xIrStreamState *pState )
+{
+	memset( pState, 0, sizeof(xIrStreamState) );
+}
+
+static bool IRLowLevelDecoder_NEC_Edge( xIrStreamState *pState, uint16 edge, IR_PROTOCOL_PAYLOAD *pPayload )
+{
+	uint8 *pData;
+
+	switch( pState->state )
+	{
+		case 1: /*leader space*/
+		{
+			if ( IR_IN_RANGE( edge, IR_NEC_LEAD_S_MIN, IR_NEC_LEAD_S_MAX ) )
+			{
+				pState->state = 2;
+				return FALSE;
+			}
+			else if ( IR_IN_RANGE( edge, IR_NEC_REPEAT_S_MIN, IR_NEC_REPEAT_S_MAX ) )
+			{
+				IRLowLevelDecoder_StreamReset( pState );
+				pPayload->info.bits.protocol_type = IR_PROTOCOL_38K_NEC;
+				pPayload->info.bits.repeat_type = IR_PROTOCOL_38K_NEC_REPEAT;
+				return TRUE;
+			}
+		}
+			break;
+
+		case 2: /*bit pulse*/
+		{
+			if ( IR_IN_RANGE( edge, IR_NEC_1T_P_MIN, IR_NEC_1T_P_MAX ) )
+			{
+				pState->state = 3;
+				return FALSE;
+			}
+		}
+			break;
+
+		case 3: /*bit space*/
+		{
+			if ( IR_IN_RANGE( edge, IR_NEC_LG1_S_MIN, IR_NEC_LG1_S_MAX ) )
+			{
+				pState->payload <<= 1;
+				pState->payload |= 1;
+			}
+			else if ( IR_IN_RANGE( edge, IR_NEC_LG0_S_MIN, IR_NEC_LG0_S_MAX ) )
+			{
+				pState->payload <<= 1;
+			}
+			else
+			{
+				break;
+			}
+
+			if ( ++pState->data_cnt < 32 )
+			{
+				pState->state = 2;
+				return FALSE;
+			}
+
+			pData = (uint8*)&pState->payload;
+			if( ( ((*(pData+3))) == ( ~(*(pData+2))&0x0ff  ) ) && ( ((*(pData+1))) == ( ~(*(pData+0))&0x0ff  ) ))
+			{
+				pPayload->payload = pState->payload;
+				pPayload->info.bits.protocol_type = IR_PROTOCOL_38K_NEC;
+				IRLowLevelDecoder_StreamReset( pState );
+				return TRUE;
+			}
+		}
+			break;
+
+		default:
+			break;
+	}
+
+	/*not part of a frame, only a leader starts one*/
+	IRLowLevelDecoder_StreamReset( pState );
+	if ( IR_IN_RANGE( edge, IR_NEC_LEAD_P_MIN, IR_NEC_LEAD_P_MAX ) )
+	{
+		pState->state = 1;
+	}
+
+	return FALSE;
+}
+
+static bool IRLowLevelDecoder_SONY_Edge( xIrStreamState *pState, uint16 edge, IR_PROTOCOL_PAYLOAD *pPayload )
+{
+	switch( pState->state )
+	{
+		case 1: /*leader space*/
+		{
+			if ( IR_IN_RANGE( edge, IR_SONY_1T_S_MIN, IR_SONY_1T_S_MAX ) )
+			{
+				pState->state = 2;
+				return FALSE;
+			}
+		}
+			break;
+
+		case 2: /*bit pulse*/
+		{
+			if ( IR_IN_RANGE( edge, IR_SONY_LG1_P_MIN, IR_SONY_LG1_P_MAX ) )
+			{
+				pState->bit = 1;
+				pState->state = 3;
+				return FALSE;
+			}
+			else if ( IR_IN_RANGE( edge, IR_SONY_LG0_P_MIN, IR_SONY_LG0_P_MAX ) )
+			{
+				pState->bit = 0;
+				pState->state = 3;
+				return FALSE;
+			}
+		}
+			break;
+
+		case 3: /*bit space, a longer one (or no edge at all) ends the frame*/
+		{
+			if ( IR_IS_SPACE( edge ) && ( edge > IR_SONY_1T_S_MIN ) )
+			{
+				pState->payload <<= 1;
+				pState->payload |= pState->bit;
+				pState->data_cnt++;
+
+				if ( edge < IR_SONY_1T_S_MAX )
+				{
+					pState->state = 2;
+					return FALSE;
+				}
+
+				if ( pState->data_cnt >= 12 ) /*SIRC 12, 15 or 20 bits*/
+				{
+					pPayload->payload = pState->payload;
+					pPayload->info.bits.protocol_type = IR_PROTOCOL_40K_SONY;
+					IRLowLevelDecoder_StreamReset( pState );
+					return TRUE;
+				}
+			}
+		}
+			break;
+
+		default:
+			break;
+	}
+
+	IRLowLevelDecoder_StreamReset( pState );
+	if ( IR_IN_RANGE( edge, IR_SONY_LEAD_P_MIN, IR_SONY_LEAD_P_MAX ) )
+	{
+		pState->state = 1;
+	}
+
+	return FALSE;
+}
+
+static bool IRLowLevelDecoder_Sharp_Edge( xIrStreamState *pState, uint16 edge, IR_PROTOCOL_PAYLOAD *pPayload )
+{
+	switch( pState->state )
+	{
+		case 2: /*frame 1 bit pulse*/
+		case 3: /*stop pulse*/
+		case 5: /*frame 2 bit pulse*/
+		{
+			if ( IR_IN_RANGE( edge, IR_SHARP_1T_P_MIN, IR_SHARP_1T_P_MAX ) )
+			{
+				pState->state = ( pState->state == 5 ) ? 6 : ( pState->state == 3 ) ? 4 : 1;
+				pState->idle_cnt = 0;
+				return FALSE;
+			}
+		}
+			break;
+
+		case 4: /*about 40 msec before the inverted frame*/
+		{
+			if ( IR_IN_RANGE( edge, IR_SHARP_INV_S_MIN, IR_SHARP_INV_S_MAX ) )
+			{
+				pState->payload = pState->frame;
+				pState->frame = 0;
+				pState->state = 5;
+				return FALSE;
+			}
+			else if ( ( edge == IR_EDGE_IDLE ) && ( ++pState->idle_cnt < IR_SHARP_INV_IDLE_MAX ) )
+			{
+				return FALSE;
+			}
+		}
+			break;
+
+		case 1: /*frame 1 bit space*/
+		case 6: /*frame 2 bit space*/
+		{
+			if ( IR_IN_RANGE( edge, IR_SHARP_LG1_S_MIN, IR_SHARP_LG1_S_MAX ) )
+			{
+				pState->frame <<= 1;
+				pState->frame |= 1;
+			}
+			else if ( IR_IN_RANGE( edge, IR_SHARP_LG0_S_MIN, IR_SHARP_LG0_S_MAX ) )
+			{
+				pState->frame <<= 1;
+			}
+			else
+			{
+				break;
+			}
+
+			pState->data_cnt++;
+			if ( pState->data_cnt == 15 ) /*address 5 bits + command 8 bits + 2 ext code*/
+			{
+				pState->state = 3;
+				return FALSE;
+			}
+			else if ( pState->data_cnt < 30 )
+			{
+				pState->state = ( pState->state == 1 ) ? 2 : 5;
+				return FALSE;
+			}
+
+			if( ( pState->payload & 0x03ff ) == ( (~(pState->frame & 0x03ff)) & 0x03ff ) )
+			{
+				pPayload->payload = ( ( pState->payload << 16 ) | pState->frame );
+				pPayload->info.bits.protocol_type = IR_PROTOCOL_38K_SHARP;
+				IRLowLevelDecoder_StreamReset( pState );
+				return TRUE;
+			}
+		}
+			break;
+
+		default:
+			break;
+	}
+
+	IRLowLevelDecoder_StreamReset( pState );
+	if ( IR_IN_RANGE( edge, IR_SHARP_1T_P_MIN, IR_SHARP_1T_P_MAX ) )
+	{
+		pState->state = 1;
+	}
+
+	return FALSE;
+}
+
+static bool IRLowLevelDecoder_JVC_Edge( xIrStreamState *pState, uint16 edge, IR_PROTOCOL_PAYLOAD *pPayload )
+{
+	switch( pState->state )
+	{
+		case 1: /*leader space*/
+		{
+			if ( IR_IN_RANGE( edge, IR_JVC_LEAD_S_MIN, IR_JVC_LEAD_S_MAX ) )
+			{
+				pState->state = 2;
+				return FALSE;
+			}
+		}
+			break;
+
+		case 2: /*bit pulse*/
+		{
+			if ( IR_IN_RANGE( edge, IR_JVC_1T_P_MIN, IR_JVC_1T_P_MAX ) )
+			{
+				pState->state = 3;
+				return FALSE;
+			}
+		}
+			break;
+
+		case 3: /*bit space*/
+		{
+			if ( IR_IN_RANGE( edge, IR_JVC_LG1_S_MIN, IR_JVC_LG1_S_MAX ) )
+			{
+				pState->payload <<= 1;
+				pState->payload |= 1;
+			}
+			else if ( IR_IN_RANGE( edge, IR_JVC_LG0_S_MIN, IR_JVC_LG0_S_MAX ) )
+			{
+				pState->payload <<= 1;
+			}
+			else
+			{
+				break;
+			}
+
+			if ( ++pState->data_cnt < 16 )
+			{
+				pState->state = 2;
+				return FALSE;
+			}
+
+			pPayload->payload = pState->payload;
+			pPayload->info.bits.protocol_type = IR_PROTOCOL_38K_JVC;
+			pPayload->info.bits.repeat_type = (IR_PROTOCOL_REPEAT_CLASS)pState->repeat_type;
+			IRLowLevelDecoder_StreamReset( pState );
+			return TRUE;
+		}
+
+		default:
+			break;
+	}
+
+	IRLowLevelDecoder_StreamReset( pState );
+	if ( IR_IN_RANGE( edge, IR_JVC_LEAD_P_MIN, IR_JVC_LEAD_P_MAX ) )
+	{
+		pState->state = 1;
+	}
+	else if ( IR_IN_RANGE( edge, IR_JVC_REPEAT_S_MIN, (IR_JVC_REPEAT_S_MAX*2) ) ) /*repeat frames have no leader*/
+	{
+		pState->repeat_type = IR_PROTOCOL_38K_JVC_REPEAT;
+		pState->state = 2;
+	}
+
+	return FALSE;
+}
+
+static bool IRLowLevelDecoder_RC5_Edge( xIrStreamState *pState, uint16 edge, IR_PROTOCOL_PAYLOAD *pPayload )
+{
+	/*Smith refer to state machine: http://www.clearwater.com.au/code/rc5*/
+	int8 next_state = -1;
+	int8 bit = -1;
+
+	switch( pState->state )
+	{
+		case 0:
+		{
+			if ( IR_IN_RANGE( edge, IR_RC5_SHORT_PULSE_MIN, IR_RC5_SHORT_PULSE_MAX ) )
+			{
+				next_state = 2;
+			}
+			else if ( IR_IN_RANGE( edge, IR_RC5_LONG_PULSE_MIN, IR_RC5_LONG_PULSE_MAX ) )
+			{
+				bit = 0;
+				next_state = 1;
+			}
+		}
+			break;
+
+		case 2:
+		{
+			if ( IR_IN_RANGE( edge, IR_RC5_LONG_SPACE_MIN, IR_RC5_LONG_SPACE_MAX ) ||
+				IR_IN_RANGE( edge, IR_RC5_SHORT_SPACE_MIN, IR_RC5_SHORT_SPACE_MAX ) )
+			{
+				bit = 1;
+				next_state = 0;
+			}
+		}
+			break;
+
+		case 1:
+		{
+			if ( IR_IN_RANGE( edge, IR_RC5_SHORT_SPACE_MIN, IR_RC5_SHORT_SPACE_MAX ) )
+			{
+				next_state = 3;
+			}
+			else if ( IR_IN_RANGE( edge, IR_RC5_LONG_SPACE_MIN, IR_RC5_LONG_SPACE_MAX ) )
+			{
+				bit = 1;
+				next_state = 0;
+			}
+		}
+			break;
+
+		case 3:
+		{
+			if ( IR_IN_RANGE( edge, IR_RC5_SHORT_PULSE_MIN, IR_RC5_SHORT_PULSE_MAX ) ||
+				IR_IN_RANGE( edge, IR_RC5_LONG_PULSE_MIN, IR_RC5_LONG_PULSE_MAX ) )
+			{
+				bit = 0;
+				next_state = 1;
+			}
+		}
+			break;
+
+		default:
+			break;
+	}
+
+	if ( next_state < 0 )
+	{
+		/*a broken frame, the edge may still start a new one*/
+		if ( ( pState->state != 0 ) || ( pState->data_cnt != 0 ) )
+		{
+			IRLowLevelDecoder_StreamReset( pState );
+			return IRLowLevelDecoder_RC5_Edge( pState, edge, pPayload );
+		}
+		return FALSE;
+	}
+
+	pState->state = next_state;
+	if ( bit >= 0 )
+	{
+		pState->payload <<= 1;
+		pState->payload |= bit;
+		if ( ++pState->data_cnt >= 13 )
+		{
+			pPayload->payload = pState->payload;
+			pPayload->info.bits.protocol_type = IR_PROTOCOL_36K_RC5;
+			IRLowLevelDecoder_StreamReset( pState );
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+static const IR_STREAM_DECODE mIrStreamDecoder[IR_STREAM_MAX] =
+{
+	IRLowLevelDecoder_NEC_Edge,
+	IRLowLevelDecoder_SONY_Edge,
+	IRLowLevelDecoder_Sharp_Edge,
+	IRLowLevelDecoder_JVC_Edge,
+	IRLowLevelDecoder_RC5_Edge,
+};
+
+/*TRUE if a decoder with a higher priority than index is inside a frame*/
+static bool IRLowLevelDecoder_StreamBusy( uint8 index )
+{
+	uint8 i;
+
+	for( i = 0; i < index; i++ )
+	{
+		if ( ( mIrStream[i].state != 0 ) || ( mIrStream[i].data_cnt != 0 ) )
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+static void IRLowLevelDecoder_SendPayload( IR_PROTOCOL_PAYLOAD ir_payload )
+{
+	if ( ir_payload.info.bits.protocol_type == IR_PROTOCOL_38K_NEC )
+	{
+		if( ir_payload.info.bits.repeat_type != IR_PROTOCOL_38K_NEC_REPEAT )
+		{
+			mIrPayload.payload = IRLowLevelDecoder_BitsReverse(ir_payload.payload);
+		}
+	}
+	else
+	{
+		/*these remotes resend the whole frame while a key is held*/
+		if ( ( ir_payload.info.byte == mIrPayload.info.byte ) && ( ir_payload.payload == mIrPayload.payload ) &&
+			( ( xTaskGetTickCount( ) - xIrDecoderTimeTick ) < TASK_MSEC2TICKS(IR_STREAM_HOLDOFF_MSEC) ) )
+		{
+			return;
+		}
+		mIrPayload.payload = ir_payload.payload;
+	}
+
+	mIrPayload.info.bits.repeat_type = ir_payload.info.bits.repeat_type;
+	mIrPayload.info.bits.protocol_type = ir_payload.info.bits.protocol_type;
+	pIRCmdHandle_ObjCtrl->insert_queue( mIrPayload );
+	xIrDecoderTimeTick = xTaskGetTickCount( );
+}
+
+static void IRLowLevelDecoder_StreamEdge( uint16 edge )
+{
+	IR_PROTOCOL_PAYLOAD ir_payload;
+	uint8 i;
+
+	for( i = 0; i < IR_STREAM_MAX; i++ )
+	{
+		ir_payload.info.byte = 0;
+		ir_payload.payload = IR_PROTOCOL_NULL;
+		if ( mIrStreamDecoder[i]( &mIrStream[i], edge, &ir_payload ) && ( i < mIrStreamPendingIdx ) )
+		{
+			mIrStreamPending = ir_payload;
+			mIrStreamPendingIdx = i;
+		}
+	}
+
+	/*a completed frame waits while a higher priority decoder may still claim the same edges*/
+	if ( ( mIrStreamPendingIdx < IR_STREAM_MAX ) && ( IRLowLevelDecoder_StreamBusy( mIrStreamPendingIdx ) == FALSE ) )
+	{
+		IRLowLevelDecoder_SendPayload( mIrStreamPending );
+		memset( mIrStream, 0, sizeof(mIrStream) );
+		mIrStreamPendingIdx = IR_STREAM_MAX;
+	}
+}
+
+static void IRLowLevelDecoder_DecoderTask( void *pvParameters )
+{
+	uint16 edge;
+	bool busy;
+
+	for( ;; )
+	{
+		busy = IRLowLevelDecoder_StreamBusy( IR_STREAM_MAX );
+		if ( pIR_LowLevel->get_edge( &edge, ( busy ) ? TASK_MSEC2TICKS(IR_STREAM_IDLE_MSEC) : portMAX_DELAY ) == TRUE )
+		{
+			IRLowLevelDecoder_StreamEdge( edge );
+		}
+		else if ( busy )
+		{
+			IRLowLevelDecoder_StreamEdge( IR_EDGE_IDLE );
+		}
+	}
+}
+
+#else
 static IR_PROTOCOL_PAYLOAD IRLowLevelDecoder_RC5_Decode( const uint16 *pIrRowData, uint16 length )
 {
 	/*Smith refer to state machine: http://www.clearwater.com.au/code/rc5*/
@@ -749,6 +1284,7 @@ static void IRLowLevelDecoder_DecoderTask( void *pvParameters )
         vTaskDelay( 10 ); 
     }
 }
+#endif
 
 void IRLowLevelDecoder_CreateTask( void )
 {
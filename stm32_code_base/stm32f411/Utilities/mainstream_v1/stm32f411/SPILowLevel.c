@@ -6,6 +6,7 @@
 #if defined ( FREE_RTOS )
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "freertos_conf.h"
 #endif 
 
 /*_____________________________________________________________________________________________*/
@@ -38,6 +39,23 @@
 #define _SPI_CS0_HIGH()    	GPIOMiddleLevel_Set( __O_SPI1_NSS )
 #define _SPI_CS1_LOW()      GPIOMiddleLevel_Clr( __O_EXT_FLASH_CS )
 #define _SPI_CS1_HIGH()     GPIOMiddleLevel_Set( __O_EXT_FLASH_CS )
+
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+/*RM0383 Table 28: SPI4_RX DMA2 stream0 channel4, SPI4_TX DMA2 stream1 channel4*/
+#define SPIx_DMA_CLK                   RCC_AHB1Periph_DMA2
+#define SPIx_TX_DMA_CHANNEL            DMA_Channel_4
+#define SPIx_TX_DMA_STREAM             DMA2_Stream1
+#define SPIx_TX_DMA_FLAGS              (DMA_FLAG_TCIF1|DMA_FLAG_HTIF1|DMA_FLAG_TEIF1|DMA_FLAG_DMEIF1|DMA_FLAG_FEIF1)
+#define SPIx_RX_DMA_CHANNEL            DMA_Channel_4
+#define SPIx_RX_DMA_STREAM             DMA2_Stream0
+#define SPIx_RX_DMA_FLAGS              (DMA_FLAG_TCIF0|DMA_FLAG_HTIF0|DMA_FLAG_TEIF0|DMA_FLAG_DMEIF0|DMA_FLAG_FEIF0)
+#define SPIx_RX_DMA_IT_TC              DMA_IT_TCIF0
+#define SPIx_RX_DMA_IRQn               DMA2_Stream0_IRQn
+#define SPIx_RX_DMA_IRQHandler         DMA2_Stream0_IRQHandler
+
+/*A 2KB block at 25MHz takes < 1ms; anything longer means the bus is hung*/
+#define SPIx_DMA_TIMEOUT               ( 20/portTICK_RATE_MS )
+#endif
 /*_________________________________________________________________________________________________________*/
 // Private Variable
 SPI_InitTypeDef  SPI_InitStructure;
@@ -47,6 +65,12 @@ static bool bIsSPI_enable = FALSE;
 static xSemaphoreHandle _SPI_SEMA = NULL;
 #endif 
 
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+static xSemaphoreHandle _SPI_DMA_DONE = NULL;
+static DMA_InitTypeDef SPI_DMA_InitStructure;
+static uint8_t SPI_DMA_dummy = 0xFF;
+#endif 
+
 //static int i_counter = 0;
 /*_____________________________________________________________________________________________*/
 extern void SPI_GPIOLowLevel_DeConfiguration( void );
@@ -168,6 +192,107 @@ static void __STM32_SPI_Configuration( void )
 
 }
 
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+static void __STM32_SPI_DMA_Configuration( void )
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_AHB1PeriphClockCmd(SPIx_DMA_CLK, ENABLE);
+
+    DMA_DeInit(SPIx_TX_DMA_STREAM);
+    DMA_DeInit(SPIx_RX_DMA_STREAM);
+
+    DMA_StructInit(&SPI_DMA_InitStructure);
+    SPI_DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)(&(SPIx->DR));
+    SPI_DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    SPI_DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    SPI_DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    SPI_DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    SPI_DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    SPI_DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+
+    /*Only RX completion is reported: the last RX byte means the last TX byte left the shifter*/
+    NVIC_InitStructure.NVIC_IRQChannel = SPIx_RX_DMA_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIB_SPI_DMA_INTERRUPT_PRIORITY;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    if ( _SPI_DMA_DONE == NULL )
+    {
+        vSemaphoreCreateBinary( _SPI_DMA_DONE );
+        xSemaphoreTake( _SPI_DMA_DONE, 0 );
+    }
+}
+
+/*TX and RX streams always run together so RXNE/OVR never pile up behind the DMA*/
+static bool __STM32_SPI_DMA_Transfer( const byte *tx, byte *rx, uint16 length )
+{
+    bool ret = TRUE;
+
+    if ( bIsSPI_enable != TRUE || _SPI_DMA_DONE == NULL || length == 0 )
+        return FALSE;
+
+    /*drain a byte left behind by SPI_write(), which never reads DR*/
+    while (SPI_I2S_GetFlagStatus(_SPI, SPI_I2S_FLAG_TXE) == RESET);
+    while (SPI_I2S_GetFlagStatus(_SPI, SPI_I2S_FLAG_BSY) == SET);
+    SPI_I2S_ReceiveData(_SPI);
+
+    DMA_ClearFlag(SPIx_TX_DMA_STREAM, SPIx_TX_DMA_FLAGS);
+    DMA_ClearFlag(SPIx_RX_DMA_STREAM, SPIx_RX_DMA_FLAGS);
+
+    SPI_DMA_InitStructure.DMA_BufferSize = length;
+
+    SPI_DMA_InitStructure.DMA_Channel = SPIx_RX_DMA_CHANNEL;
+    SPI_DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    SPI_DMA_InitStructure.DMA_Memory0BaseAddr = (rx != NULL) ? (uint32_t)rx : (uint32_t)&SPI_DMA_dummy;
+    SPI_DMA_InitStructure.DMA_MemoryInc = (rx != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_Init(SPIx_RX_DMA_STREAM, &SPI_DMA_InitStructure);
+
+    SPI_DMA_InitStructure.DMA_Channel = SPIx_TX_DMA_CHANNEL;
+    SPI_DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    SPI_DMA_InitStructure.DMA_Memory0BaseAddr = (tx != NULL) ? (uint32_t)tx : (uint32_t)&SPI_DMA_dummy;
+    SPI_DMA_InitStructure.DMA_MemoryInc = (tx != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_Init(SPIx_TX_DMA_STREAM, &SPI_DMA_InitStructure);
+
+    SPI_DMA_dummy = 0xFF;
+
+    DMA_ITConfig(SPIx_RX_DMA_STREAM, DMA_IT_TC, ENABLE);
+    DMA_Cmd(SPIx_RX_DMA_STREAM, ENABLE);
+    DMA_Cmd(SPIx_TX_DMA_STREAM, ENABLE);
+    SPI_I2S_DMACmd(_SPI, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+
+    if ( xSemaphoreTake( _SPI_DMA_DONE, SPIx_DMA_TIMEOUT ) != pdTRUE )
+    {
+        TRACE_ERROR((0, "SPI DMA timeout !! "));
+        ret = FALSE;
+    }
+
+    SPI_I2S_DMACmd(_SPI, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+    DMA_Cmd(SPIx_TX_DMA_STREAM, DISABLE);
+    DMA_Cmd(SPIx_RX_DMA_STREAM, DISABLE);
+    DMA_ITConfig(SPIx_RX_DMA_STREAM, DMA_IT_TC, DISABLE);
+
+    /*a TC that landed after the timeout must not complete the next transfer early*/
+    xSemaphoreTake( _SPI_DMA_DONE, 0 );
+
+    return ret;
+}
+
+void SPIx_RX_DMA_IRQHandler( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    if ( DMA_GetITStatus(SPIx_RX_DMA_STREAM, SPIx_RX_DMA_IT_TC) != RESET )
+    {
+        DMA_ClearITPendingBit(SPIx_RX_DMA_STREAM, SPIx_RX_DMA_IT_TC);
+        xSemaphoreGiveFromISR( _SPI_DMA_DONE, &xHigherPriorityTaskWoken );
+    }
+
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+#endif 
+
 #if defined ( FREE_RTOS )
 static bool _SPI_MUTEX_TAKE( void )
 {
@@ -246,6 +371,10 @@ void SPILowLevel_initialize( void )
 #if defined ( FREE_RTOS )	
 	_SPI_MUTEX_CREATE();
 #endif 
+
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+	__STM32_SPI_DMA_Configuration( );
+#endif 
         
 	bIsSPI_enable = TRUE;
 }
@@ -404,6 +533,19 @@ bool SPI_mutex_unlock( )
 }
 #endif 
 
+#if defined ( FREE_RTOS )
+bool SPI_mutex_trylock( void )
+{
+	if ( _SPI_SEMA == NULL )
+		return FALSE;
+
+	if ( xSemaphoreTake( _SPI_SEMA, 0 ) != pdTRUE )
+		return FALSE;
+
+	return TRUE;
+}
+#endif 
+
 int16 SPI_writeBuffer(const byte *data, uint16 length, bool LittelEndian)
 {
     int16 ret = SPI_RET_ERROR_LEN;
@@ -474,3 +616,21 @@ int16 SPI_readBuffer(byte *data, uint16 length, bool LittelEndian)
 
 	return ret;
 }
+
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+bool SPI_DMA_writeBuffer( const byte *data, uint16 length )
+{
+	if ( data == NULL )
+		return FALSE;
+
+	return __STM32_SPI_DMA_Transfer( data, NULL, length );
+}
+
+bool SPI_DMA_readBuffer( byte *data, uint16 length )
+{
+	if ( data == NULL )
+		return FALSE;
+
+	return __STM32_SPI_DMA_Transfer( NULL, data, length );
+}
+#endif 
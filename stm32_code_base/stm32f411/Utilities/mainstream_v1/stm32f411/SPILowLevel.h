@@ -2,6 +2,7 @@
 #define __SPI_LOW_LEVEL_H__
 
 #include "Defs.h"
+#include "device_config.h"
 
 #define SPIx    SPI4
 #define _SPI    SPIx
@@ -46,6 +47,11 @@ bool SPI_mutex_lock( );
 bool SPI_mutex_unlock( );
 #endif 
 
+#if defined ( FREE_RTOS )
+/*Takes the SPI mutex only if it is free, for timer callbacks which must not block*/
+bool SPI_mutex_trylock( void );
+#endif 
+
 bool SPI_unselectChip( unsigned char chip );
 
 bool SPI_selectChip( unsigned char chip );
@@ -56,5 +62,12 @@ void SPILowLevel_release_SPI(void);
 
 bool SPILowLevel_isEnable( void );
 
+#if ( configSPI_DMA == 1 ) && defined ( FREE_RTOS )
+/*DMA transfer of a whole buffer; the caller holds the SPI mutex and chip select*/
+bool SPI_DMA_writeBuffer( const byte *data, uint16 length );
+
+bool SPI_DMA_readBuffer( byte *data, uint16 length );
+#endif
+
 
 #endif /*__SPI_LOW_LEVEL_H__*/
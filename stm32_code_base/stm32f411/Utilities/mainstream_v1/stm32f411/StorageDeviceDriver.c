@@ -32,6 +32,7 @@ static storagePartitionType m_partitionSpaceAllocation[] =
 	{ (EEPROM_PAGE_SIZE*1), 0, STORAGE_DISK_0 }, /*program remote */
 	{ (EEPROM_PAGE_SIZE*1), 0, STORAGE_DISK_0 }, /*program remote */
 	{ (EEPROM_PAGE_SIZE*1), 0, STORAGE_DISK_0 }, /*program remote */
+	{ (EEPROM_PAGE_SIZE*24), 0, STORAGE_DISK_0 }, /*user parameter journal */
 };
 
 
@@ -46,7 +47,9 @@ static storageCellType m_storageSpaceAllocation[] =
 
 	{PRG_REMOTE_SIZE, STORAGE_PARTITION_3, STORAGE_DEVICE_CELL_PROGRAM_KEY_VOLUME_DN },
 
-	{PRG_REMOTE_SIZE, STORAGE_PARTITION_4, STORAGE_DEVICE_CELL_PROGRAM_KEY_VOLUME_MUTE }
+	{PRG_REMOTE_SIZE, STORAGE_PARTITION_4, STORAGE_DEVICE_CELL_PROGRAM_KEY_VOLUME_MUTE },
+
+	{1, STORAGE_PARTITION_1, STORAGE_DEVICE_CELL_USER_JOURNAL_SEQ }
 };
 
 
@@ -216,6 +219,52 @@ bool StorageDevice_write(STORAGE_DEVICE_CELL cell, void *buff)
     return retVal;
 }
 
+uint16 StorageDevice_partitionSize(STORAGE_PARTITION partition)
+{
+    return m_partitionSpaceAllocation[partition].size;
+}
+
+bool StorageDevice_readPartition(STORAGE_PARTITION partition, uint16 offset, void *buff, uint16 size)
+{
+    LOGICAL_EEPROM_DEVICE device;
+
+    if ((offset + size) > m_partitionSpaceAllocation[partition].size)
+    {
+        return FALSE;
+    }
+
+    device = (LOGICAL_EEPROM_DEVICE)(LOGICAL_EEPROM_DEVICE_BLOCK0 +
+                                     m_partitionSpaceAllocation[partition].disk);
+
+    return EepromDriver_read(device,
+                             (StorageDevice_calcPartitionAddress(partition) + offset),
+                             (uint8 *)buff,
+                             size);
+}
+
+bool StorageDevice_writePartition(STORAGE_PARTITION partition, uint16 offset, void *buff, uint16 size)
+{
+    LOGICAL_EEPROM_DEVICE device;
+
+    if ((offset + size) > m_partitionSpaceAllocation[partition].size)
+    {
+        return FALSE;
+    }
+
+    device = (LOGICAL_EEPROM_DEVICE)(LOGICAL_EEPROM_DEVICE_BLOCK0 +
+                                     m_partitionSpaceAllocation[partition].disk);
+
+#if( DEBUG_STORAGE == 1 )
+	TRACE_DEBUG((0, "write partition = %d, size = %d, offset = 0x%X", partition, size, offset ));
+#endif 
+
+    return EepromDriver_write(device,
+                              (StorageDevice_calcPartitionAddress(partition) + offset),
+                              (uint8 *)buff,
+                              size,
+                              FALSE);
+}
+
 bool StorageDevice_eraseDeviceCell( STORAGE_DEVICE_CELL cell )
 {
     uint16 addr;
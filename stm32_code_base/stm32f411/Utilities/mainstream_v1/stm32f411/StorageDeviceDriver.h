@@ -11,6 +11,7 @@ typedef enum
     STORAGE_PARTITION_2,
     STORAGE_PARTITION_3,
     STORAGE_PARTITION_4,
+    STORAGE_PARTITION_5,
     STORAGE_PARTITION_LAST
 } STORAGE_PARTITION;
 
@@ -98,6 +99,26 @@ bool StorageDevice_eraseDeviceCell(STORAGE_DEVICE_CELL cell);
 
 bool StorageDevice_checkPartitionReversion( STORAGE_PARTITION partition );
 
+/*
+ * @return  the partition size in bytes
+ */
+uint16 StorageDevice_partitionSize(STORAGE_PARTITION partition);
+
+/*
+ * Raw access inside a partition, for partitions that are not split in cells
+ * (the user parameter journal).
+ *
+ * @param   partition   partition number.
+ * @param   offset      offset from the beginning of the partition.
+ * @param   buff        data to write / container for the data read.
+ * @param   size        number of bytes, offset+size must fit the partition.
+ *
+ * @return  TRUE in case of success, FALSE otherwise.
+ */
+bool StorageDevice_readPartition(STORAGE_PARTITION partition, uint16 offset, void *buff, uint16 size);
+
+bool StorageDevice_writePartition(STORAGE_PARTITION partition, uint16 offset, void *buff, uint16 size);
+
 
 #endif
 
@@ -1,20 +1,45 @@
 #include "UART_Lowlevel.h"
 
-#define RECEIVE_BUFFER_SIZE 136
-
+#if defined ( FREE_RTOS )
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "freertos_conf.h"
+#endif 
+
+#if !defined ( configUART_RX_BUFFER_SIZE )
+#define configUART_RX_BUFFER_SIZE 256
+#endif
+
+#if !defined ( configUART_RX_OVERRUN_COUNT )
+#define configUART_RX_OVERRUN_COUNT 1
+#endif
+
+#define RECEIVE_BUFFER_SIZE configUART_RX_BUFFER_SIZE
+#define RECEIVE_BUFFER_MASK ( RECEIVE_BUFFER_SIZE - 1 )
+
+#if ( RECEIVE_BUFFER_SIZE & RECEIVE_BUFFER_MASK ) || ( RECEIVE_BUFFER_SIZE > 0x8000 )
+#error "configUART_RX_BUFFER_SIZE must be a power of two up to 32K"
+#endif
+
+/* Single producer (the receive ISR moves m_rxHead) and single consumer (the
+ * reading task moves m_rxTail). Both indexes run free and are masked on
+ * access, so head - tail is the fill level and neither side needs a critical
+ * section. */
 typedef struct
 {
     /** Buffer storing all characters received and pending to be read */
     char m_rxBuffer[RECEIVE_BUFFER_SIZE];
 
-    /** Number of bytes in the received buffer */
-    byte m_rxBufferLength;
+    /** Write index, only changed by the receive ISR */
+    volatile uint16 m_rxHead;
 
-    /** Index to the oldest data in the buffer */
-    byte m_rxBufferStart;
+    /** Read index, only changed by UARTLowLevel_readData */
+    volatile uint16 m_rxTail;
 
-    /** */
-    int m_rxOverruns;
+#if ( configUART_RX_OVERRUN_COUNT == 1 )
+    /** Bytes dropped because the buffer was full */
+    uint32 m_rxOverruns;
+#endif
 
     /** Tx Buffer Ready Flag */
     bool m_txBufferEmpty;
@@ -24,13 +49,27 @@ typedef struct
 /*Smith modify: remove unnecessary memory*/
 static UART_port m_port;
 
+#if defined ( FREE_RTOS )
+/* given once per received burst, see UARTLowLevel_waitData */
+static xSemaphoreHandle _UART_RX_SEMA = NULL;
+#endif 
+
 
 /*---------------------- AMTRAN IMPLEMENT ----------------------*/
-byte UARTLowLevel_getDataLength( void )
+uint16 UARTLowLevel_getDataLength( void )
 {
     UART_port* p = &m_port;
 
-    return ( p->m_rxBufferLength );
+    return (uint16)( p->m_rxHead - p->m_rxTail );
+}
+
+uint32 UARTLowLevel_getOverruns( void )
+{
+#if ( configUART_RX_OVERRUN_COUNT == 1 )
+    return m_port.m_rxOverruns;
+#else
+    return 0;
+#endif
 }
 
 bool UARTLowLevel_isTxBufferReady(uint8 port)
@@ -47,26 +86,32 @@ int UARTLowLevel_readData(uint8 port, void *buffer, int maxLength)
 	/*Smith modify: remove unnecessary memory*/
 	//UART_port* p = &m_port[port];
     UART_port* p = &m_port;
+    uint16 tail = p->m_rxTail;
+    uint16 start = tail & RECEIVE_BUFFER_MASK;
 
     /* Calculate the actual length of data to read */
-    int lengthToTake = MINIMUM( maxLength, p->m_rxBufferLength );
+    int lengthToTake = (uint16)( p->m_rxHead - tail );
+    lengthToTake = MINIMUM( maxLength, lengthToTake );
 
-    if (lengthToTake == 0)
+    if (lengthToTake <= 0)
     {
         return 0;
     }
 
+    /* the data must be read before the ISR sees the space released */
+    __DMB();
+
     /* If copying the buffer will pass the end of the buffer and wrap around */
-    if ( (p->m_rxBufferStart + lengthToTake) > RECEIVE_BUFFER_SIZE )
+    if ( (start + lengthToTake) > RECEIVE_BUFFER_SIZE )
     {
         /* Then copy in two phases */
-        byte firstPhase = RECEIVE_BUFFER_SIZE - p->m_rxBufferStart;
-        byte secondPhase = lengthToTake - firstPhase;
+        uint16 firstPhase = RECEIVE_BUFFER_SIZE - start;
+        uint16 secondPhase = lengthToTake - firstPhase;
         void* secondPhaseStart = (byte*)(buffer) + firstPhase;
 
         MEMCPY(
             buffer,
-            (void*)(p->m_rxBuffer + p->m_rxBufferStart),
+            (void*)(p->m_rxBuffer + start),
             firstPhase
             );
 
@@ -81,60 +126,109 @@ int UARTLowLevel_readData(uint8 port, void *buffer, int maxLength)
 
         MEMCPY(
             buffer,
-            p->m_rxBuffer + p->m_rxBufferStart,
+            p->m_rxBuffer + start,
             lengthToTake
             );
     }
 
+    __DMB();
 
-    /* Position the start pointer onwards... */
-    p->m_rxBufferStart += lengthToTake;
-    if ( p->m_rxBufferStart >= RECEIVE_BUFFER_SIZE )
+    /* Position the read index onwards; this releases the space */
+    p->m_rxTail = tail + lengthToTake;
+
+    return lengthToTake;
+}
+
+#if defined ( FREE_RTOS )
+bool UARTLowLevel_waitData( uint32 xTicksToWait )
+{
+    if ( _UART_RX_SEMA == NULL )
     {
-        p->m_rxBufferStart -= RECEIVE_BUFFER_SIZE;
+        vSemaphoreCreateBinary( _UART_RX_SEMA );
+        xSemaphoreTake( _UART_RX_SEMA, 0 );
     }
 
-    /* And update the length */
-    p->m_rxBufferLength -= lengthToTake;
+    /* a burst that arrived before the semaphore existed is not signalled */
+    if ( UARTLowLevel_getDataLength( ) == 0 )
+    {
+        xSemaphoreTake( _UART_RX_SEMA, xTicksToWait );
+    }
 
-    return lengthToTake;
+    return ( UARTLowLevel_getDataLength( ) != 0 );
 }
+#endif 
 
-static void UARTLowLevel_interruptHandlerCommon(uint8 port, uint8 c)
+/* Copies a whole received burst (one USB OUT packet for the virtual port) into
+ * the buffer. When the buffer is full the new bytes are dropped and counted,
+ * data not read yet is never overwritten. */
+static void UARTLowLevel_interruptHandlerCommon(uint8 port, const uint8 *data, uint32 length)
 {
 	/*Smith modify: remove unnecessary memory*/
 	//UART_port* p = &m_port[port];
 	UART_port* p = &m_port;
+	uint16 head = p->m_rxHead;
+	uint16 start = head & RECEIVE_BUFFER_MASK;
+	uint16 space = RECEIVE_BUFFER_SIZE - (uint16)( head - p->m_rxTail );
+	uint16 firstPhase;
 
-	uint8 U0RBR = 0;
-
-	U0RBR= c;
-
-	/* If the buffer is full, step on the oldest data */
-	if (p->m_rxBufferLength == RECEIVE_BUFFER_SIZE)
+	if (length > space)
 	{
-		p->m_rxBuffer[p->m_rxBufferStart]=U0RBR;
-		ADD_MODULO(p->m_rxBufferStart, 1, RECEIVE_BUFFER_SIZE);
-		p->m_rxOverruns++;
+#if ( configUART_RX_OVERRUN_COUNT == 1 )
+		p->m_rxOverruns += (length - space);
+#endif
+		length = space;
 	}
-	else
+
+	if (length == 0)
 	{
-		/* Calculate the position to add the value to */
-		int pos = p->m_rxBufferStart;
-		ADD_MODULO(pos, p->m_rxBufferLength, RECEIVE_BUFFER_SIZE);
+		return;
+	}
+
+	firstPhase = MINIMUM( (uint16)length, (uint16)(RECEIVE_BUFFER_SIZE - start) );
 
-		/* Read and save the data */
-		p->m_rxBuffer[pos]=U0RBR;
+	MEMCPY(
+		p->m_rxBuffer + start,
+		data,
+		firstPhase
+		);
 
-		/* Increase the m_rxBufferLength */
-		p->m_rxBufferLength++;
+	if (length > firstPhase)
+	{
+		MEMCPY(
+			p->m_rxBuffer,
+			data + firstPhase,
+			(length - firstPhase)
+			);
 	}
+
+	/* publish the data before the index that makes it visible */
+	__DMB();
+
+	p->m_rxHead = head + (uint16)length;
 }
 
 
 void usart_lowlevel_handler(uint8_t port, uint8_t c)
 {
-	UARTLowLevel_interruptHandlerCommon( port, c );
+	UARTLowLevel_interruptHandlerCommon( port, &c, 1 );
 }
 
+void usart_lowlevel_rx_handler(uint8_t port, uint8_t *data, uint32_t length)
+{
+#if defined ( FREE_RTOS )
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+#endif 
+
+	UARTLowLevel_interruptHandlerCommon( port, data, length );
+
+#if defined ( FREE_RTOS )
+	/* one wake up per burst instead of one per byte */
+	if ( _UART_RX_SEMA != NULL )
+	{
+		xSemaphoreGiveFromISR( _UART_RX_SEMA, &xHigherPriorityTaskWoken );
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+#endif 
+}
 
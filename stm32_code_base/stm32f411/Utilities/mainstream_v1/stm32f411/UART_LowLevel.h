@@ -2,6 +2,7 @@
 #define __APPLICATION_LOWLEVEL_UARTLOWLEVEL_H__
 
 #include "Defs.h"
+#include "device_config.h"
 
 /*-------------------AMTRAN IMPLEMENTED---------------------*/
 #define SERIAL_PORT_NUM      2
@@ -11,11 +12,19 @@
 #define VIRTUAL_PORT	SERIAL_PORT_1
 
 
-byte UARTLowLevel_getDataLength( void );
+uint16 UARTLowLevel_getDataLength( void );
+
+/*number of received bytes dropped because the receive buffer was full*/
+uint32 UARTLowLevel_getOverruns( void );
 
 bool UARTLowLevel_isTxBufferReady(uint8 port);
 
 int UARTLowLevel_readData(uint8 port, void *buffer, int maxLength);
 
+#if defined ( FREE_RTOS )
+/*block up to xTicksToWait RTOS ticks for received data; TRUE if data is pending*/
+bool UARTLowLevel_waitData( uint32 xTicksToWait );
+#endif 
+
 
 #endif /*__APPLICATION_LOWLEVEL_UARTLOWLEVEL_H__*/
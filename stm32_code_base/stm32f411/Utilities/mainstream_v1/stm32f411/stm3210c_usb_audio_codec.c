@@ -32,7 +32,7 @@
 /*==============================================================================================================================
                                              User NOTES
   This file is extracted and modified from the audio codec driver provided by STMicroelectronics for the STM32F105/7
-  family.
+  family, and ported to the STM32F411 I2S2 / DMA1 Stream4.
   This modified driver is intended for use only in the scope of the USB Device Audio Example.
 ===============================================================================================================================*/
 
@@ -86,6 +86,9 @@ extern USB_MEDIA_MANAGE_OBJECT *pUSBMedia_ObjCtrl;
 /* Private variables ---------------------------------------------------------*/
 /* This structure is declared glabal because it is handled by two different functions */
 static DMA_InitTypeDef DMA_InitStructure; 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+static __IO uint8_t AudioMalCircular = 0;   /*set while Audio_MAL_PlayCircular() owns the channel*/
+#endif
 static I2S_InitTypeDef I2S_InitStructure;
 static uint8_t OutputDev = 0;
 
@@ -314,9 +317,28 @@ void Audio_MAL_IRQHandler(void)
   uint32_t Size = AudioRemSize;
 #endif /* AUDIO_MAL_MODE_NORMAL */
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+  /* Circular playback: the stream keeps running, only report which half the DMA has left */
+  if (AudioMalCircular)
+  {
+    if (DMA_GetFlagStatus(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_HT) != RESET)
+    {
+      DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_HT);
+      pUSBMedia_ObjCtrl->HalfFreed(0);
+    }
+
+    if (DMA_GetFlagStatus(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC) != RESET)
+    {
+      DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC);
+      pUSBMedia_ObjCtrl->HalfFreed(1);
+    }
+    return;
+  }
+#endif
+
 #ifdef AUDIO_MAL_DMA_IT_TC_EN
   /* Transfer complete interrupt */
-  if (DMA_GetFlagStatus(AUDIO_MAL_DMA_FLAG_TC) != RESET)
+  if (DMA_GetFlagStatus(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC) != RESET)
   {     
  #ifdef AUDIO_MAL_MODE_NORMAL
 #if 0 /*Smith mark!*/
@@ -324,17 +346,17 @@ void Audio_MAL_IRQHandler(void)
     if (AudioRemSize > 0)
     {      
       /* Clear the Interrupt flag */
-      DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_TC);  /*smith*/
+      DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC);  /*smith*/
       
       /* Re-Configure the buffer address and size */
-      DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t) CurrentPos;
+      DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t) CurrentPos;
       DMA_InitStructure.DMA_BufferSize = (uint32_t) (DMA_MAX(AudioRemSize));
       
       /* Configure the DMA Stream with the new parameters */
-	  DMA_Init(AUDIO_MAL_DMA_CHANNEL, &DMA_InitStructure);	/*smith*/
+	  DMA_Init(AUDIO_MAL_DMA_STREAM, &DMA_InitStructure);	/*smith*/
       
       /* Enable the I2S DMA Stream*/
-      DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, ENABLE);	/*smith*/
+      DMA_Cmd(AUDIO_MAL_DMA_STREAM, ENABLE);	/*smith*/
       
       /* Update the current pointer position */
       CurrentPos += DMA_MAX(AudioRemSize);        
@@ -345,10 +367,10 @@ void Audio_MAL_IRQHandler(void)
     else
     {
       /* Disable the I2S DMA Stream*/
-      DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);   
+      DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);   
       
       /* Clear the Interrupt flag */
-      DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_TC);       
+      DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC);       
       
       /* Manage the remaining file size and new address offset: This function 
       should be coded by user (its prototype is already declared in stm32_eval_audio_codec.h) */  
@@ -357,10 +379,10 @@ void Audio_MAL_IRQHandler(void)
 #else
 
 	/* Disable the I2S DMA Stream*/
-	DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);   
+	DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);   
 
 	/* Clear the Interrupt flag */
-	DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_TC);  
+	DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC);  
 
     #if 0   /* Angus remove for pass compiler (2014/2/17) */
     if (USB_Media_FeedToDMA( ) == QUEUE_EMPTY)
@@ -369,7 +391,7 @@ void Audio_MAL_IRQHandler(void)
     }
     #endif
 
-#if ( configUSB_WAV_PLAYER == 1 )
+#if ( configUSB_WAV_PLAYER == 1 ) && ( configUSB_WAV_CIRCULAR_DMA == 0 )
     pUSBMedia_ObjCtrl->FetchQueue();
 #endif 
     
@@ -381,7 +403,7 @@ void Audio_MAL_IRQHandler(void)
     //EVAL_AUDIO_TransferComplete_CallBack(pAddr, Size);    
     
 	/* Clear the Interrupt flag */
-	DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_TC); 
+	DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC); 
  #endif /* AUDIO_MAL_MODE_NORMAL */  
  
   }
@@ -1006,47 +1028,8 @@ static void Codec_CtrlInterface_DeInit(void)
   */
 static void Codec_AudioInterface_Init(uint32_t AudioFreq)
 {
-	switch( AudioFreq )
-	{
-		case SAMPLE_RATE_8000:
-		{
-			RCC_PLL3Config(RCC_PLL3Mul_20);
-		}
-			break;
-
-		case SAMPLE_RATE_11025:
-		{
-			RCC_PLL3Config(RCC_PLL3Mul_14);
-		}
-			break;
-		case SAMPLE_RATE_16000:
-		{
-			RCC_PLL3Config(RCC_PLL3Mul_9);
-		}
-			break;
-		case SAMPLE_RATE_22050:        
-		{
-			RCC_PLL3Config(RCC_PLL3Mul_13);
-		}
-			break;
-		case SAMPLE_RATE_32000:
-		case SAMPLE_RATE_44100:
-		{
-			RCC_PLL3Config(RCC_PLL3Mul_9);
-		}
-			break;
-		case SAMPLE_RATE_48000: 
-		{
-			RCC_PLL3Config(RCC_PLL3Mul_12);
-		}
-			break;
-	}
-	
-	/* Enable PLL3 */
-	RCC_PLL3Cmd(ENABLE);    
-	/* Wait till PLL3 is ready */
-	while (RCC_GetFlagStatus(RCC_FLAG_PLL3RDY) == RESET)
-	{}
+  /* PLLI2S is set up and selected as I2SCLK by SetSysClock() (system_stm32f4xx.c),
+     I2S_Init() derives the prescaler for AudioFreq from it */
 
   /* Enable the CODEC_I2S peripheral clock */
   RCC_APB1PeriphClockCmd(CODEC_I2S_CLK, ENABLE);
@@ -1093,10 +1076,7 @@ static void Codec_AudioInterface_DeInit(void)
 	/* Disable the CODEC_I2S peripheral clock */
 	RCC_APB1PeriphClockCmd(CODEC_I2S_CLK, DISABLE); 
 
-
-	/*Smith Implements: 2013/5/30 */
-	RCC_PLL3Cmd(DISABLE); 
-	
+	/* PLLI2S is left running, it is owned by the system clock setup */
 }
 
 
@@ -1112,29 +1092,38 @@ static void Codec_GPIO_Init(void)
 
 #if defined ( DAC_CS43L22 )  
   /* Enable I2S and I2C GPIO clocks */
-  RCC_APB2PeriphClockCmd(CODEC_I2C_GPIO_CLOCK | CODEC_I2S_GPIO_CLOCK, ENABLE);
+  RCC_AHB1PeriphClockCmd(CODEC_I2C_GPIO_CLOCK | CODEC_I2S_GPIO_CLOCK, ENABLE);
 
   /* CODEC_I2C SCL and SDA pins configuration -------------------------------------*/
   GPIO_InitStructure.GPIO_Pin = CODEC_I2C_SCL_PIN | CODEC_I2C_SDA_PIN; 
   GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_OD;
+  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+  GPIO_InitStructure.GPIO_OType = GPIO_OType_OD;
+  GPIO_InitStructure.GPIO_PuPd  = GPIO_PuPd_NOPULL;
   GPIO_Init(CODEC_I2C_GPIO, &GPIO_InitStructure);
 #else
-  RCC_APB2PeriphClockCmd( CODEC_I2S_GPIO_CLOCK, ENABLE);
+  RCC_AHB1PeriphClockCmd( CODEC_I2S_GPIO_CLOCK, ENABLE);
 #endif 
 
   /* CODEC_I2S pins configuraiton: WS, SCK and SD pins -----------------------------*/
   GPIO_InitStructure.GPIO_Pin = CODEC_I2S_WS_PIN | CODEC_I2S_SCK_PIN | CODEC_I2S_SD_PIN; 
   GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+  GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+  GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
   GPIO_Init(CODEC_I2S_GPIO, &GPIO_InitStructure);
 
+  /* Connect pins to I2S peripheral  */
+  GPIO_PinAFConfig(CODEC_I2S_GPIO, CODEC_I2S_WS_PINSRC, CODEC_I2S_GPIO_AF);
+  GPIO_PinAFConfig(CODEC_I2S_GPIO, CODEC_I2S_SCK_PINSRC, CODEC_I2S_GPIO_AF);
+  GPIO_PinAFConfig(CODEC_I2S_GPIO, CODEC_I2S_SD_PINSRC, CODEC_I2S_GPIO_AF);
+
  #ifdef CODEC_MCLK_ENABLED
   /* CODEC_I2S pins configuraiton: MCK pin */
+  RCC_AHB1PeriphClockCmd(CODEC_I2S_MCK_GPIO_CLOCK, ENABLE);
   GPIO_InitStructure.GPIO_Pin = CODEC_I2S_MCK_PIN; 
-  GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
   GPIO_Init(CODEC_I2S_MCK_GPIO, &GPIO_InitStructure);    
+  GPIO_PinAFConfig(CODEC_I2S_MCK_GPIO, CODEC_I2S_MCK_PINSRC, CODEC_I2S_GPIO_AF);
  #endif /* CODEC_MCLK_ENABLED */   
 }
 
@@ -1152,7 +1141,8 @@ static void Codec_GPIO_DeInit(void)
      they are used by the IOExpander as well) */
   GPIO_InitStructure.GPIO_Pin = CODEC_I2S_WS_PIN | CODEC_I2S_SCK_PIN | CODEC_I2S_SD_PIN;
   GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
+  GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
   GPIO_Init(CODEC_I2S_GPIO, &GPIO_InitStructure);     
   
 #ifdef CODEC_MCLK_ENABLED
@@ -1173,7 +1163,9 @@ static void Codec_GPIO_DeInit2(void)
      they are used by the IOExpander as well) */
   GPIO_InitStructure.GPIO_Pin = CODEC_I2S_WS_PIN | CODEC_I2S_SCK_PIN | CODEC_I2S_SD_PIN;
   GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP;
+  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;
+  GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+  GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
   GPIO_Init(CODEC_I2S_GPIO, &GPIO_InitStructure);     
   
 #ifdef CODEC_MCLK_ENABLED
@@ -1229,15 +1221,16 @@ void Audio_MAL_Init(void)
 #endif
   
   /* Enable the DMA clock */
-  RCC_AHBPeriphClockCmd(AUDIO_MAL_DMA_CLOCK, ENABLE); 
+  RCC_AHB1PeriphClockCmd(AUDIO_MAL_DMA_CLOCK, ENABLE); 
   
   /* Configure the DMA Stream */
-  DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);
-  DMA_DeInit(AUDIO_MAL_DMA_CHANNEL);
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);
+  DMA_DeInit(AUDIO_MAL_DMA_STREAM);
   /* Set the parameters to be configured */
+  DMA_InitStructure.DMA_Channel = AUDIO_MAL_DMA_CHANNEL;
   DMA_InitStructure.DMA_PeripheralBaseAddr = CODEC_I2S_ADDRESS;
-  DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)0;      /* This field will be configured in play function */
-  DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+  DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)0;      /* This field will be configured in play function */
+  DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
   DMA_InitStructure.DMA_BufferSize = (uint32_t)0xFFFE;      /* This field will be configured in play function */
   DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
   DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
@@ -1252,19 +1245,23 @@ void Audio_MAL_Init(void)
 #endif /* AUDIO_MAL_MODE_NORMAL */ 
 
   DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
-  DMA_Init(AUDIO_MAL_DMA_CHANNEL, &DMA_InitStructure);  
+  DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+  DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_1QuarterFull;
+  DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+  DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+  DMA_Init(AUDIO_MAL_DMA_STREAM, &DMA_InitStructure);  
 
   /* Enable the selected DMA interrupts (selected in "stm32_eval_audio_codec.h" defines) */
 #ifdef AUDIO_MAL_DMA_IT_TC_EN
-  DMA_ITConfig(AUDIO_MAL_DMA_CHANNEL, DMA_IT_TC, ENABLE);
+  DMA_ITConfig(AUDIO_MAL_DMA_STREAM, DMA_IT_TC, ENABLE);
 #endif /* AUDIO_MAL_DMA_IT_TC_EN */
 
 #ifdef AUDIO_MAL_DMA_IT_HT_EN
-  DMA_ITConfig(AUDIO_MAL_DMA_CHANNEL, DMA_IT_HT, ENABLE);
+  DMA_ITConfig(AUDIO_MAL_DMA_STREAM, DMA_IT_HT, ENABLE);
 #endif /* AUDIO_MAL_DMA_IT_HT_EN */
 
 #ifdef AUDIO_MAL_DMA_IT_TE_EN
-  DMA_ITConfig(AUDIO_MAL_DMA_CHANNEL, DMA_IT_TE | DMA_IT_FE | DMA_IT_DME, ENABLE);
+  DMA_ITConfig(AUDIO_MAL_DMA_STREAM, DMA_IT_TE | DMA_IT_FE | DMA_IT_DME, ENABLE);
 #endif /* AUDIO_MAL_DMA_IT_TE_EN */
   
   /* Enable the I2S DMA request */
@@ -1313,10 +1310,10 @@ void Audio_MAL_DeInit(void)
 #endif 
   
   /* Disable the DMA Channel before the deinit */
-  DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);
   
   /* Dinitialize the DMA Channel */
-  DMA_DeInit(AUDIO_MAL_DMA_CHANNEL);
+  DMA_DeInit(AUDIO_MAL_DMA_STREAM);
   
   /* 
      The DMA clock is not disabled, since it can be used by other streams 
@@ -1331,21 +1328,28 @@ void Audio_MAL_DeInit(void)
   */
 void Audio_MAL_Play(uint32_t Addr, uint32_t Size)
 {   
-  /* Disable the I2S DMA Stream*/
-  DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);
-  
+  /* Disable the I2S DMA Stream, the stream registers are locked until EN reads back 0 */
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);
+  while (DMA_GetCmdStatus(AUDIO_MAL_DMA_STREAM) != DISABLE)
+  {}
+  
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+  AudioMalCircular = 0;
+  DMA_ITConfig(AUDIO_MAL_DMA_STREAM, DMA_IT_HT, DISABLE);
+#endif
+
   /* Clear the Interrupt flag */
-  DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_TC); 
+  DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC); 
   
   /* Configure the buffer address and size */
-  DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Addr;
+  DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)Addr;
   DMA_InitStructure.DMA_BufferSize = (uint32_t)(Size);
 
   /* Configure the DMA Stream with the new parameters */
-  DMA_Init(AUDIO_MAL_DMA_CHANNEL, &DMA_InitStructure);
+  DMA_Init(AUDIO_MAL_DMA_STREAM, &DMA_InitStructure);
   
   /* Enable the I2S DMA Stream*/
-  DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, ENABLE);
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, ENABLE);
 
   /* If the I2S peripheral is still not enabled, enable it */
   if ((CODEC_I2S->I2SCFGR & I2S_ENABLE_MASK) == 0)
@@ -1354,6 +1358,46 @@ void Audio_MAL_Play(uint32_t Addr, uint32_t Size)
   }
 }
 
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+/**
+  * @brief  Starts playing a circular audio buffer, the DMA wraps by itself.
+  *         HT and TC report the freed half, the caller refills it in place.
+  * @param  Addr: Pointer to the audio buffer (two halves)
+  * @param  Size: Number of data in the whole buffer
+  * @retval None.
+  */
+void Audio_MAL_PlayCircular(uint32_t Addr, uint32_t Size)
+{
+  DMA_InitTypeDef DMA_CircularStructure = DMA_InitStructure;
+
+  /* Disable the I2S DMA Stream, the stream registers are locked until EN reads back 0 */
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);
+  while (DMA_GetCmdStatus(AUDIO_MAL_DMA_STREAM) != DISABLE)
+  {}
+
+  /* Clear the Interrupt flags */
+  DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_TC | AUDIO_MAL_DMA_FLAG_HT);
+
+  /* Configure the buffer address and size, the stream reloads them on every wrap */
+  DMA_CircularStructure.DMA_Memory0BaseAddr = (uint32_t)Addr;
+  DMA_CircularStructure.DMA_BufferSize = (uint32_t)(Size);
+  DMA_CircularStructure.DMA_Mode = DMA_Mode_Circular;
+  DMA_Init(AUDIO_MAL_DMA_STREAM, &DMA_CircularStructure);
+
+  AudioMalCircular = 1;
+  DMA_ITConfig(AUDIO_MAL_DMA_STREAM, DMA_IT_HT | DMA_IT_TC, ENABLE);
+
+  /* Enable the I2S DMA Stream*/
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, ENABLE);
+
+  /* If the I2S peripheral is still not enabled, enable it */
+  if ((CODEC_I2S->I2SCFGR & I2S_ENABLE_MASK) == 0)
+  {
+    I2S_Cmd(CODEC_I2S, ENABLE);
+  }
+}
+#endif
+
 /**
   * @brief  Pauses or Resumes the audio stream playing from the Media.
   * @param Cmd: AUDIO_PAUSE (or 0) to pause, AUDIO_RESUME (or any value different
@@ -1374,22 +1418,22 @@ void Audio_MAL_PauseResume(uint32_t Cmd, uint32_t Addr, uint32_t Size)
     Codec_AudioInterface_Init(I2S_InitStructure.I2S_AudioFreq);
 
     /* Disable the DMA Stream */
-    DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);
+    DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);
         
     /* Clear the Interrupt flag */
-    DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_ALL);  
+    DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_ALL);  
   }
   else /* AUDIO_RESUME */
   {   
     /* Configure the buffer address and size */
-    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)Addr;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)Addr;
     DMA_InitStructure.DMA_BufferSize = (uint32_t)(Size*2);
     
     /* Configure the DMA Stream with the new parameters */
-    DMA_Init(AUDIO_MAL_DMA_CHANNEL, &DMA_InitStructure);
+    DMA_Init(AUDIO_MAL_DMA_STREAM, &DMA_InitStructure);
     
     /* Enable the I2S DMA Stream*/
-    DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, ENABLE);     
+    DMA_Cmd(AUDIO_MAL_DMA_STREAM, ENABLE);     
   
     /* If the I2S peripheral is still not enabled, enable it */
     if ((CODEC_I2S->I2SCFGR & I2S_ENABLE_MASK) == 0)
@@ -1407,10 +1451,13 @@ void Audio_MAL_PauseResume(uint32_t Cmd, uint32_t Addr, uint32_t Size)
 void Audio_MAL_Stop(void)
 {   
   /* Stop the Transfer on the I2S side: Stop and disable the DMA stream */
-  DMA_Cmd(AUDIO_MAL_DMA_CHANNEL, DISABLE);
+  DMA_Cmd(AUDIO_MAL_DMA_STREAM, DISABLE);
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+  AudioMalCircular = 0;
+#endif
 
   /* Clear all the DMA flags for the next transfer */
-  DMA_ClearFlag(AUDIO_MAL_DMA_FLAG_ALL);
+  DMA_ClearFlag(AUDIO_MAL_DMA_STREAM, AUDIO_MAL_DMA_FLAG_ALL);
   
   /* Stop the current DMA request by resetting the I2S cell */
   Codec_AudioInterface_DeInit();
@@ -1439,7 +1486,9 @@ void Audio_MAL_I2S_Pin_PullDown(void){
 	GPIO_ResetBits(CODEC_I2S_GPIO,CODEC_I2S_WS_PIN);	
 	GPIO_ResetBits(CODEC_I2S_GPIO,CODEC_I2S_SCK_PIN);	
 	GPIO_ResetBits(CODEC_I2S_GPIO,CODEC_I2S_SD_PIN);	
-	GPIO_ResetBits(CODEC_I2S_GPIO,CODEC_I2S_MCK_PIN);	
+#ifdef CODEC_MCLK_ENABLED
+	GPIO_ResetBits(CODEC_I2S_MCK_GPIO,CODEC_I2S_MCK_PIN);	
+#endif
 
 }
 
@@ -35,8 +35,7 @@
 #define __STM3210C_USB_AUDIOCODEC_H
 
 /* Includes ------------------------------------------------------------------*/
-#include "stm32f10x.h"
-#include "stm_32f10x_pin_conf.h"
+#include "stm32f4xx.h"
 
 //* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
@@ -96,8 +95,8 @@
 
 /* Uncomment the defines below to select if the Master clock mode should be 
   enabled or not */
-#define CODEC_MCLK_ENABLED
-//#define CODEC_MCLK_DISABLED 
+//#define CODEC_MCLK_ENABLED
+#define CODEC_MCLK_DISABLED /*PC6 (I2S2_MCK) drives EN_1V on this board, no MCK is output*/
 
 /* Uncomment this line to enable verifying data sent to codec after each write 
   operation */
@@ -110,14 +109,19 @@
 /* I2S peripheral configuration defines */
 #define CODEC_I2S                      SPI2
 #define CODEC_I2S_CLK                  RCC_APB1Periph_SPI2
-#define CODEC_I2S_ADDRESS              0x4000380C
+#define CODEC_I2S_ADDRESS              ((uint32_t)&SPI2->DR)
 #define CODEC_I2S_IRQ                  SPI2_IRQn
-#define CODEC_I2S_GPIO_CLOCK           (uint32_t)(RCC_APB2Periph_GPIOB | RCC_APB2Periph_GPIOC \
-                                        | RCC_APB2Periph_AFIO)
+#define CODEC_I2S_GPIO_AF              GPIO_AF_SPI2
+#define CODEC_I2S_GPIO_CLOCK           RCC_AHB1Periph_GPIOB
 #define CODEC_I2S_WS_PIN               GPIO_Pin_12
 #define CODEC_I2S_SCK_PIN              GPIO_Pin_13
 #define CODEC_I2S_SD_PIN               GPIO_Pin_15
+#define CODEC_I2S_WS_PINSRC            GPIO_PinSource12
+#define CODEC_I2S_SCK_PINSRC           GPIO_PinSource13
+#define CODEC_I2S_SD_PINSRC            GPIO_PinSource15
 #define CODEC_I2S_MCK_PIN              GPIO_Pin_6
+#define CODEC_I2S_MCK_PINSRC           GPIO_PinSource6
+#define CODEC_I2S_MCK_GPIO_CLOCK       RCC_AHB1Periph_GPIOC
 #define CODEC_I2S_GPIO                 GPIOB
 #define CODEC_I2S_MCK_GPIO             GPIOC
 
@@ -125,21 +129,24 @@
 #if defined ( I2C2_DMA ) && defined ( I2S_DMA )
 	#error "I2C_DMA and I2S DMA conflict "
 #elif defined (I2S_DMA)
- /* I2S DMA Stream definitions */
- #define AUDIO_MAL_DMA_CLOCK            RCC_AHBPeriph_DMA1
- #define AUDIO_MAL_DMA_CHANNEL          DMA1_Channel5
- #define AUDIO_MAL_DMA_IRQ              DMA1_Channel5_IRQn
- #define AUDIO_MAL_DMA_FLAG_TC          DMA1_FLAG_TC5
- #define AUDIO_MAL_DMA_FLAG_HT          DMA1_FLAG_HT5
- #define AUDIO_MAL_DMA_FLAG_TE          DMA1_FLAG_TE5
- #define AUDIO_MAL_DMA_FLAG_GL          DMA1_FLAG_GL5
- #define AUDIO_MAL_DMA_FLAG_ALL         DMA1_FLAG_GL5
+ /* I2S DMA Stream definitions: SPI2_TX is only mapped on DMA1 Stream4 Channel0 */
+ #define AUDIO_MAL_DMA_CLOCK            RCC_AHB1Periph_DMA1
+ #define AUDIO_MAL_DMA_STREAM           DMA1_Stream4
+ #define AUDIO_MAL_DMA_CHANNEL          DMA_Channel_0
+ #define AUDIO_MAL_DMA_IRQ              DMA1_Stream4_IRQn
+ #define AUDIO_MAL_DMA_FLAG_TC          DMA_FLAG_TCIF4
+ #define AUDIO_MAL_DMA_FLAG_HT          DMA_FLAG_HTIF4
+ #define AUDIO_MAL_DMA_FLAG_FE          DMA_FLAG_FEIF4
+ #define AUDIO_MAL_DMA_FLAG_TE          DMA_FLAG_TEIF4
+ #define AUDIO_MAL_DMA_FLAG_DME         DMA_FLAG_DMEIF4
+ #define AUDIO_MAL_DMA_FLAG_ALL         (AUDIO_MAL_DMA_FLAG_TC | AUDIO_MAL_DMA_FLAG_HT | AUDIO_MAL_DMA_FLAG_FE | \
+                                         AUDIO_MAL_DMA_FLAG_TE | AUDIO_MAL_DMA_FLAG_DME)
  #define AUDIO_MAL_DMA_PERIPH_DATA_SIZE DMA_PeripheralDataSize_HalfWord
  #define AUDIO_MAL_DMA_MEM_DATA_SIZE    DMA_MemoryDataSize_HalfWord
  #define DMA_MAX_SZE                    0xFFFF
  #define AUDIO_MAL_DMA                  DMA1
 
- #define Audio_MAL_IRQHandler           DMA1_Channel5_IRQHandler
+ #define Audio_MAL_IRQHandler           DMA1_Stream4_IRQHandler
 #endif
 
 /* I2C peripheral configuration defines (control interface of the audio codec) */
@@ -147,7 +154,7 @@
 #if defined(DAC_CS43L22)
 #define CODEC_I2C                      I2C1
 #define CODEC_I2C_CLK                  RCC_APB1Periph_I2C1
-#define CODEC_I2C_GPIO_CLOCK           (uint32_t)(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO)
+#define CODEC_I2C_GPIO_CLOCK           RCC_AHB1Periph_GPIOB
 #define CODEC_I2C_GPIO_AF              GPIO_AF_I2C1
 #define CODEC_I2C_GPIO                 GPIOB
 #define CODEC_I2C_SCL_PIN              GPIO_Pin_6
@@ -225,6 +232,9 @@ uint32_t Codec_SwitchOutput(uint8_t Output);
 void Audio_MAL_Init(void);
 void Audio_MAL_DeInit(void);
 void Audio_MAL_Play(uint32_t Addr, uint32_t Size);
+#if ( configUSB_WAV_CIRCULAR_DMA == 1 )
+void Audio_MAL_PlayCircular(uint32_t Addr, uint32_t Size);
+#endif
 void Audio_MAL_PauseResume(uint32_t Cmd, uint32_t Addr, uint32_t Size);
 void Audio_MAL_Stop(void);
 